@@ -128,6 +128,7 @@ list(APPEND WebCore_SOURCES
     platform/graphics/cairo/ImageCairo.cpp
     platform/graphics/cairo/IntRectCairo.cpp
     platform/graphics/cairo/OwnPtrCairo.cpp
+    platform/graphics/cairo/PaintRecordingCairo.cpp
     platform/graphics/cairo/PathCairo.cpp
     platform/graphics/cairo/PatternCairo.cpp
     platform/graphics/cairo/PlatformContextCairo.cpp
@@ -250,6 +250,7 @@ SOURCES += \
     Modules/notifications/WorkerGlobalScopeNotifications.cpp \
     Modules/proximity/DeviceProximityController.cpp \
     Modules/proximity/DeviceProximityEvent.cpp \
+    css/AncestorIdentifierFilter.cpp \
     css/BasicShapeFunctions.cpp \
     css/CSSAspectRatioValue.cpp \
     css/CSSBasicShapes.cpp \
@@ -401,6 +402,7 @@ SOURCES += \
     dom/DOMStringMap.cpp \
     dom/DatasetDOMStringMap.cpp \
     dom/Element.cpp \
+    dom/ElementIndex.cpp \
     dom/ElementRareData.cpp \
     dom/ElementShadow.cpp \
     dom/EntityReference.cpp \
@@ -442,6 +444,7 @@ SOURCES += \
     dom/NamedNodeMap.cpp \
     dom/NameNodeList.cpp \
     dom/Node.cpp \
+    dom/NodeArena.cpp \
     dom/NodeFilterCondition.cpp \
     dom/NodeFilter.cpp \
     dom/NodeIterator.cpp \
@@ -991,6 +994,7 @@ SOURCES += \
     platform/graphics/BitmapImage.cpp \
     platform/graphics/Color.cpp \
     platform/graphics/CrossfadeGeneratedImage.cpp \
+    platform/graphics/DisplayList.cpp \
     platform/graphics/FloatPoint3D.cpp \
     platform/graphics/FloatPoint.cpp \
     platform/graphics/FloatPolygon.cpp \
@@ -1045,6 +1049,7 @@ SOURCES += \
     platform/graphics/transforms/TransformOperations.cpp \
     platform/graphics/transforms/TransformState.cpp \
     platform/graphics/transforms/TranslateTransformOperation.cpp \
+    platform/graphics/WidthCache.cpp \
     platform/graphics/WidthIterator.cpp \
     platform/image-decoders/ImageDecoder.cpp \
     platform/image-decoders/bmp/BMPImageDecoder.cpp \
@@ -1237,6 +1242,7 @@ SOURCES += \
     rendering/RenderWordBreak.cpp \
     rendering/RootInlineBox.cpp \
     rendering/ScrollBehavior.cpp \
+    rendering/SimpleLineLayout.cpp \
     rendering/shapes/PolygonShape.cpp \
     rendering/shapes/RectangleShape.cpp \
     rendering/shapes/Shape.cpp \
@@ -1474,6 +1480,7 @@ HEADERS += \
     Modules/webdatabase/SQLTransactionSyncCallback.h \
     Modules/webdatabase/WorkerGlobalScopeWebDatabase.h \
     \
+    css/AncestorIdentifierFilter.h \
     css/BasicShapeFunctions.h \
     css/CSSAspectRatioValue.h \
     css/CSSBasicShapes.h \
@@ -1612,6 +1619,7 @@ HEADERS += \
     dom/DOMTimeStamp.h \
     dom/DatasetDOMStringMap.h \
     dom/Element.h \
+    dom/ElementIndex.h \
     dom/ElementShadow.h \
     dom/Entity.h \
     dom/EntityReference.h \
@@ -1650,6 +1658,7 @@ HEADERS += \
     dom/NodeFilterCondition.h \
     dom/NodeFilter.h \
     dom/Node.h \
+    dom/NodeArena.h \
     dom/NodeIterator.h \
     dom/NodeRareData.h \
     dom/NodeRenderingContext.h \
@@ -2149,7 +2158,12 @@ HEADERS += \
     platform/graphics/cpu/arm/filters/FECompositeArithmeticNEON.h \
     platform/graphics/cpu/arm/filters/FEGaussianBlurNEON.h \
     platform/graphics/cpu/arm/filters/FELightingNEON.h \
+    platform/graphics/cpu/x86/filters/FEColorMatrixSSE2.h \
+    platform/graphics/cpu/x86/filters/FECompositeArithmeticSSE2.h \
+    platform/graphics/cpu/x86/filters/FEGaussianBlurSSE2.h \
+    platform/graphics/cpu/x86/filters/SSE2Helpers.h \
     platform/graphics/CrossfadeGeneratedImage.h \
+    platform/graphics/DisplayList.h \
     platform/graphics/filters/texmap/TextureMapperPlatformCompiledProgram.h \
     platform/graphics/filters/CustomFilterArrayParameter.h \
     platform/graphics/filters/CustomFilterColorParameter.h \
@@ -2225,6 +2239,7 @@ HEADERS += \
     platform/graphics/MediaPlayer.h \
     platform/graphics/NativeImagePtr.h \
     platform/graphics/opentype/OpenTypeVerticalData.h \
+    platform/graphics/PaintRecording.h \
     platform/graphics/Path.h \
     platform/graphics/PathTraversalState.h \
     platform/graphics/Pattern.h \
@@ -2255,6 +2270,7 @@ HEADERS += \
     platform/graphics/texmap/TextureMapperImageBuffer.h \
     platform/graphics/texmap/TextureMapperLayer.h \
     platform/graphics/texmap/TextureMapperPlatformLayer.h \
+    platform/graphics/texmap/TextureMapperSoftwareCompositor.h \
     platform/graphics/texmap/TextureMapperSurfaceBackingStore.h \
     platform/graphics/texmap/TextureMapperTile.h \
     platform/graphics/texmap/TextureMapperTiledBackingStore.h \
@@ -2506,6 +2522,7 @@ HEADERS += \
     rendering/RenderWordBreak.h \
     rendering/RootInlineBox.h \
     rendering/ScrollBehavior.h \
+    rendering/SimpleLineLayout.h \
     rendering/shapes/PolygonShape.h \
     rendering/shapes/RectangleShape.h \
     rendering/shapes/Shape.h \
@@ -2889,6 +2906,7 @@ SOURCES += \
     platform/graphics/qt/IntPointQt.cpp \
     platform/graphics/qt/IntRectQt.cpp \
     platform/graphics/qt/IntSizeQt.cpp \
+    platform/graphics/qt/PaintRecordingQt.cpp \
     platform/graphics/qt/PathQt.cpp \
     platform/graphics/qt/PatternQt.cpp \
     platform/graphics/qt/StillImageQt.cpp
@@ -2905,6 +2923,7 @@ SOURCES += \
     platform/graphics/texmap/TextureMapperFPSCounter.cpp \
     platform/graphics/texmap/TextureMapperImageBuffer.cpp \
     platform/graphics/texmap/TextureMapperLayer.cpp \
+    platform/graphics/texmap/TextureMapperSoftwareCompositor.cpp \
     platform/graphics/texmap/TextureMapperSurfaceBackingStore.cpp \
     platform/graphics/texmap/TextureMapperTile.cpp \
     platform/graphics/texmap/TextureMapperTiledBackingStore.cpp \
@@ -4183,8 +4202,10 @@ use?(3D_GRAPHICS) {
         platform/graphics/texmap/coordinated/CoordinatedGraphicsState.h \
         platform/graphics/texmap/coordinated/CoordinatedImageBacking.h \
         platform/graphics/texmap/coordinated/CoordinatedSurface.h \
+        platform/graphics/texmap/coordinated/CoordinatedSurfacePool.h \
         platform/graphics/texmap/coordinated/CoordinatedTile.h \
         platform/graphics/texmap/coordinated/SurfaceUpdateInfo.h \
+        platform/graphics/texmap/coordinated/TileRasterizer.h \
         platform/graphics/texmap/coordinated/UpdateAtlas.h
 
     SOURCES += \
@@ -4216,7 +4237,9 @@ use?(3D_GRAPHICS) {
         platform/graphics/texmap/coordinated/CoordinatedGraphicsScene.cpp \
         platform/graphics/texmap/coordinated/CoordinatedImageBacking.cpp \
         platform/graphics/texmap/coordinated/CoordinatedSurface.cpp \
+        platform/graphics/texmap/coordinated/CoordinatedSurfacePool.cpp \
         platform/graphics/texmap/coordinated/CoordinatedTile.cpp \
+        platform/graphics/texmap/coordinated/TileRasterizer.cpp \
         platform/graphics/texmap/coordinated/UpdateAtlas.cpp
 
     INCLUDEPATH += $$PWD/platform/graphics/gpu
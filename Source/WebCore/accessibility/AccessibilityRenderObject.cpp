@@ -1171,7 +1171,7 @@ bool AccessibilityRenderObject::computeAccessibilityIsIgnored() const
         if (parent && (parent->ariaRoleAttribute() == MenuItemRole || parent->ariaRoleAttribute() == MenuButtonRole))
             return true;
         RenderText* renderText = toRenderText(m_renderer);
-        if (m_renderer->isBR() || !renderText->firstTextBox())
+        if (m_renderer->isBR() || (!renderText->firstTextBox() && !renderText->usesSimpleLineLayout()))
             return true;
 
         // static text beneath TextControls is reported along with the text control text so it's ignored.
@@ -82,6 +82,7 @@ protected:
         : m_previousState(s_mainThreadState)
     {
         ASSERT(isMainThread());
+        ChildrenChangedBatch::willRunScript();
         s_mainThreadState = exec;
     };
 
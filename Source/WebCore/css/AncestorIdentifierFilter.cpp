@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "AncestorIdentifierFilter.h"
+
+#include "Element.h"
+#include "SelectorFilter.h"
+
+namespace WebCore {
+
+AncestorIdentifierFilter::AncestorIdentifierFilter()
+{
+    memset(m_bits, 0, sizeof(m_bits));
+}
+
+void AncestorIdentifierFilter::build(const Element* element)
+{
+    memset(m_bits, 0, sizeof(m_bits));
+    Vector<unsigned, 4> identifierHashes;
+    // Like SelectorFilter, include shadow hosts. Selectors that stay within a tree scope only look
+    // at a subset of these ancestors, and a superset never causes a wrong rejection.
+    for (const Element* ancestor = element; ancestor; ancestor = ancestor->parentOrShadowHostElement()) {
+        SelectorFilter::collectElementIdentifierHashes(ancestor, identifierHashes);
+        for (size_t i = 0; i < identifierHashes.size(); ++i)
+            add(identifierHashes[i]);
+        identifierHashes.shrink(0);
+    }
+}
+
+AncestorIdentifierFilterCache::AncestorIdentifierFilterCache()
+    : m_domTreeVersion(0)
+    , m_lastMissedElement(0)
+    , m_useCounter(0)
+{
+    clear();
+}
+
+void AncestorIdentifierFilterCache::clear()
+{
+    m_lastMissedElement = 0;
+    for (unsigned i = 0; i < capacity; ++i) {
+        m_elements[i] = 0;
+        m_lastUse[i] = 0;
+    }
+}
+
+const AncestorIdentifierFilter* AncestorIdentifierFilterCache::filterFor(const Element* element, uint64_t domTreeVersion)
+{
+    if (!element->inDocument())
+        return 0;
+
+    if (m_domTreeVersion != domTreeVersion) {
+        clear();
+        m_domTreeVersion = domTreeVersion;
+    }
+
+    unsigned leastRecentlyUsed = 0;
+    for (unsigned i = 0; i < capacity; ++i) {
+        if (m_elements[i] == element) {
+            m_lastUse[i] = ++m_useCounter;
+            return &m_filters[i];
+        }
+        if (m_lastUse[i] < m_lastUse[leastRecentlyUsed])
+            leastRecentlyUsed = i;
+    }
+
+    if (m_lastMissedElement != element) {
+        m_lastMissedElement = element;
+        return 0;
+    }
+
+    m_elements[leastRecentlyUsed] = element;
+    m_lastUse[leastRecentlyUsed] = ++m_useCounter;
+    m_filters[leastRecentlyUsed].build(element);
+    return &m_filters[leastRecentlyUsed];
+}
+
+} // namespace WebCore
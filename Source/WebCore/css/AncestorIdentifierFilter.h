@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef AncestorIdentifierFilter_h
+#define AncestorIdentifierFilter_h
+
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+
+class Element;
+
+// Bloom filter of the tag names, ids and class names of an element and all its ancestors, using
+// the same identifier hashes as SelectorFilter. SelectorFilter keeps its filter up to date while
+// style recalc walks down the tree; this one is built on demand for a single element, so descendant
+// and child selectors can be fast-rejected outside of style recalc too (matches()).
+class AncestorIdentifierFilter {
+    WTF_MAKE_NONCOPYABLE(AncestorIdentifierFilter);
+public:
+    AncestorIdentifierFilter();
+
+    void build(const Element*);
+
+    bool mayContain(unsigned hash) const { return isBitSet(hash & keyMask) && isBitSet((hash >> 16) & keyMask); }
+
+    template <unsigned maximumIdentifierCount>
+    bool fastRejectSelector(const unsigned* identifierHashes) const
+    {
+        for (unsigned n = 0; n < maximumIdentifierCount && identifierHashes[n]; ++n) {
+            if (!mayContain(identifierHashes[n]))
+                return true;
+        }
+        return false;
+    }
+
+private:
+    void add(unsigned hash)
+    {
+        setBit(hash & keyMask);
+        setBit((hash >> 16) & keyMask);
+    }
+
+    // Unlike SelectorFilter, nothing is ever removed, so one bit per slot is enough. 2^11 bits
+    // keep the false positive rate low for the few dozen identifiers of a typical ancestor chain.
+    static const unsigned keyBits = 11;
+    static const unsigned keyMask = (1 << keyBits) - 1;
+    static const unsigned wordCount = (1 << keyBits) / 32;
+
+    bool isBitSet(unsigned bit) const { return m_bits[bit >> 5] & (1u << (bit & 31)); }
+    void setBit(unsigned bit) { m_bits[bit >> 5] |= 1u << (bit & 31); }
+
+    uint32_t m_bits[wordCount];
+};
+
+// The filters of the few elements most recently asked for in a document, owned by the Document.
+// Adding or removing nodes and changing attributes all bump the document's DOM tree version, which
+// drops every entry. Only elements in the document are cached: they can't be destroyed without a
+// removal, so a cached element pointer stays valid for as long as the version is unchanged.
+class AncestorIdentifierFilterCache {
+    WTF_MAKE_NONCOPYABLE(AncestorIdentifierFilterCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    AncestorIdentifierFilterCache();
+
+    // Returns 0 rather than building a filter the first time an element misses at a DOM tree
+    // version, since a single lookup costs as much as the ancestor walk the filter would save.
+    const AncestorIdentifierFilter* filterFor(const Element*, uint64_t domTreeVersion);
+
+private:
+    void clear();
+
+    static const unsigned capacity = 4;
+
+    uint64_t m_domTreeVersion;
+    const Element* m_lastMissedElement;
+    unsigned m_useCounter;
+    const Element* m_elements[capacity];
+    unsigned m_lastUse[capacity];
+    AncestorIdentifierFilter m_filters[capacity];
+};
+
+} // namespace WebCore
+
+#endif // AncestorIdentifierFilter_h
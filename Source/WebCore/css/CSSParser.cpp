@@ -1010,6 +1010,10 @@ static inline bool isValidKeywordPropertyAndValue(CSSPropertyID propertyId, int
         if (valueID == CSSValueFlat || valueID == CSSValuePreserve3d)
             return true;
         break;
+    case CSSPropertyWebkitContentVisibility: // visible | auto
+        if (valueID == CSSValueVisible || valueID == CSSValueAuto)
+            return true;
+        break;
     case CSSPropertyWebkitUserDrag: // auto | none | element
         if (valueID == CSSValueAuto || valueID == CSSValueNone || valueID == CSSValueElement)
             return true;
@@ -1119,6 +1123,7 @@ static inline bool isKeywordPropertyID(CSSPropertyID propertyId)
     case CSSPropertyWebkitColumnBreakBefore:
     case CSSPropertyWebkitColumnBreakInside:
     case CSSPropertyWebkitColumnRuleStyle:
+    case CSSPropertyWebkitContentVisibility:
     case CSSPropertyWebkitAlignContent:
     case CSSPropertyWebkitAlignItems:
     case CSSPropertyWebkitAlignSelf:
@@ -3047,6 +3052,7 @@ bool CSSParser::parseValue(CSSPropertyID propId, bool important)
     case CSSPropertyWebkitColumnBreakBefore:
     case CSSPropertyWebkitColumnBreakInside:
     case CSSPropertyWebkitColumnRuleStyle:
+    case CSSPropertyWebkitContentVisibility:
     case CSSPropertyWebkitAlignContent:
     case CSSPropertyWebkitAlignItems:
     case CSSPropertyWebkitAlignSelf:
@@ -4320,6 +4320,35 @@ template<> inline CSSPrimitiveValue::operator ColumnProgression() const
     return NormalColumnProgression;
 }
 
+template<> inline CSSPrimitiveValue::CSSPrimitiveValue(ContentVisibility e)
+    : CSSValue(PrimitiveClass)
+{
+    m_primitiveUnitType = CSS_VALUE_ID;
+    switch (e) {
+    case ContentVisibilityVisible:
+        m_value.valueID = CSSValueVisible;
+        break;
+    case ContentVisibilityAuto:
+        m_value.valueID = CSSValueAuto;
+        break;
+    }
+}
+
+template<> inline CSSPrimitiveValue::operator ContentVisibility() const
+{
+    switch (m_value.valueID) {
+    case CSSValueVisible:
+        return ContentVisibilityVisible;
+    case CSSValueAuto:
+        return ContentVisibilityAuto;
+    default:
+        break;
+    }
+
+    ASSERT_NOT_REACHED();
+    return ContentVisibilityVisible;
+}
+
 template<> inline CSSPrimitiveValue::CSSPrimitiveValue(WrapFlow wrapFlow)
 : CSSValue(PrimitiveClass)
 {
@@ -567,6 +567,7 @@ bool CSSProperty::isInheritedProperty(CSSPropertyID propertyID)
     case CSSPropertyWebkitColumnSpan:
     case CSSPropertyWebkitColumnWidth:
     case CSSPropertyWebkitColumns:
+    case CSSPropertyWebkitContentVisibility:
 #if ENABLE(CSS_FILTERS)
     case CSSPropertyWebkitFilter:
 #endif
@@ -134,6 +134,14 @@ static inline int countElementsOfTypeAfter(const Element* element, const Qualifi
     return count;
 }
 
+static inline RenderStyle* modifiableRenderStyle(Element* element)
+{
+    // Interned styles are shared with unrelated elements, so state matched here goes to the renderer's own copy.
+    if (RenderObject* renderer = element->renderer())
+        return renderer->uninternedStyle();
+    return element->renderStyle();
+}
+
 SelectorChecker::SelectorChecker(Document* document, Mode mode)
     : m_strictParsing(!document->inQuirksMode())
     , m_documentIsHTML(document->isHTMLDocument())
@@ -454,7 +462,7 @@ bool SelectorChecker::checkOne(const SelectorCheckingContext& context) const
                     if (context.elementStyle)
                         context.elementStyle->setEmptyState(result);
                     else if (element->renderStyle() && (element->document()->styleSheetCollection()->usesSiblingRules() || element->renderStyle()->unique()))
-                        element->renderStyle()->setEmptyState(result);
+                        modifiableRenderStyle(element)->setEmptyState(result);
                 }
                 return result;
             }
@@ -463,7 +471,7 @@ bool SelectorChecker::checkOne(const SelectorCheckingContext& context) const
             if (Element* parentElement = element->parentElement()) {
                 bool result = isFirstChildElement(element);
                 if (m_mode == ResolvingStyle) {
-                    RenderStyle* childStyle = context.elementStyle ? context.elementStyle : element->renderStyle();
+                    RenderStyle* childStyle = context.elementStyle ? context.elementStyle : modifiableRenderStyle(element);
                     parentElement->setChildrenAffectedByFirstChildRules();
                     if (result && childStyle)
                         childStyle->setFirstChildState();
@@ -485,7 +493,7 @@ bool SelectorChecker::checkOne(const SelectorCheckingContext& context) const
             if (Element* parentElement = element->parentElement()) {
                 bool result = parentElement->isFinishedParsingChildren() && isLastChildElement(element);
                 if (m_mode == ResolvingStyle) {
-                    RenderStyle* childStyle = context.elementStyle ? context.elementStyle : element->renderStyle();
+                    RenderStyle* childStyle = context.elementStyle ? context.elementStyle : modifiableRenderStyle(element);
                     parentElement->setChildrenAffectedByLastChildRules();
                     if (result && childStyle)
                         childStyle->setLastChildState();
@@ -508,7 +516,7 @@ bool SelectorChecker::checkOne(const SelectorCheckingContext& context) const
                 bool firstChild = isFirstChildElement(element);
                 bool onlyChild = firstChild && parentElement->isFinishedParsingChildren() && isLastChildElement(element);
                 if (m_mode == ResolvingStyle) {
-                    RenderStyle* childStyle = context.elementStyle ? context.elementStyle : element->renderStyle();
+                    RenderStyle* childStyle = context.elementStyle ? context.elementStyle : modifiableRenderStyle(element);
                     parentElement->setChildrenAffectedByFirstChildRules();
                     parentElement->setChildrenAffectedByLastChildRules();
                     if (firstChild && childStyle)
@@ -537,7 +545,7 @@ bool SelectorChecker::checkOne(const SelectorCheckingContext& context) const
             if (Element* parentElement = element->parentElement()) {
                 int count = 1 + countElementsBefore(element);
                 if (m_mode == ResolvingStyle) {
-                    RenderStyle* childStyle = context.elementStyle ? context.elementStyle : element->renderStyle();
+                    RenderStyle* childStyle = context.elementStyle ? context.elementStyle : modifiableRenderStyle(element);
                     element->setChildIndex(count);
                     if (childStyle)
                         childStyle->setUnique();
@@ -37,7 +37,7 @@ namespace WebCore {
 // Salt to separate otherwise identical string hashes so a class-selector like .article won't match <article> elements.
 enum { TagNameSalt = 13, IdAttributeSalt = 17, ClassAttributeSalt = 19 };
 
-static inline void collectElementIdentifierHashes(const Element* element, Vector<unsigned, 4>& identifierHashes)
+void SelectorFilter::collectElementIdentifierHashes(const Element* element, Vector<unsigned, 4>& identifierHashes)
 {
     identifierHashes.append(element->localName().impl()->existingHash() * TagNameSalt);
     if (element->hasID())
@@ -51,6 +51,8 @@ public:
     template <unsigned maximumIdentifierCount>
     inline bool fastRejectSelector(const unsigned* identifierHashes) const;
     static void collectIdentifierHashes(const CSSSelector*, unsigned* identifierHashes, unsigned maximumIdentifierCount);
+    // The hashes an element contributes as an ancestor: its tag name, id and class names.
+    static void collectElementIdentifierHashes(const Element*, Vector<unsigned, 4>& identifierHashes);
 
 private:
     struct ParentStackFrame {
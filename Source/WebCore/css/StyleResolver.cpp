@@ -383,9 +383,29 @@ void StyleResolver::sweepMatchedPropertiesCache(Timer<StyleResolver>*)
     for (size_t i = 0; i < toRemove.size(); ++i)
         m_matchedPropertiesCache.remove(toRemove[i]);
 
+    // Interned styles that are no longer used by any element are only kept alive by this cache.
+    toRemove.clear();
+    InternedStyleMap::iterator internedEnd = m_internedStyles.end();
+    for (InternedStyleMap::iterator it = m_internedStyles.begin(); it != internedEnd; ++it) {
+        if (it->value->style->hasOneRef())
+            toRemove.append(it->key);
+    }
+    for (size_t i = 0; i < toRemove.size(); ++i)
+        m_internedStyles.remove(toRemove[i]);
+
     m_matchedPropertiesCacheAdditionsSinceLastSweep = 0;
 }
 
+void StyleResolver::didAddToCache()
+{
+    static const unsigned matchedDeclarationCacheAdditionsBetweenSweeps = 100;
+    if (++m_matchedPropertiesCacheAdditionsSinceLastSweep >= matchedDeclarationCacheAdditionsBetweenSweeps
+        && !m_matchedPropertiesCacheSweepTimer.isActive()) {
+        static const unsigned matchedDeclarationCacheSweepTimeInSeconds = 60;
+        m_matchedPropertiesCacheSweepTimer.startOneShot(matchedDeclarationCacheSweepTimeInSeconds);
+    }
+}
+
 inline bool StyleResolver::styleSharingCandidateMatchesHostRules()
 {
 #if ENABLE(SHADOW_DOM)
@@ -422,6 +442,22 @@ inline void StyleResolver::initElement(Element* e)
     }
 }
 
+RenderStyle* StyleResolver::State::modifiableParentStyle()
+{
+    if (!m_parentStyle->isInterned())
+        return m_parentStyle.get();
+
+    // The parent's style may be shared with unrelated elements through interning. Record the
+    // change in the parent renderer's own copy, or in a private one when the parent style was
+    // passed in explicitly, as for computed style.
+    RenderObject* parentRenderer = m_parentNode ? m_parentNode->renderer() : 0;
+    if (parentRenderer && parentRenderer->style() == m_parentStyle)
+        m_parentStyle = parentRenderer->uninternedStyle();
+    else
+        m_parentStyle = RenderStyle::clone(m_parentStyle.get());
+    return m_parentStyle.get();
+}
+
 inline void StyleResolver::State::initForStyleResolve(Document* document, Element* e, RenderStyle* parentStyle, RenderRegion* regionForStyling)
 {
     m_regionForStyling = regionForStyling;
@@ -998,6 +1034,8 @@ PassRefPtr<RenderStyle> StyleResolver::styleForElement(Element* element, RenderS
     document()->didAccessStyleResolver();
 
     // Now return the style.
+    if (sharingBehavior == AllowStyleSharing)
+        return internStyle(element, state.takeStyle());
     return state.takeStyle();
 }
 
@@ -1797,12 +1835,7 @@ const StyleResolver::MatchedPropertiesCacheItem* StyleResolver::findFromMatchedP
 
 void StyleResolver::addToMatchedPropertiesCache(const RenderStyle* style, const RenderStyle* parentStyle, unsigned hash, const MatchResult& matchResult)
 {
-    static const unsigned matchedDeclarationCacheAdditionsBetweenSweeps = 100;
-    if (++m_matchedPropertiesCacheAdditionsSinceLastSweep >= matchedDeclarationCacheAdditionsBetweenSweeps
-        && !m_matchedPropertiesCacheSweepTimer.isActive()) {
-        static const unsigned matchedDeclarationCacheSweepTimeInSeconds = 60;
-        m_matchedPropertiesCacheSweepTimer.startOneShot(matchedDeclarationCacheSweepTimeInSeconds);
-    }
+    didAddToCache();
 
     ASSERT(hash);
     MatchedPropertiesCacheItem cacheItem;
@@ -1818,6 +1851,66 @@ void StyleResolver::addToMatchedPropertiesCache(const RenderStyle* style, const
 void StyleResolver::invalidateMatchedPropertiesCache()
 {
     m_matchedPropertiesCache.clear();
+    m_internedStyles.clear();
+}
+
+static bool canInternStyle(Element* element, const RenderStyle* style)
+{
+    // Like style sharing, interning hands the same RenderStyle to several elements, so refuse
+    // styles that may be modified after resolution or that depend on the element's identity.
+    if (style->unique() || style->styleType() != NOPSEUDO)
+        return false;
+    // Cached pseudo styles are resolved per element and may differ between elements with equal styles.
+    if (style->hasAnyPublicPseudoStyles() || style->hasUniquePseudoStyle())
+        return false;
+    if (style->transitions() || style->animations())
+        return false;
+    // Inline styles usually change together with the element's style; interning them only churns the cache.
+    if (element->isStyledElement() && static_cast<StyledElement*>(element)->inlineStyle())
+        return false;
+    if (isHTMLOptionElement(element) || isHTMLOptGroupElement(element) || element->isFormControlElement())
+        return false;
+    // Renderers of shadow tree elements (slider thumbs, inner text fields, media controls) adjust
+    // their style() in place during layout, which would leak into every element sharing it.
+    if (element->isInShadowTree())
+        return false;
+#if USE(ACCELERATED_COMPOSITING)
+    // Elements that can gain layers for reasons outside of the style system never share styles.
+    if (element->hasTagName(iframeTag) || element->hasTagName(frameTag) || element->hasTagName(embedTag) || element->hasTagName(objectTag) || element->hasTagName(appletTag) || element->hasTagName(canvasTag))
+        return false;
+#endif
+    if (element == element->document()->cssTarget() || elementHasDirectionAuto(element))
+        return false;
+#if ENABLE(FULLSCREEN_API)
+    if (element == element->document()->webkitCurrentFullScreenElement())
+        return false;
+#endif
+    return true;
+}
+
+PassRefPtr<RenderStyle> StyleResolver::internStyle(Element* element, PassRefPtr<RenderStyle> prpStyle)
+{
+    RefPtr<RenderStyle> style = prpStyle;
+    if (!canInternStyle(element, style.get()))
+        return style.release();
+
+    unsigned hashInputs[] = { style->hashForDataSharing(), QualifiedNameHash::hash(element->tagQName()) };
+    unsigned hash = StringHasher::hashMemory<sizeof(hashInputs)>(hashInputs);
+
+    InternedStyleMap::AddResult result = m_internedStyles.add(hash, nullptr);
+    if (result.isNewEntry) {
+        style->setIsInterned();
+        result.iterator->value = adoptPtr(new InternedStyle(element->tagQName(), style));
+        didAddToCache();
+        return style.release();
+    }
+
+    // On a hash collision the existing entry is kept and the new style is simply not interned.
+    InternedStyle* interned = result.iterator->value.get();
+    if (interned->tagName != element->tagQName() || !interned->style->allDataShared(style.get()))
+        return style.release();
+
+    return interned->style;
 }
 
 static bool isCacheableInMatchedPropertiesCache(const Element* element, const RenderStyle* style, const RenderStyle* parentStyle)
@@ -2198,7 +2291,7 @@ void StyleResolver::applyProperty(CSSPropertyID id, CSSValue* value)
     }
 
     if (isInherit && !state.parentStyle()->hasExplicitlyInheritedProperties() && !CSSProperty::isInheritedProperty(id))
-        state.parentStyle()->setHasExplicitlyInheritedProperties();
+        state.modifiableParentStyle()->setHasExplicitlyInheritedProperties();
 
 #if ENABLE(CSS_VARIABLES)
     if (id == CSSPropertyVariable) {
@@ -2280,7 +2373,7 @@ void StyleResolver::applyProperty(CSSPropertyID id, CSSValue* value)
                     if (state.style()->styleType() == NOPSEUDO)
                         state.style()->setUnique();
                     else
-                        state.parentStyle()->setUnique();
+                        state.modifiableParentStyle()->setUnique();
                     QualifiedName attr(nullAtom, contentValue->getStringValue().impl(), nullAtom);
                     const AtomicString& value = state.element()->getAttribute(attr);
                     state.style()->setContent(value.isNull() ? emptyAtom : value.impl(), didSet);
@@ -3009,6 +3102,7 @@ void StyleResolver::applyProperty(CSSPropertyID id, CSSValue* value)
     case CSSPropertyWebkitColumnRuleWidth:
     case CSSPropertyWebkitColumnSpan:
     case CSSPropertyWebkitColumnWidth:
+    case CSSPropertyWebkitContentVisibility:
 #if ENABLE(CURSOR_VISIBILITY)
     case CSSPropertyWebkitCursorVisibility:
 #endif
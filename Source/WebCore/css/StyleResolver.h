@@ -28,6 +28,7 @@
 #include "InspectorCSSOMWrappers.h"
 #include "LinkHash.h"
 #include "MediaQueryExp.h"
+#include "QualifiedName.h"
 #include "RenderStyle.h"
 #include "RuleFeature.h"
 #include "RuleSet.h"
@@ -458,6 +459,7 @@ public:
         const ContainerNode* parentNode() const { return m_parentNode; }
         void setParentStyle(PassRefPtr<RenderStyle> parentStyle) { m_parentStyle = parentStyle; }
         RenderStyle* parentStyle() const { return m_parentStyle.get(); }
+        RenderStyle* modifiableParentStyle();
         RenderStyle* rootElementStyle() const { return m_rootElementStyle; }
 
         const RenderRegion* regionForStyling() const { return m_regionForStyling; }
@@ -598,6 +600,20 @@ private:
     // Every N additions to the matched declaration cache trigger a sweep where entries holding
     // the last reference to a style declaration are garbage collected.
     void sweepMatchedPropertiesCache(Timer<StyleResolver>*);
+    void didAddToCache();
+
+    // Styles resolved for elements with the same tag that share all of their data groups are
+    // interned so that each element doesn't keep its own identical RenderStyle alive.
+    PassRefPtr<RenderStyle> internStyle(Element*, PassRefPtr<RenderStyle>);
+    struct InternedStyle {
+        InternedStyle(const QualifiedName& tagName, PassRefPtr<RenderStyle> style)
+            : tagName(tagName)
+            , style(style)
+        { }
+
+        QualifiedName tagName;
+        RefPtr<RenderStyle> style;
+    };
 
     bool classNamesAffectedByRules(const SpaceSplitString&) const;
     bool sharingCandidateHasIdenticalStyleAffectingAttributes(StyledElement*) const;
@@ -607,6 +623,9 @@ private:
     typedef HashMap<unsigned, MatchedPropertiesCacheItem> MatchedPropertiesCache;
     MatchedPropertiesCache m_matchedPropertiesCache;
 
+    typedef HashMap<unsigned, OwnPtr<InternedStyle>, AlreadyHashed> InternedStyleMap;
+    InternedStyleMap m_internedStyles;
+
     Timer<StyleResolver> m_matchedPropertiesCacheSweepTimer;
 
     OwnPtr<MediaQueryEvaluator> m_medium;
@@ -33,6 +33,7 @@
 #include "Document.h"
 #include "NodeRareData.h"
 #include "StyledElement.h"
+#include "TreeScope.h"
 
 namespace WebCore {
 
@@ -40,6 +41,7 @@ ClassNodeList::ClassNodeList(PassRefPtr<Node> rootNode, const String& classNames
     : LiveNodeList(rootNode, ClassNodeListType, InvalidateOnClassAttrChange)
     , m_classNames(classNames, document()->inQuirksMode())
     , m_originalClassNames(classNames)
+    , m_classIndexPosition(0)
 {
 }
 
@@ -53,4 +55,49 @@ bool ClassNodeList::nodeMatches(Element* testNode) const
     return nodeMatchesInlined(testNode);
 }
 
+Element* ClassNodeList::nextElementFromClassIndex(const Vector<Element*>& candidates, size_t startPosition) const
+{
+    for (size_t position = startPosition; position < candidates.size(); ++position) {
+        Element* element = candidates[position];
+        if (nodeMatchesInlined(element)) {
+            m_classIndexPosition = position;
+            return element;
+        }
+    }
+    return 0;
+}
+
+Element* ClassNodeList::firstElementFromClassIndex(ContainerNode* root) const
+{
+    ASSERT(canUseClassIndex(root));
+    const Vector<Element*>* candidates = root->treeScope()->getAllElementsByClassName(m_classNames[0]);
+    if (!candidates)
+        return 0;
+    return nextElementFromClassIndex(*candidates, 0);
+}
+
+Element* ClassNodeList::traverseClassIndexForwardToOffset(unsigned offset, Element* currentElement, unsigned& currentOffset, ContainerNode* root) const
+{
+    ASSERT(canUseClassIndex(root));
+    ASSERT(currentOffset < offset);
+    const Vector<Element*>* candidates = root->treeScope()->getAllElementsByClassName(m_classNames[0]);
+    if (!candidates)
+        return 0;
+
+    // The list's item cache normally holds the element we returned last.
+    size_t position = m_classIndexPosition;
+    if (position >= candidates->size() || candidates->at(position) != currentElement) {
+        position = ElementIndex::find(*candidates, currentElement);
+        if (position == notFound)
+            return 0;
+    }
+
+    while ((currentElement = nextElementFromClassIndex(*candidates, position + 1))) {
+        position = m_classIndexPosition;
+        if (++currentOffset == offset)
+            return currentElement;
+    }
+    return 0;
+}
+
 } // namespace WebCore
@@ -48,13 +48,22 @@ public:
 
     bool nodeMatchesInlined(Element*) const;
 
+    // Lists rooted at a Document or ShadowRoot walk the TreeScope's index of elements with the first
+    // class name instead of the whole tree, except while insertion notifications are in progress.
+    bool canUseClassIndex(ContainerNode* root) const;
+    Element* firstElementFromClassIndex(ContainerNode* root) const;
+    Element* traverseClassIndexForwardToOffset(unsigned offset, Element* currentElement, unsigned& currentOffset, ContainerNode* root) const;
+
 private:
     ClassNodeList(PassRefPtr<Node> rootNode, const String& classNames);
 
     virtual bool nodeMatches(Element*) const;
 
+    Element* nextElementFromClassIndex(const Vector<Element*>&, size_t startPosition) const;
+
     SpaceSplitString m_classNames;
     String m_originalClassNames;
+    mutable size_t m_classIndexPosition;
 };
 
 inline bool ClassNodeList::nodeMatchesInlined(Element* testNode) const
@@ -70,6 +79,11 @@ inline bool ClassNodeList::nodeMatchesInlined(Element* testNode) const
     return testNode->classNames().containsAll(m_classNames);
 }
 
+inline bool ClassNodeList::canUseClassIndex(ContainerNode* root) const
+{
+    return m_classNames.size() && root->isInTreeScope() && root->treeScope()->rootNode() == root && root->treeScope()->canUseElementIndexes();
+}
+
 } // namespace WebCore
 
 #endif // ClassNodeList_h
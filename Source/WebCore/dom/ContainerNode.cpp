@@ -77,6 +77,7 @@ static size_t s_attachDepth;
 static bool s_shouldReEnableMemoryCacheCallsAfterAttach;
 
 ChildNodesLazySnapshot* ChildNodesLazySnapshot::latestSnapshot = 0;
+ChildrenChangedBatch* ChildrenChangedBatch::s_innermostBatch = 0;
 
 #ifndef NDEBUG
 unsigned NoEventDispatchAssertion::s_count = 0;
@@ -283,6 +284,9 @@ bool ContainerNode::insertBefore(PassRefPtr<Node> newChild, Node* refChild, Exce
     InspectorInstrumentation::willInsertDOMNode(document(), this);
 
     ChildListMutationScope mutation(this);
+    ChildrenChangedBatch batch(document());
+    // The children of a fragment get their renderers from the next style recalc, all in one pass.
+    AttachBehavior childAttachBehavior = targets.size() > 1 ? AttachLazily : attachBehavior;
     for (NodeVector::const_iterator it = targets.begin(); it != targets.end(); ++it) {
         Node* child = it->get();
 
@@ -299,7 +303,7 @@ bool ContainerNode::insertBefore(PassRefPtr<Node> newChild, Node* refChild, Exce
 
         insertBeforeCommon(next.get(), child);
 
-        updateTreeAfterInsertion(this, child, attachBehavior);
+        updateTreeAfterInsertion(this, child, childAttachBehavior);
     }
 
     dispatchSubtreeModifiedEvent();
@@ -661,6 +665,9 @@ bool ContainerNode::appendChild(PassRefPtr<Node> newChild, ExceptionCode& ec, At
 
     // Now actually add the child(ren)
     ChildListMutationScope mutation(this);
+    ChildrenChangedBatch batch(document());
+    // The children of a fragment get their renderers from the next style recalc, all in one pass.
+    AttachBehavior childAttachBehavior = targets.size() > 1 ? AttachLazily : attachBehavior;
     for (NodeVector::const_iterator it = targets.begin(); it != targets.end(); ++it) {
         Node* child = it->get();
 
@@ -678,7 +685,7 @@ bool ContainerNode::appendChild(PassRefPtr<Node> newChild, ExceptionCode& ec, At
             appendChildToContainer(child, this);
         }
 
-        updateTreeAfterInsertion(this, child, attachBehavior);
+        updateTreeAfterInsertion(this, child, childAttachBehavior);
     }
 
     dispatchSubtreeModifiedEvent();
@@ -800,9 +807,48 @@ void ContainerNode::detach(const AttachContext& context)
     Node::detach(context);
 }
 
+ChildrenChangedBatch::ChildrenChangedBatch(Document* document)
+    : m_document(document)
+    , m_outerBatch(s_innermostBatch)
+{
+    s_innermostBatch = this;
+    m_document->beginChildrenChangedBatch();
+}
+
+ChildrenChangedBatch::~ChildrenChangedBatch()
+{
+    ASSERT(s_innermostBatch == this);
+    s_innermostBatch = m_outerBatch;
+    m_document->endChildrenChangedBatch();
+}
+
+void ChildrenChangedBatch::flushAllBatches()
+{
+    for (ChildrenChangedBatch* batch = s_innermostBatch; batch; batch = batch->m_outerBatch)
+        batch->m_document->flushDeferredChildrenChanges();
+}
+
+bool ContainerNode::deferChildrenChangedWork()
+{
+    Document* document = this->document();
+    if (!document->isBatchingChildrenChanges())
+        return false;
+
+    if (document->hasListenerType(Document::DOMSUBTREEMODIFIED_LISTENER)
+        || document->hasListenerType(Document::DOMNODEINSERTED_LISTENER)
+        || document->hasListenerType(Document::DOMNODEREMOVED_LISTENER))
+        return false;
+
+    document->deferChildrenChanged(this);
+    return true;
+}
+
 void ContainerNode::childrenChanged(bool changedByParser, Node*, Node*, int childCountDelta)
 {
     document()->incDOMTreeVersion();
+    if (deferChildrenChangedWork())
+        return;
+    document()->flushDeferredChildrenChanges();
     if (!changedByParser && childCountDelta)
         document()->updateRangesAfterChildrenChanged(this);
     invalidateNodeListCachesInAncestors();
@@ -830,6 +876,7 @@ inline static void cloneChildNodesAvoidingDeleteButton(ContainerNode* parent, Co
 
 void ContainerNode::cloneChildNodes(ContainerNode *clone)
 {
+    ChildrenChangedBatch batch(clone->document());
 #if ENABLE(DELETION_UI)
     HTMLElement* deleteButtonContainerElement = 0;
     if (Frame* frame = document()->frame())
@@ -878,6 +925,8 @@ bool ContainerNode::getUpperLeftCorner(FloatPoint& point) const
             return true;
         }
 
+        if (o->isText())
+            toRenderText(o)->ensureLineBoxes();
         if (p->node() && p->node() == this && o->isText() && !o->isBR() && !toRenderText(o)->firstTextBox()) {
             // do nothing - skip unrendered whitespace that is a child or next sibling of the anchor
         } else if ((o->isText() && !o->isBR()) || o->isReplaced()) {
@@ -1008,6 +1057,8 @@ static void dispatchChildInsertionEvents(Node* child)
 
 static void dispatchChildRemovalEvents(Node* child)
 {
+    child->document()->flushDeferredChildrenChanges();
+
     if (child->isInShadowTree()) {
         InspectorInstrumentation::willRemoveDOMNode(child->document(), child);
         return;
@@ -149,6 +149,8 @@ private:
     void suspendPostAttachCallbacks();
     void resumePostAttachCallbacks();
 
+    bool deferChildrenChangedWork();
+
     bool getUpperLeftCorner(FloatPoint&) const;
     bool getLowerRightCorner(FloatPoint&) const;
 
@@ -349,6 +351,33 @@ private:
     ContainerNode* m_node;
 };
 
+// While a ChildrenChangedBatch is alive, the containers of its document postpone the Range updates and
+// NodeList cache invalidation that childrenChanged() does for every inserted child. The Document does
+// the postponed work once per container, with a single walk over their ancestors, when its outermost
+// batch goes away. Insertion into a live document can run script, from insertedInto() or from focus
+// and load events, so the work is also done before entering script and before removing nodes. The
+// batch is bypassed altogether while mutation event listeners exist.
+class ChildrenChangedBatch {
+    WTF_MAKE_NONCOPYABLE(ChildrenChangedBatch);
+public:
+    explicit ChildrenChangedBatch(Document*);
+    ~ChildrenChangedBatch();
+
+    static void willRunScript()
+    {
+        if (s_innermostBatch)
+            flushAllBatches();
+    }
+
+private:
+    static void flushAllBatches();
+
+    RefPtr<Document> m_document;
+    ChildrenChangedBatch* m_outerBatch;
+
+    static ChildrenChangedBatch* s_innermostBatch;
+};
+
 } // namespace WebCore
 
 #endif // ContainerNode_h
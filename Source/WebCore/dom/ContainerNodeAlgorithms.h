@@ -222,10 +222,13 @@ inline void ChildNodeInsertionNotifier::notify(Node* node)
     RefPtr<Document> protectDocument(node->document());
     RefPtr<Node> protectNode(node);
 
+    // Scripts can run from insertedInto(), before the rest of the subtree has been told about the insertion.
+    protectDocument->incrementInsertionNotificationDepth();
     if (m_insertionPoint->inDocument())
         notifyNodeInsertedIntoDocument(node);
     else if (node->isContainerNode())
         notifyNodeInsertedIntoTree(toContainerNode(node));
+    protectDocument->decrementInsertionNotificationDepth();
 
     for (size_t i = 0; i < m_postInsertionNotificationTargets.size(); ++i)
         m_postInsertionNotificationTargets[i]->didNotifySubtreeInsertions(m_insertionPoint);
@@ -29,6 +29,7 @@
 #include "Document.h"
 
 #include "AXObjectCache.h"
+#include "AncestorIdentifierFilter.h"
 #include "AnimationController.h"
 #include "Attr.h"
 #include "Attribute.h"
@@ -62,6 +63,7 @@
 #include "ElementShadow.h"
 #include "EntityReference.h"
 #include "Event.h"
+#include "EventDispatcher.h"
 #include "EventFactory.h"
 #include "EventHandler.h"
 #include "EventListener.h"
@@ -401,6 +403,8 @@ Document::Document(Frame* frame, const KURL& url, unsigned documentClasses)
     , m_pendingSheetLayout(NoLayoutWithPendingSheets)
     , m_frame(frame)
     , m_activeParserCount(0)
+    , m_insertionNotificationDepth(0)
+    , m_childrenChangedBatchDepth(0)
     , m_contextFeatures(ContextFeatures::defaultSwitch())
     , m_wellFormed(false)
     , m_printing(false)
@@ -445,6 +449,8 @@ Document::Document(Frame* frame, const KURL& url, unsigned documentClasses)
 #endif
     , m_createRenderers(true)
     , m_inPageCache(false)
+    , m_deferredChildRenderersBoundsValid(false)
+    , m_deferredChildRenderersBoundsLayoutCount(0)
     , m_accessKeyMapValid(false)
     , m_documentClasses(documentClasses)
     , m_isViewSource(false)
@@ -634,6 +640,8 @@ void Document::dispose()
     m_documentElement = 0;
     m_contextFeatures = ContextFeatures::defaultSwitch();
     m_userActionElements.documentDidRemoveLastRef();
+    if (m_selectorQueryCache)
+        m_selectorQueryCache->invalidate();
 #if ENABLE(FULLSCREEN_API)
     m_fullScreenElement = 0;
     m_fullScreenElementStack.clear();
@@ -703,6 +711,13 @@ SelectorQueryCache* Document::selectorQueryCache()
     return m_selectorQueryCache.get();
 }
 
+AncestorIdentifierFilterCache* Document::ancestorIdentifierFilterCache()
+{
+    if (!m_ancestorIdentifierFilterCache)
+        m_ancestorIdentifierFilterCache = adoptPtr(new AncestorIdentifierFilterCache);
+    return m_ancestorIdentifierFilterCache.get();
+}
+
 MediaQueryMatcher* Document::mediaQueryMatcher()
 {
     if (!m_mediaQueryMatcher)
@@ -1946,6 +1961,17 @@ PassRefPtr<RenderStyle> Document::styleForPage(int pageIndex)
     return style.release();
 }
 
+size_t Document::styleMemoryUsage() const
+{
+    HashSet<const void*> visited;
+    size_t bytes = 0;
+    for (RenderObject* renderer = renderView(); renderer; renderer = renderer->nextInPreOrder()) {
+        if (RenderStyle* style = renderer->style())
+            bytes += style->memoryUsage(visited);
+    }
+    return bytes;
+}
+
 bool Document::isPageBoxVisible(int pageIndex)
 {
     RefPtr<RenderStyle> style = styleForPage(pageIndex);
@@ -2014,6 +2040,13 @@ void Document::clearStyleResolver()
     m_styleResolver.clear();
 }
 
+NodeArena* Document::nodeArena()
+{
+    if (!m_nodeArena)
+        m_nodeArena = NodeArena::create();
+    return m_nodeArena.get();
+}
+
 void Document::attach(const AttachContext& context)
 {
     ASSERT(!attached());
@@ -2044,6 +2077,9 @@ void Document::detach(const AttachContext& context)
     ASSERT(attached());
     ASSERT(!m_inPageCache);
 
+    // The cached event path holds a reference to the document itself.
+    m_cachedEventPath.clear();
+
 #if ENABLE(POINTER_LOCK)
     if (page())
         page()->pointerLockController()->documentDetached(this);
@@ -3594,6 +3630,11 @@ void Document::takeDOMWindowFrom(Document* document)
     m_domWindow = document->m_domWindow.release();
     m_domWindow->didSecureTransitionTo(this);
 
+    // Listeners registered on the window before the transition still count for this document.
+    Vector<AtomicString> eventTypes = m_domWindow->eventTargetData()->eventListenerMap.eventTypes();
+    for (size_t i = 0; i < eventTypes.size(); ++i)
+        addListenerTypeIfNeeded(eventTypes[i]);
+
     ASSERT(m_domWindow->document() == this);
     ASSERT(m_domWindow->frame() == m_frame);
 }
@@ -3689,6 +3730,22 @@ void Document::addListenerTypeIfNeeded(const AtomicString& eventType)
         addListenerType(BEFORELOAD_LISTENER);
     else if (eventType == eventNames().scrollEvent)
         addListenerType(SCROLL_LISTENER);
+    else if (eventType == eventNames().mousemoveEvent)
+        addListenerType(MOUSEMOVE_LISTENER);
+#if ENABLE(TOUCH_EVENTS)
+    else if (eventType == eventNames().touchmoveEvent)
+        addListenerType(TOUCHMOVE_LISTENER);
+#endif
+}
+
+PassOwnPtr<CachedEventPath> Document::takeCachedEventPath()
+{
+    return m_cachedEventPath.release();
+}
+
+void Document::setCachedEventPath(PassOwnPtr<CachedEventPath> cachedEventPath)
+{
+    m_cachedEventPath = cachedEventPath;
 }
 
 CSSStyleDeclaration* Document::getOverrideStyle(Element*, const String&)
@@ -4074,6 +4131,117 @@ void Document::unregisterForPageCacheSuspensionCallbacks(Element* e)
     m_documentSuspensionCallbackElements.remove(e);
 }
 
+void Document::addElementWithDeferredChildRenderers(Element* element)
+{
+    m_elementsWithDeferredChildRenderers.add(element);
+    m_deferredChildRenderersBoundsValid = false;
+}
+
+void Document::removeElementWithDeferredChildRenderers(Element* element)
+{
+    m_elementsWithDeferredChildRenderers.remove(element);
+    m_deferredChildRenderersBoundsValid = false;
+}
+
+void Document::updateDeferredChildRenderersBounds()
+{
+    int layoutCount = view() ? view()->layoutCount() : 0;
+    if (m_deferredChildRenderersBoundsValid && m_deferredChildRenderersBoundsLayoutCount == layoutCount)
+        return;
+
+    m_deferredChildRenderersBounds.clear();
+    HashSet<Element*>::iterator end = m_elementsWithDeferredChildRenderers.end();
+    for (HashSet<Element*>::iterator it = m_elementsWithDeferredChildRenderers.begin(); it != end; ++it) {
+        if (RenderObject* renderer = (*it)->renderer()) {
+            DeferredChildRenderersBounds bounds = { renderer->absoluteBoundingBoxRect(), 0, *it };
+            m_deferredChildRenderersBounds.append(bounds);
+        }
+    }
+    std::sort(m_deferredChildRenderersBounds.begin(), m_deferredChildRenderersBounds.end(), DeferredChildRenderersBounds::topLessThan);
+
+    // Boxes can overlap, so the bottoms are only ordered once we take the running maximum.
+    int maxBottom = std::numeric_limits<int>::min();
+    for (size_t i = 0; i < m_deferredChildRenderersBounds.size(); ++i) {
+        maxBottom = std::max(maxBottom, m_deferredChildRenderersBounds[i].rect.maxY());
+        m_deferredChildRenderersBounds[i].maxBottomSoFar = maxBottom;
+    }
+
+    m_deferredChildRenderersBoundsValid = true;
+    m_deferredChildRenderersBoundsLayoutCount = layoutCount;
+}
+
+void Document::realizeDeferredChildRenderersIntersecting(const IntRect& rect)
+{
+    updateDeferredChildRenderersBounds();
+
+    // Skip the boxes that end above the rect, then stop at the first one that starts below it.
+    const Vector<DeferredChildRenderersBounds>& bounds = m_deferredChildRenderersBounds;
+    size_t low = 0;
+    size_t high = bounds.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (bounds[middle].maxBottomSoFar <= rect.y())
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    // Realizing reattaches the element, which mutates the set.
+    Vector<RefPtr<Element> > elementsToRealize;
+    for (size_t i = low; i < bounds.size() && bounds[i].rect.y() < rect.maxY(); ++i) {
+        if (bounds[i].rect.intersects(rect))
+            elementsToRealize.append(bounds[i].element);
+    }
+
+    for (size_t i = 0; i < elementsToRealize.size(); ++i)
+        elementsToRealize[i]->realizeDeferredChildRenderers();
+}
+
+void Document::realizeDeferredChildRenderersForAncestors(Node* node)
+{
+    bool didRealize = false;
+    while (hasElementsWithDeferredChildRenderers()) {
+        // A realized ancestor can defer its children again, so go around until nothing is left.
+        bool realizedAncestor = false;
+        for (Element* ancestor = node->parentOrShadowHostElement(); ancestor; ancestor = ancestor->parentOrShadowHostElement()) {
+            if (ancestor->childRenderersDeferred()) {
+                ancestor->realizeDeferredChildRenderers();
+                realizedAncestor = true;
+            }
+        }
+        if (!realizedAncestor)
+            break;
+        didRealize = true;
+        updateStyleIfNeeded();
+    }
+
+    if (didRealize)
+        updateLayoutIgnorePendingStylesheets();
+}
+
+void Document::realizeDeferredChildRenderersInSubtree(Node* root)
+{
+    bool didRealize = false;
+    while (hasElementsWithDeferredChildRenderers()) {
+        Vector<RefPtr<Element> > elementsToRealize;
+        HashSet<Element*>::iterator end = m_elementsWithDeferredChildRenderers.end();
+        for (HashSet<Element*>::iterator it = m_elementsWithDeferredChildRenderers.begin(); it != end; ++it) {
+            if (root == this || root->containsIncludingShadowDOM(*it))
+                elementsToRealize.append(*it);
+        }
+        if (elementsToRealize.isEmpty())
+            break;
+
+        for (size_t i = 0; i < elementsToRealize.size(); ++i)
+            elementsToRealize[i]->realizeDeferredChildRenderers();
+        didRealize = true;
+        updateStyleIfNeeded();
+    }
+
+    if (didRealize)
+        updateLayoutIgnorePendingStylesheets();
+}
+
 void Document::mediaVolumeDidChange() 
 {
     HashSet<Element*>::iterator end = m_mediaVolumeCallbackElements.end();
@@ -4879,6 +5047,9 @@ void Document::windowScreenDidChange(PlatformDisplayID displayID)
         m_scriptedAnimationController->windowScreenDidChange(displayID);
 #endif
 
+    if (Frame* frame = this->frame())
+        frame->animation()->windowScreenDidChange(displayID);
+
 #if USE(ACCELERATED_COMPOSITING)
     if (RenderView* view = renderView()) {
         if (view->usesCompositing())
@@ -5757,6 +5928,42 @@ bool Document::hasActiveParser()
     return m_activeParserCount || (m_parser && m_parser->processingData());
 }
 
+void Document::endChildrenChangedBatch()
+{
+    ASSERT(m_childrenChangedBatchDepth);
+    if (!--m_childrenChangedBatchDepth)
+        flushDeferredChildrenChanges();
+}
+
+void Document::performDeferredChildrenChanges()
+{
+    HashSet<RefPtr<ContainerNode> > containers;
+    containers.swap(m_containersWithDeferredChildrenChanges);
+
+    // Siblings share most of their ancestors, so each ancestor's caches are only invalidated once.
+    // A container may have been adopted by another document since its children changed.
+    HashSet<Document*> invalidatedDocuments;
+    HashSet<Node*> invalidatedAncestors;
+    HashSet<RefPtr<ContainerNode> >::const_iterator end = containers.end();
+    for (HashSet<RefPtr<ContainerNode> >::const_iterator it = containers.begin(); it != end; ++it) {
+        ContainerNode* container = it->get();
+        Document* document = container->document();
+        document->updateRangesAfterChildrenChanged(container);
+
+        if (NodeListsNodeData* lists = container->nodeLists())
+            lists->clearChildNodeListCache();
+
+        if (!document->shouldInvalidateNodeListCaches())
+            continue;
+        if (invalidatedDocuments.add(document).isNewEntry)
+            document->invalidateNodeListCaches(0);
+        for (Node* node = container; node && invalidatedAncestors.add(node).isNewEntry; node = node->parentNode()) {
+            if (NodeListsNodeData* lists = node->nodeLists())
+                lists->invalidateCaches();
+        }
+    }
+}
+
 void Document::decrementActiveParserCount()
 {
     --m_activeParserCount;
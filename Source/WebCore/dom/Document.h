@@ -58,11 +58,13 @@
 namespace WebCore {
 
 class AXObjectCache;
+class AncestorIdentifierFilterCache;
 class Attr;
 class CDATASection;
 class CSSStyleDeclaration;
 class CSSStyleSheet;
 class CachedCSSStyleSheet;
+class CachedEventPath;
 class CachedResourceLoader;
 class CachedScript;
 class CanvasRenderingContext;
@@ -108,6 +110,7 @@ class HTMLScriptElement;
 class HitTestRequest;
 class HitTestResult;
 class IntPoint;
+class IntRect;
 class LayoutPoint;
 class LayoutRect;
 class LiveNodeListBase;
@@ -251,6 +254,7 @@ public:
     void invalidateAccessKeyMap();
 
     SelectorQueryCache* selectorQueryCache();
+    AncestorIdentifierFilterCache* ancestorIdentifierFilterCache();
 
     // DOM methods & attributes for Document
 
@@ -518,6 +522,9 @@ public:
     PassRefPtr<RenderStyle> styleForElementIgnoringPendingStylesheets(Element*);
     PassRefPtr<RenderStyle> styleForPage(int pageIndex);
 
+    // Bytes used by the RenderStyles of the render tree, counting shared styles and data groups once.
+    size_t styleMemoryUsage() const;
+
     // Returns true if page box (margin boxes and page borders) is visible.
     bool isPageBoxVisible(int pageIndex);
 
@@ -539,6 +546,7 @@ public:
     virtual void resumeActiveDOMObjects(ActiveDOMObject::ReasonForSuspension) OVERRIDE;
 
     RenderArena* renderArena() { return m_renderArena.get(); }
+    NodeArena* nodeArena();
 
     // Implemented in RenderView.h to avoid a cyclic header dependency this just
     // returns renderer so callers can avoid verbose casts.
@@ -752,8 +760,10 @@ public:
         ANIMATIONITERATION_LISTENER          = 1 << 9,
         TRANSITIONEND_LISTENER               = 1 << 10,
         BEFORELOAD_LISTENER                  = 1 << 11,
-        SCROLL_LISTENER                      = 1 << 12
-        // 3 bits remaining
+        SCROLL_LISTENER                      = 1 << 12,
+        MOUSEMOVE_LISTENER                   = 1 << 13,
+        TOUCHMOVE_LISTENER                   = 1 << 14
+        // 1 bit remaining
     };
 
     bool hasListenerType(ListenerType listenerType) const { return (m_listenerTypes & listenerType); }
@@ -894,6 +904,10 @@ public:
     void incDOMTreeVersion() { m_domTreeVersion = ++s_globalTreeVersion; }
     uint64_t domTreeVersion() const { return m_domTreeVersion; }
 
+    // See EventDispatcher. A cached path from an older tree version is only dropped by the next dispatch.
+    PassOwnPtr<CachedEventPath> takeCachedEventPath();
+    void setCachedEventPath(PassOwnPtr<CachedEventPath>);
+
     void setDocType(PassRefPtr<DocumentType>);
 
     // XPathEvaluator methods
@@ -969,6 +983,16 @@ public:
     void setShouldCreateRenderers(bool);
     bool shouldCreateRenderers();
 
+    // Elements whose children are waiting for renderers, see Element::childRenderersDeferred().
+    void addElementWithDeferredChildRenderers(Element*);
+    void removeElementWithDeferredChildRenderers(Element*);
+    bool hasElementsWithDeferredChildRenderers() const { return !m_elementsWithDeferredChildRenderers.isEmpty(); }
+    void realizeDeferredChildRenderersIntersecting(const IntRect&);
+    // For callers about to look at the geometry of |node|, or at the text of its subtree. They
+    // update style and layout first, and find everything up to date again afterwards.
+    void realizeDeferredChildRenderersForAncestors(Node*);
+    void realizeDeferredChildRenderersInSubtree(Node*);
+
     void setDecoder(PassRefPtr<TextResourceDecoder>);
     TextResourceDecoder* decoder() const { return m_decoder.get(); }
 
@@ -1156,6 +1180,22 @@ public:
     void incrementActiveParserCount() { ++m_activeParserCount; }
     void decrementActiveParserCount();
 
+    // See ChildNodeInsertionNotifier and TreeScope::canUseElementIndexes().
+    bool isNotifyingInsertions() const { return m_insertionNotificationDepth; }
+    void incrementInsertionNotificationDepth() { ++m_insertionNotificationDepth; }
+    void decrementInsertionNotificationDepth() { ASSERT(m_insertionNotificationDepth); --m_insertionNotificationDepth; }
+
+    // See ChildrenChangedBatch.
+    bool isBatchingChildrenChanges() const { return m_childrenChangedBatchDepth; }
+    void beginChildrenChangedBatch() { ++m_childrenChangedBatchDepth; }
+    void endChildrenChangedBatch();
+    void deferChildrenChanged(ContainerNode* container) { m_containersWithDeferredChildrenChanges.add(container); }
+    void flushDeferredChildrenChanges()
+    {
+        if (!m_containersWithDeferredChildrenChanges.isEmpty())
+            performDeferredChildrenChanges();
+    }
+
     void setContextFeatures(PassRefPtr<ContextFeatures>);
     ContextFeatures* contextFeatures() { return m_contextFeatures.get(); }
 
@@ -1212,6 +1252,8 @@ private:
 
     void detachParser();
 
+    void performDeferredChildrenChanges();
+
     typedef void (*ArgumentsCallback)(const String& keyString, const String& valueString, Document*, void* data);
     void processArguments(const String& features, void* data, ArgumentsCallback);
 
@@ -1299,6 +1341,9 @@ private:
     RefPtr<CachedResourceLoader> m_cachedResourceLoader;
     RefPtr<DocumentParser> m_parser;
     unsigned m_activeParserCount;
+    unsigned m_insertionNotificationDepth;
+    unsigned m_childrenChangedBatchDepth;
+    HashSet<RefPtr<ContainerNode> > m_containersWithDeferredChildrenChanges;
     RefPtr<ContextFeatures> m_contextFeatures;
 
     bool m_wellFormed;
@@ -1345,6 +1390,7 @@ private:
 
     uint64_t m_domTreeVersion;
     static uint64_t s_globalTreeVersion;
+    OwnPtr<CachedEventPath> m_cachedEventPath;
     
     HashSet<NodeIterator*> m_nodeIterators;
     HashSet<Range*> m_ranges;
@@ -1388,6 +1434,7 @@ private:
     RefPtr<Element> m_titleElement;
 
     RefPtr<RenderArena> m_renderArena;
+    RefPtr<NodeArena> m_nodeArena;
 
     OwnPtr<AXObjectCache> m_axObjectCache;
     OwnPtr<DocumentMarkerController> m_markers;
@@ -1456,11 +1503,26 @@ private:
 #if ENABLE(VIDEO_TRACK)
     HashSet<Element*> m_captionPreferencesChangedElements;
 #endif
+    HashSet<Element*> m_elementsWithDeferredChildRenderers;
+    // The elements above with their absolute bounds, sorted by top, so that scrolling only looks
+    // at the ones near the viewport. Rebuilt after layout or when the set changes.
+    struct DeferredChildRenderersBounds {
+        IntRect rect;
+        int maxBottomSoFar;
+        Element* element;
+
+        static bool topLessThan(const DeferredChildRenderersBounds& a, const DeferredChildRenderersBounds& b) { return a.rect.y() < b.rect.y(); }
+    };
+    void updateDeferredChildRenderersBounds();
+    Vector<DeferredChildRenderersBounds> m_deferredChildRenderersBounds;
+    bool m_deferredChildRenderersBoundsValid;
+    int m_deferredChildRenderersBoundsLayoutCount;
 
     HashMap<StringImpl*, Element*, CaseFoldingHash> m_elementsByAccessKey;
     bool m_accessKeyMapValid;
 
     OwnPtr<SelectorQueryCache> m_selectorQueryCache;
+    OwnPtr<AncestorIdentifierFilterCache> m_ancestorIdentifierFilterCache;
 
     DocumentClassFlags m_documentClasses;
 
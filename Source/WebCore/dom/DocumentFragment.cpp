@@ -77,11 +77,13 @@ PassRefPtr<Node> DocumentFragment::cloneNode(bool deep)
 
 void DocumentFragment::parseHTML(const String& source, Element* contextElement, ParserContentPolicy parserContentPolicy)
 {
+    ChildrenChangedBatch batch(document());
     HTMLDocumentParser::parseDocumentFragment(source, this, contextElement, parserContentPolicy);
 }
 
 bool DocumentFragment::parseXML(const String& source, Element* contextElement, ParserContentPolicy parserContentPolicy)
 {
+    ChildrenChangedBatch batch(document());
     return XMLDocumentParser::parseDocumentFragment(source, this, contextElement, parserContentPolicy);
 }
 
@@ -31,6 +31,7 @@
 #include "NodeTraversal.h"
 #include "Range.h"
 #include "RenderObject.h"
+#include "RenderText.h"
 #include "RenderedDocumentMarker.h"
 #include "TextIterator.h"
 #include <stdio.h>
@@ -178,8 +179,12 @@ void DocumentMarkerController::addMarker(Node* node, const DocumentMarker& newMa
     }
 
     // repaint the affected node
-    if (node->renderer())
-        node->renderer()->repaint();
+    if (RenderObject* renderer = node->renderer()) {
+        // Markers are painted by the text boxes, which text laid out by the simple line layout path doesn't have yet.
+        if (renderer->isText())
+            toRenderText(renderer)->ensureLineBoxes();
+        renderer->repaint();
+    }
 }
 
 // copies markers from srcNode to dstNode, applying the specified shift delta to the copies.  The shift is
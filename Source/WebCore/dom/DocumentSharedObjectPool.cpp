@@ -66,28 +66,55 @@ public:
     RefPtr<ShareableElementData> value;
 };
 
+ShareableElementData* DocumentSharedObjectPool::lookUpShareableElementData(const Attribute* attributes, unsigned attributeCount, OwnPtr<ShareableElementDataCacheEntry>*& emptyCacheSlot)
+{
+    ShareableElementDataCacheKey cacheKey(attributes, attributeCount);
+    OwnPtr<ShareableElementDataCacheEntry>& cacheEntry = m_shareableElementDataCache.add(cacheKey.hash(), nullptr).iterator->value;
+
+    emptyCacheSlot = 0;
+    if (!cacheEntry) {
+        emptyCacheSlot = &cacheEntry;
+        return 0;
+    }
+
+    // On a hash collision the new element data is simply not cached.
+    if (cacheEntry->key != cacheKey)
+        return 0;
+
+    return cacheEntry->value.get();
+}
+
+static void fillCacheSlot(OwnPtr<ShareableElementDataCacheEntry>* cacheSlot, ShareableElementData* elementData)
+{
+    if (cacheSlot)
+        *cacheSlot = adoptPtr(new ShareableElementDataCacheEntry(ShareableElementDataCacheKey(elementData->m_attributeArray, elementData->length()), elementData));
+}
+
 PassRefPtr<ShareableElementData> DocumentSharedObjectPool::cachedShareableElementDataWithAttributes(const Vector<Attribute>& attributes)
 {
     ASSERT(!attributes.isEmpty());
 
-    ShareableElementDataCacheKey cacheKey(attributes.data(), attributes.size());
-    unsigned cacheHash = cacheKey.hash();
-
-    ShareableElementDataCache::iterator cacheIterator = m_shareableElementDataCache.add(cacheHash, nullptr).iterator;
-    if (cacheIterator->value && cacheIterator->value->key != cacheKey)
-        cacheHash = 0;
+    OwnPtr<ShareableElementDataCacheEntry>* emptyCacheSlot;
+    if (ShareableElementData* elementData = lookUpShareableElementData(attributes.data(), attributes.size(), emptyCacheSlot))
+        return elementData;
 
-    RefPtr<ShareableElementData> elementData;
-    if (cacheHash && cacheIterator->value)
-        elementData = cacheIterator->value->value;
-    else
-        elementData = ShareableElementData::createWithAttributes(attributes);
+    RefPtr<ShareableElementData> elementData = ShareableElementData::createWithAttributes(attributes);
+    fillCacheSlot(emptyCacheSlot, elementData.get());
+    return elementData.release();
+}
 
-    if (!cacheHash || cacheIterator->value)
-        return elementData.release();
+PassRefPtr<ShareableElementData> DocumentSharedObjectPool::cachedShareableElementDataWithAttributes(const UniqueElementData& uniqueElementData)
+{
+    ASSERT(!uniqueElementData.isEmpty());
 
-    cacheIterator->value = adoptPtr(new ShareableElementDataCacheEntry(ShareableElementDataCacheKey(elementData->m_attributeArray, elementData->length()), elementData));
+    OwnPtr<ShareableElementDataCacheEntry>* emptyCacheSlot;
+    if (ShareableElementData* elementData = lookUpShareableElementData(uniqueElementData.m_attributeVector.data(), uniqueElementData.m_attributeVector.size(), emptyCacheSlot))
+        return elementData;
 
+    // Unlike attributes coming from the parser, the copy carries the class names, id and inline style
+    // that were already derived from the attributes.
+    RefPtr<ShareableElementData> elementData = uniqueElementData.makeShareableCopy();
+    fillCacheSlot(emptyCacheSlot, elementData.get());
     return elementData.release();
 }
 
@@ -36,6 +36,7 @@ namespace WebCore {
 class Attribute;
 class ShareableElementData;
 class ShareableElementDataCacheEntry;
+class UniqueElementData;
 
 class DocumentSharedObjectPool {
 public:
@@ -43,10 +44,13 @@ public:
     ~DocumentSharedObjectPool();
 
     PassRefPtr<ShareableElementData> cachedShareableElementDataWithAttributes(const Vector<Attribute>&);
+    PassRefPtr<ShareableElementData> cachedShareableElementDataWithAttributes(const UniqueElementData&);
 
 private:
     DocumentSharedObjectPool();
 
+    ShareableElementData* lookUpShareableElementData(const Attribute*, unsigned attributeCount, OwnPtr<ShareableElementDataCacheEntry>*& emptyCacheSlot);
+
     typedef HashMap<unsigned, OwnPtr<ShareableElementDataCacheEntry>, AlreadyHashed> ShareableElementDataCache;
     ShareableElementDataCache m_shareableElementDataCache;
 };
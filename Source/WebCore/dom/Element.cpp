@@ -103,6 +103,13 @@ namespace WebCore {
 using namespace HTMLNames;
 using namespace XMLNames;
 
+struct SameSizeAsElement : public ContainerNode {
+    QualifiedName tagName;
+    void* elementData;
+};
+
+COMPILE_ASSERT(sizeof(Element) == sizeof(SameSizeAsElement), Element_should_stay_small);
+
 static inline bool shouldIgnoreAttributeCase(const Element* e)
 {
     return e && e->document()->isHTMLDocument() && e->isHTMLElement();
@@ -576,6 +583,7 @@ void Element::setHovered(bool flag)
 void Element::scrollIntoView(bool alignToTop) 
 {
     document()->updateLayoutIgnorePendingStylesheets();
+    document()->realizeDeferredChildRenderersForAncestors(this);
 
     if (!renderer())
         return;
@@ -591,6 +599,7 @@ void Element::scrollIntoView(bool alignToTop)
 void Element::scrollIntoViewIfNeeded(bool centerIfNeeded)
 {
     document()->updateLayoutIgnorePendingStylesheets();
+    document()->realizeDeferredChildRenderersForAncestors(this);
 
     if (!renderer())
         return;
@@ -878,6 +887,7 @@ IntRect Element::boundsInRootViewSpace()
 PassRefPtr<ClientRectList> Element::getClientRects()
 {
     document()->updateLayoutIgnorePendingStylesheets();
+    document()->realizeDeferredChildRenderersForAncestors(this);
 
     RenderBoxModelObject* renderBoxModelObject = this->renderBoxModelObject();
     if (!renderBoxModelObject)
@@ -895,6 +905,7 @@ PassRefPtr<ClientRectList> Element::getClientRects()
 PassRefPtr<ClientRect> Element::getBoundingClientRect()
 {
     document()->updateLayoutIgnorePendingStylesheets();
+    document()->realizeDeferredChildRenderersForAncestors(this);
 
     Vector<FloatQuad> quads;
 #if ENABLE(SVG)
@@ -1143,6 +1154,10 @@ void Element::classAttributeChanged(const AtomicString& newClassString)
     bool testShouldInvalidateStyle = attached() && styleResolver && styleChangeType() < FullStyleChange;
     bool shouldInvalidateStyle = false;
 
+    TreeScope* classIndexScope = isInTreeScope() && treeScope()->shouldCacheElementsByClassName() ? treeScope() : 0;
+    if (classIndexScope)
+        classIndexScope->removeElementByClassNames(this);
+
     if (classStringHasClassName(newClassString)) {
         const bool shouldFoldCase = document()->inQuirksMode();
         const SpaceSplitString oldClasses = elementData()->classNames();
@@ -1158,6 +1173,9 @@ void Element::classAttributeChanged(const AtomicString& newClassString)
     if (hasRareData())
         elementRareData()->clearClassListValueForQuirksMode();
 
+    if (classIndexScope)
+        classIndexScope->addElementByClassNames(this);
+
     if (shouldInvalidateStyle)
         setNeedsStyleRecalc();
 }
@@ -1312,6 +1330,11 @@ Node::InsertionNotificationRequest Element::insertedInto(ContainerNode* insertio
     ContainerNode::insertedInto(insertionPoint);
     ASSERT(!wasInDocument || inDocument());
 
+    // Presentation attribute style is only stored in UniqueElementData, so an element that is about
+    // to build it would just be given unique data again.
+    if (!wasInDocument && inDocument() && m_elementData && !m_elementData->m_presentationAttributeStyleIsDirty)
+        shareUniqueElementDataIfPossible();
+
 #if ENABLE(FULLSCREEN_API)
     if (containsFullScreenElement() && parentElement() && !parentElement()->containsFullScreenElement())
         setContainsFullScreenElementOnAncestorsCrossingFrameBoundaries(true);
@@ -1355,6 +1378,11 @@ Node::InsertionNotificationRequest Element::insertedInto(ContainerNode* insertio
             updateLabel(newScope, nullAtom, fastGetAttribute(forAttr));
     }
 
+    if (newScope && newScope->shouldCacheElementsByClassName())
+        newScope->addElementByClassNames(this);
+    if (newScope && newScope->shouldCacheElementsByDataAttribute())
+        newScope->addElementByDataAttributes(this);
+
     return InsertionDone;
 }
 
@@ -1410,6 +1438,11 @@ void Element::removedFrom(ContainerNode* insertionPoint)
             if (oldScope->shouldCacheLabelsByForAttribute())
                 updateLabel(oldScope, fastGetAttribute(forAttr), nullAtom);
         }
+
+        if (oldScope && oldScope->shouldCacheElementsByClassName())
+            oldScope->removeElementByClassNames(this);
+        if (oldScope && oldScope->shouldCacheElementsByDataAttribute())
+            oldScope->removeElementByDataAttributes(this);
     }
 
     ContainerNode::removedFrom(insertionPoint);
@@ -1431,6 +1464,7 @@ void Element::attach(const AttachContext& context)
     WidgetHierarchyUpdatesSuspensionScope suspendWidgetHierarchyUpdates;
 
     createRendererIfNeeded(context);
+    deferChildRenderersIfNeeded();
 
     if (parentElement() && parentElement()->isInCanvasSubtree())
         setIsInCanvasSubtree(true);
@@ -1477,6 +1511,12 @@ void Element::detach(const AttachContext& context)
         data->resetComputedStyle();
         data->resetDynamicRestyleObservations();
         data->setIsInsideRegion(false);
+        if (data->childRenderersDeferred()) {
+            data->setChildRenderersDeferred(false);
+            document()->removeElementWithDeferredChildRenderers(this);
+        }
+        if (!context.performingReattach)
+            data->setChildRenderersRealized(false);
     }
 
     if (ElementShadow* shadow = this->shadow())
@@ -1584,6 +1624,9 @@ void Element::recalcStyle(StyleChange change)
         }
 
         if (RenderObject* renderer = this->renderer()) {
+            // pseudoStyleCacheIsInvalid() records this element's pseudo styles in newStyle.
+            if (newStyle->isInterned() && currentStyle->cachedPseudoStyles())
+                newStyle = RenderStyle::clone(newStyle.get());
             if (localChange != NoChange || pseudoStyleCacheIsInvalid(currentStyle.get(), newStyle.get()) || (change == Force && renderer->requiresForcedStyleRecalcPropagation()) || styleChangeType() == SyntheticStyleChange)
                 renderer->setAnimatableStyle(newStyle.get());
             else if (needsStyleRecalc()) {
@@ -2209,6 +2252,7 @@ String Element::innerText()
 {
     // We need to update layout, since plainText uses line boxes in the render tree.
     document()->updateLayoutIgnorePendingStylesheets();
+    document()->realizeDeferredChildRenderersInSubtree(this);
 
     if (!renderer())
         return textContent(true);
@@ -2433,6 +2477,42 @@ bool Element::isInsideRegion() const
     return hasRareData() ? elementRareData()->isInsideRegion() : false;
 }
 
+bool Element::childRenderersDeferred() const
+{
+    return hasRareData() && elementRareData()->childRenderersDeferred();
+}
+
+void Element::deferChildRenderersIfNeeded()
+{
+    RenderObject* renderer = this->renderer();
+    if (!renderer || renderer->style()->contentVisibility() != ContentVisibilityAuto)
+        return;
+    Settings* settings = document()->settings();
+    if (!settings || !settings->lazyOffscreenRenderingEnabled())
+        return;
+    // A shadow tree decides on its own where the children render, and only a block can
+    // stand in for its content with a size of its own.
+    if (shadow() || !renderer->isRenderBlock())
+        return;
+    if (hasRareData() && elementRareData()->childRenderersRealized())
+        return;
+
+    ensureElementRareData()->setChildRenderersDeferred(true);
+    document()->addElementWithDeferredChildRenderers(this);
+}
+
+void Element::realizeDeferredChildRenderers()
+{
+    if (!childRenderersDeferred())
+        return;
+
+    ElementRareData* data = elementRareData();
+    data->setChildRenderersDeferred(false);
+    data->setChildRenderersRealized(true);
+    document()->removeElementWithDeferredChildRenderers(this);
+    lazyReattach();
+}
+
 void Element::setRegionOversetState(RegionOversetState state)
 {
     ensureElementRareData()->setRegionOversetState(state);
@@ -3005,6 +3085,14 @@ void Element::willModifyAttribute(const QualifiedName& name, const AtomicString&
         TreeScope* scope = treeScope();
         if (scope->shouldCacheLabelsByForAttribute())
             updateLabel(scope, oldValue, newValue);
+    } else if (oldValue.isNull() != newValue.isNull() && isInTreeScope()) {
+        TreeScope* scope = treeScope();
+        if (scope->shouldCacheElementsByDataAttribute() && TreeScope::isIndexedDataAttribute(name)) {
+            if (oldValue.isNull())
+                scope->addElementByDataAttribute(name.localName(), this);
+            else
+                scope->removeElementByDataAttribute(name.localName(), this);
+        }
     }
 
     if (oldValue != newValue) {
@@ -3155,6 +3243,13 @@ void Element::cloneAttributesFromElement(const Element& other)
         detachAllAttrNodesFromElement();
 
     other.synchronizeAllAttributes();
+
+    TreeScope* indexScope = isInTreeScope() ? treeScope() : 0;
+    if (indexScope && indexScope->shouldCacheElementsByClassName())
+        indexScope->removeElementByClassNames(this);
+    if (indexScope && indexScope->shouldCacheElementsByDataAttribute())
+        indexScope->removeElementByDataAttributes(this);
+
     if (!other.m_elementData) {
         m_elementData.clear();
         return;
@@ -3177,17 +3272,18 @@ void Element::cloneAttributesFromElement(const Element& other)
         updateName(oldName, newName);
 
     // If 'other' has a mutable ElementData, convert it to an immutable one so we can share it between both elements.
-    // We can only do this if there is no CSSOM wrapper for other's inline style, and there are no presentation attributes.
-    if (other.m_elementData->isUnique()
-        && !other.m_elementData->presentationAttributeStyle()
-        && (!other.m_elementData->inlineStyle() || !other.m_elementData->inlineStyle()->hasCSSOMWrapper()))
-        const_cast<Element&>(other).m_elementData = static_cast<const UniqueElementData*>(other.m_elementData.get())->makeShareableCopy();
+    const_cast<Element&>(other).shareUniqueElementDataIfPossible();
 
     if (!other.m_elementData->isUnique())
         m_elementData = other.m_elementData;
     else
         m_elementData = other.m_elementData->makeUniqueCopy();
 
+    if (indexScope && indexScope->shouldCacheElementsByClassName())
+        indexScope->addElementByClassNames(this);
+    if (indexScope && indexScope->shouldCacheElementsByDataAttribute())
+        indexScope->addElementByDataAttributes(this);
+
     for (unsigned i = 0; i < m_elementData->length(); ++i) {
         const Attribute* attribute = const_cast<const ElementData*>(m_elementData.get())->attributeItem(i);
         attributeChangedFromParserOrByCloning(attribute->name(), attribute->value(), ModifiedByCloning);
@@ -3210,6 +3306,31 @@ void Element::createUniqueElementData()
     }
 }
 
+void Element::shareUniqueElementDataIfPossible()
+{
+    if (!m_elementData || !m_elementData->isUnique() || m_elementData->isEmpty())
+        return;
+
+    // The attributes have to be in sync, and there can be no presentation attribute style or
+    // CSSOM wrapper for the inline style, since those belong to this element alone.
+    if (m_elementData->m_styleAttributeIsDirty
+#if ENABLE(SVG)
+        || m_elementData->m_animatedSVGAttributesAreDirty
+#endif
+        || m_elementData->presentationAttributeStyle()
+        || (m_elementData->inlineStyle() && m_elementData->inlineStyle()->hasCSSOMWrapper()))
+        return;
+
+    // Elements whose attributes were set from script carry a UniqueElementData sized for further
+    // mutation. Swap it for a compact shareable copy, and while the document still has its shared
+    // object pool, for the same copy other elements with identical attributes use.
+    const UniqueElementData* uniqueElementData = static_cast<const UniqueElementData*>(m_elementData.get());
+    if (DocumentSharedObjectPool* pool = document()->sharedObjectPool())
+        m_elementData = pool->cachedShareableElementDataWithAttributes(*uniqueElementData);
+    else
+        m_elementData = uniqueElementData->makeShareableCopy();
+}
+
 #if ENABLE(SVG)
 bool Element::hasPendingResources() const
 {
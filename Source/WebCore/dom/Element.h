@@ -482,6 +482,12 @@ public:
     void setIsInsideRegion(bool);
     bool isInsideRegion() const;
 
+    // With Settings::lazyOffscreenRenderingEnabled(), the children of a -webkit-content-visibility: auto
+    // element get no renderers until the FrameView scrolls close to it. Until then the element's own
+    // renderer stands in for them, sized by its own style.
+    bool childRenderersDeferred() const;
+    void realizeDeferredChildRenderers();
+
     void setRegionOversetState(RegionOversetState);
     RegionOversetState regionOversetState() const;
 
@@ -765,6 +771,7 @@ private:
     void unregisterNamedFlowContentNode();
 
     void createUniqueElementData();
+    void shareUniqueElementDataIfPossible();
 
     ElementRareData* elementRareData() const;
     ElementRareData* ensureElementRareData();
@@ -773,6 +780,7 @@ private:
     void detachAttrNodeFromElementWithValue(Attr*, const AtomicString& value);
 
     void createRendererIfNeeded(const AttachContext&);
+    void deferChildRenderersIfNeeded();
 
     bool isJavaScriptURLAttribute(const Attribute&) const;
 
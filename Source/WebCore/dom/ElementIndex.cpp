@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ElementIndex.h"
+
+#include "Element.h"
+
+namespace WebCore {
+
+static inline bool precedes(Element* a, Element* b)
+{
+    return b->compareDocumentPosition(a) & Node::DOCUMENT_POSITION_PRECEDING;
+}
+
+void ElementIndex::applyRemovals(Entry& entry)
+{
+    if (entry.removedElements.isEmpty())
+        return;
+
+    Vector<Element*>& elements = entry.elements;
+    size_t kept = 0;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (!entry.removedElements.contains(elements[i]))
+            elements[kept++] = elements[i];
+    }
+    elements.shrink(kept);
+    entry.removedElements.clear();
+}
+
+void ElementIndex::add(AtomicStringImpl* key, Element* element)
+{
+    ASSERT(key);
+    ASSERT(element);
+
+    Map::AddResult result = m_map.add(key, nullptr);
+    if (result.isNewEntry)
+        result.iterator->value = adoptPtr(new Entry);
+    Entry& entry = *result.iterator->value;
+
+    // Removed elements may no longer be in the document, so they can't be ordered against.
+    applyRemovals(entry);
+    Vector<Element*>& elements = entry.elements;
+
+    // The parser and appendChild() insert at the end of the document, so check that first.
+    if (elements.isEmpty() || precedes(elements.last(), element)) {
+        elements.append(element);
+        return;
+    }
+
+    size_t low = 0;
+    size_t high = elements.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (elements[middle] == element)
+            return;
+        if (precedes(elements[middle], element))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    elements.insert(low, element);
+}
+
+void ElementIndex::remove(AtomicStringImpl* key, Element* element)
+{
+    ASSERT(key);
+    ASSERT(element);
+
+    Map::iterator it = m_map.find(key);
+    if (it == m_map.end())
+        return;
+    Entry& entry = *it->value;
+    entry.removedElements.add(element);
+    if (entry.removedElements.size() < entry.elements.size())
+        return;
+
+    applyRemovals(entry);
+    if (entry.elements.isEmpty())
+        m_map.remove(it);
+}
+
+const Vector<Element*>* ElementIndex::get(AtomicStringImpl* key)
+{
+    ASSERT(key);
+    Map::iterator it = m_map.find(key);
+    if (it == m_map.end())
+        return 0;
+    Entry& entry = *it->value;
+    applyRemovals(entry);
+    if (entry.elements.isEmpty()) {
+        m_map.remove(it);
+        return 0;
+    }
+    return &entry.elements;
+}
+
+size_t ElementIndex::find(const Vector<Element*>& elements, Element* element)
+{
+    size_t low = 0;
+    size_t high = elements.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (elements[middle] == element)
+            return middle;
+        if (precedes(elements[middle], element))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return notFound;
+}
+
+} // namespace WebCore
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ElementIndex_h
+#define ElementIndex_h
+
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/AtomicStringImpl.h>
+
+namespace WebCore {
+
+class Element;
+
+// Maps a key to every element in a tree scope that carries it, in document order. Unlike
+// DocumentOrderedMap, the lists are maintained as elements come and go rather than rebuilt
+// by walking the tree after every change. Removals are only recorded and applied in a single
+// pass the next time the list is needed, so taking a subtree out of the document stays linear.
+class ElementIndex {
+    WTF_MAKE_NONCOPYABLE(ElementIndex); WTF_MAKE_FAST_ALLOCATED;
+public:
+    ElementIndex() { }
+
+    // Adding an element that is already listed under the key, or removing one that is not, is a no-op.
+    void add(AtomicStringImpl*, Element*);
+    void remove(AtomicStringImpl*, Element*);
+
+    const Vector<Element*>* get(AtomicStringImpl*);
+
+    // Finds an element in a list returned by get() by its document position.
+    static size_t find(const Vector<Element*>&, Element*);
+
+private:
+    struct Entry {
+        Vector<Element*> elements;
+        HashSet<Element*> removedElements;
+    };
+
+    static void applyRemovals(Entry&);
+
+    typedef HashMap<AtomicStringImpl*, OwnPtr<Entry> > Map;
+    Map m_map;
+};
+
+} // namespace WebCore
+
+#endif // ElementIndex_h
@@ -63,6 +63,11 @@ public:
     bool isInsideRegion() const { return m_isInsideRegion; }
     void setIsInsideRegion(bool value) { m_isInsideRegion = value; }
 
+    bool childRenderersDeferred() const { return m_childRenderersDeferred; }
+    void setChildRenderersDeferred(bool value) { m_childRenderersDeferred = value; }
+    bool childRenderersRealized() const { return m_childRenderersRealized; }
+    void setChildRenderersRealized(bool value) { m_childRenderersRealized = value; }
+
     RegionOversetState regionOversetState() const { return m_regionOversetState; }
     void setRegionOversetState(RegionOversetState state) { m_regionOversetState = state; }
 
@@ -163,6 +168,8 @@ private:
     unsigned m_childrenAffectedByBackwardPositionalRules : 1;
 
     unsigned m_isInsideRegion : 1;
+    unsigned m_childRenderersDeferred : 1;
+    unsigned m_childRenderersRealized : 1;
     RegionOversetState m_regionOversetState;
 
     LayoutSize m_minimumSizeForResizing;
@@ -212,6 +219,8 @@ inline ElementRareData::ElementRareData(RenderObject* renderer)
     , m_childrenAffectedByForwardPositionalRules(false)
     , m_childrenAffectedByBackwardPositionalRules(false)
     , m_isInsideRegion(false)
+    , m_childRenderersDeferred(false)
+    , m_childRenderersRealized(false)
     , m_regionOversetState(RegionUndefined)
     , m_minimumSizeForResizing(defaultMinimumSizeForResizing())
 {
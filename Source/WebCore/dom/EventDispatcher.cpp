@@ -27,9 +27,11 @@
 #include "EventDispatcher.h"
 
 #include "ContainerNode.h"
+#include "Document.h"
 #include "ElementShadow.h"
 #include "EventContext.h"
 #include "EventDispatchMediator.h"
+#include "EventNames.h"
 #include "EventPathWalker.h"
 #include "EventRetargeter.h"
 #include "FrameView.h"
@@ -53,8 +55,25 @@ bool EventDispatcher::dispatchEvent(Node* node, PassRefPtr<EventDispatchMediator
     return mediator->dispatchEvent(&dispatcher);
 }
 
+// Listener presence is only tracked for the event types that fire at high frequency; for
+// everything else listeners are assumed to exist.
+static bool mayHaveEventListeners(Document* document, const AtomicString& eventType)
+{
+    if (eventType == eventNames().mousemoveEvent)
+        return document->hasListenerType(Document::MOUSEMOVE_LISTENER);
+#if ENABLE(TOUCH_EVENTS)
+    if (eventType == eventNames().touchmoveEvent)
+        return document->hasListenerType(Document::TOUCHMOVE_LISTENER);
+#endif
+    if (eventType == eventNames().scrollEvent)
+        return document->hasListenerType(Document::SCROLL_LISTENER);
+    return true;
+}
+
 EventDispatcher::EventDispatcher(Node* node, PassRefPtr<Event> event)
-    : m_node(node)
+    : m_skipsEventListeners(false)
+    , m_eventPathTreeVersion(0)
+    , m_node(node)
     , m_event(event)
 #ifndef NDEBUG
     , m_eventDispatched(false)
@@ -63,8 +82,99 @@ EventDispatcher::EventDispatcher(Node* node, PassRefPtr<Event> event)
     ASSERT(node);
     ASSERT(m_event.get());
     ASSERT(!m_event->type().isNull()); // JavaScript code can create an event with an empty name, but not null.
-    m_view = node->document()->view();
-    EventRetargeter::calculateEventPath(m_node.get(), m_event.get(), m_eventPath);
+    Document* document = node->document();
+    m_view = document->view();
+
+    if (!mayHaveEventListeners(document, m_event->type()) && collectNodesForDefaultEventHandlers()) {
+        m_skipsEventListeners = true;
+        return;
+    }
+
+    m_eventPathTreeVersion = document->domTreeVersion();
+    if (!takeCachedEventPath())
+        EventRetargeter::calculateEventPath(m_node.get(), m_event.get(), m_eventPath);
+}
+
+EventDispatcher::~EventDispatcher()
+{
+    storeEventPathInCache();
+}
+
+// Without listeners, the event path is only needed for the nodes whose default event
+// handlers run. As long as no shadow boundary is crossed (where the path could stop early,
+// depending on the event) that is just the chain EventPathWalker visits.
+bool EventDispatcher::collectNodesForDefaultEventHandlers()
+{
+    bool inDocument = m_node->inDocument();
+    for (EventPathWalker walker(m_node.get()); walker.node(); walker.moveToParent()) {
+        Node* node = walker.node();
+        if (node->isShadowRoot()) {
+            m_nodesForDefaultEventHandlers.clear();
+            return false;
+        }
+        m_nodesForDefaultEventHandlers.append(node);
+        if (!inDocument)
+            break;
+    }
+    return true;
+}
+
+bool EventDispatcher::takeCachedEventPath()
+{
+    Document* document = m_node->document();
+    OwnPtr<CachedEventPath> cachedEventPath = document->takeCachedEventPath();
+    if (!cachedEventPath
+        || cachedEventPath->m_node != m_node
+        || cachedEventPath->m_eventType != m_event->type()
+        || cachedEventPath->m_isMouseOrFocusEvent != (m_event->isMouseEvent() || m_event->isFocusEvent())
+        || cachedEventPath->m_domTreeVersion != m_eventPathTreeVersion)
+        return false;
+
+    m_eventPath.swap(cachedEventPath->m_eventPath);
+    return true;
+}
+
+bool EventDispatcher::eventPathIsCacheable() const
+{
+    // Documents without a frame are never detached, and would be kept alive by their own cache.
+    Document* document = m_node->document();
+    if (!m_node->inDocument() || !document->frame())
+        return false;
+#if ENABLE(TOUCH_EVENTS)
+    // Touch event contexts accumulate per-event touch lists.
+    if (m_event->isTouchEvent())
+        return false;
+#endif
+#if ENABLE(FULLSCREEN_API)
+    // Where the path stops depends on the full screen element too.
+    if (document->webkitIsFullScreen())
+        return false;
+#endif
+    // Distribution can change without the tree version changing.
+    for (size_t i = 0; i < m_eventPath.size(); ++i) {
+        if (m_eventPath[i]->node()->isInsertionPoint())
+            return false;
+    }
+    return true;
+}
+
+void EventDispatcher::storeEventPathInCache()
+{
+    if (m_skipsEventListeners || m_eventPath.isEmpty())
+        return;
+    Document* document = m_node->document();
+    if (document->domTreeVersion() != m_eventPathTreeVersion || !eventPathIsCacheable())
+        return;
+
+    // Related targets are set per event, and the cache should not keep them alive.
+    for (size_t i = 0; i < m_eventPath.size(); ++i) {
+        if (m_eventPath[i]->isMouseOrFocusEventContext())
+            static_cast<MouseOrFocusEventContext*>(m_eventPath[i].get())->setRelatedTarget(0);
+    }
+
+    OwnPtr<CachedEventPath> cachedEventPath = adoptPtr(new CachedEventPath(m_node, m_event->type(), m_event->isMouseEvent() || m_event->isFocusEvent(), m_eventPathTreeVersion));
+    cachedEventPath->m_eventPath.swap(m_eventPath);
+    document->setCachedEventPath(cachedEventPath.release());
 }
 
 void EventDispatcher::dispatchScopedEvent(Node* node, PassRefPtr<EventDispatchMediator> mediator)
@@ -110,6 +220,9 @@ bool EventDispatcher::dispatch()
     m_event->setTarget(EventRetargeter::eventTargetRespectingTargetRules(m_node.get()));
     ASSERT(!NoEventDispatchAssertion::isEventDispatchForbidden());
     ASSERT(m_event->target());
+    if (m_skipsEventListeners)
+        return dispatchToDefaultEventHandlers();
+
     WindowEventContext windowEventContext(m_event.get(), m_node.get(), topEventContext());
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willDispatchEvent(m_node->document(), *m_event, windowEventContext.window(), m_node.get(), m_eventPath);
 
@@ -129,6 +242,14 @@ bool EventDispatcher::dispatch()
     return !m_event->defaultPrevented();
 }
 
+bool EventDispatcher::dispatchToDefaultEventHandlers()
+{
+    void* preDispatchEventHandlerResult;
+    dispatchEventPreProcess(preDispatchEventHandlerResult);
+    dispatchEventPostProcess(preDispatchEventHandlerResult);
+    return !m_event->defaultPrevented();
+}
+
 inline EventDispatchContinuation EventDispatcher::dispatchEventPreProcess(void*& preDispatchEventHandlerResult)
 {
     // Give the target node a chance to do some work before DOM event handlers get a crack.
@@ -199,24 +320,35 @@ inline void EventDispatcher::dispatchEventPostProcess(void* preDispatchEventHand
     // implementation detail and not part of the DOM.
     if (!m_event->defaultPrevented() && !m_event->defaultHandled()) {
         // Non-bubbling events call only one default event handler, the one for the target.
-        m_node->defaultEventHandler(m_event.get());
-        ASSERT(!m_event->defaultPrevented());
-        if (m_event->defaultHandled())
+        if (callDefaultEventHandler(m_node.get()))
             return;
         // For bubbling events, call default event handlers on the same targets in the
         // same order as the bubbling phase.
         if (m_event->bubbles()) {
+            if (m_skipsEventListeners) {
+                size_t size = m_nodesForDefaultEventHandlers.size();
+                for (size_t i = 1; i < size; ++i) {
+                    if (callDefaultEventHandler(m_nodesForDefaultEventHandlers[i].get()))
+                        return;
+                }
+                return;
+            }
             size_t size = m_eventPath.size();
             for (size_t i = 1; i < size; ++i) {
-                m_eventPath[i]->node()->defaultEventHandler(m_event.get());
-                ASSERT(!m_event->defaultPrevented());
-                if (m_event->defaultHandled())
+                if (callDefaultEventHandler(m_eventPath[i]->node()))
                     return;
             }
         }
     }
 }
 
+inline bool EventDispatcher::callDefaultEventHandler(Node* node)
+{
+    node->defaultEventHandler(m_event.get());
+    ASSERT(!m_event->defaultPrevented());
+    return m_event->defaultHandled();
+}
+
 const EventContext* EventDispatcher::topEventContext()
 {
     return m_eventPath.isEmpty() ? 0 : m_eventPath.last().get();
@@ -32,6 +32,7 @@
 #include <wtf/HashMap.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/Vector.h>
+#include <wtf/text/AtomicString.h>
 
 namespace WebCore {
 
@@ -51,6 +52,27 @@ enum EventDispatchContinuation {
     DoneDispatching
 };
 
+// The event path of the last event a document dispatched, kept so that a stream of events of
+// one type at one target (mousemove, mostly) does not rebuild it while the tree is unchanged.
+class CachedEventPath {
+    WTF_MAKE_NONCOPYABLE(CachedEventPath); WTF_MAKE_FAST_ALLOCATED;
+public:
+    CachedEventPath(PassRefPtr<Node> node, const AtomicString& eventType, bool isMouseOrFocusEvent, uint64_t domTreeVersion)
+        : m_node(node)
+        , m_eventType(eventType)
+        , m_isMouseOrFocusEvent(isMouseOrFocusEvent)
+        , m_domTreeVersion(domTreeVersion)
+    {
+    }
+
+    RefPtr<Node> m_node;
+    AtomicString m_eventType;
+    // Decides the kind of EventContext in the path.
+    bool m_isMouseOrFocusEvent;
+    uint64_t m_domTreeVersion;
+    EventPath m_eventPath;
+};
+
 class EventDispatcher {
 public:
     static bool dispatchEvent(Node*, PassRefPtr<EventDispatchMediator>);
@@ -65,8 +87,17 @@ public:
 
 private:
     EventDispatcher(Node*, PassRefPtr<Event>);
+    ~EventDispatcher();
     const EventContext* topEventContext();
 
+    bool collectNodesForDefaultEventHandlers();
+    bool takeCachedEventPath();
+    bool eventPathIsCacheable() const;
+    void storeEventPathInCache();
+
+    bool dispatchToDefaultEventHandlers();
+    bool callDefaultEventHandler(Node*);
+
     EventDispatchContinuation dispatchEventPreProcess(void*& preDispatchEventHandlerResult);
     EventDispatchContinuation dispatchEventAtCapturing(WindowEventContext&);
     EventDispatchContinuation dispatchEventAtTarget();
@@ -74,6 +105,10 @@ private:
     void dispatchEventPostProcess(void* preDispatchEventHandlerResult);
 
     EventPath m_eventPath;
+    // Set instead of m_eventPath when nothing listens for the event, see collectNodesForDefaultEventHandlers().
+    Vector<RefPtr<Node>, 32> m_nodesForDefaultEventHandlers;
+    bool m_skipsEventListeners;
+    uint64_t m_eventPathTreeVersion;
     RefPtr<Node> m_node;
     RefPtr<Event> m_event;
     RefPtr<FrameView> m_view;
@@ -148,6 +148,13 @@ namespace WebCore {
 
 using namespace HTMLNames;
 
+struct SameSizeAsNode : public EventTarget, public ScriptWrappable, public TreeShared<Node> {
+    uint32_t m_nodeFlags;
+    void* m_pointer[5];
+};
+
+COMPILE_ASSERT(sizeof(Node) == sizeof(SameSizeAsNode), Node_should_stay_small);
+
 bool Node::isSupported(const String& feature, const String& version)
 {
     return DOMImplementation::hasFeature(feature, version);
@@ -184,6 +191,9 @@ void Node::dumpStatistics()
     size_t elementsWithAttributeStorage = 0;
     size_t elementsWithRareData = 0;
     size_t elementsWithNamedNodeMap = 0;
+    size_t elementsWithUniqueElementData = 0;
+    size_t elementDataBytes = 0;
+    HashSet<const ElementData*> distinctElementData;
 
     for (HashSet<Node*>::iterator it = liveNodeSet.begin(); it != liveNodeSet.end(); ++it) {
         Node* node = *it;
@@ -207,14 +217,22 @@ void Node::dumpStatistics()
                 if (!result.isNewEntry)
                     result.iterator->value++;
 
-                if (ElementData* elementData = element->elementData()) {
+                if (const ElementData* elementData = element->elementData()) {
                     attributes += elementData->length();
                     ++elementsWithAttributeStorage;
                     for (unsigned i = 0; i < elementData->length(); ++i) {
-                        Attribute* attr = elementData->attributeItem(i);
+                        const Attribute* attr = elementData->attributeItem(i);
                         if (attr->attr())
                             ++attributesWithAttr;
                     }
+                    if (elementData->isUnique())
+                        ++elementsWithUniqueElementData;
+                    if (distinctElementData.add(elementData).isNewEntry) {
+                        if (elementData->isUnique())
+                            elementDataBytes += sizeof(UniqueElementData) + sizeof(Attribute) * max<int>(0, static_cast<int>(elementData->length()) - 4);
+                        else
+                            elementDataBytes += sizeof(ShareableElementData) + sizeof(Attribute) * elementData->length();
+                    }
                 }
                 break;
             }
@@ -301,6 +319,17 @@ void Node::dumpStatistics()
     printf("  Number of Elements with attribute storage: %zu [%zu]\n", elementsWithAttributeStorage, sizeof(ElementData));
     printf("  Number of Elements with RareData: %zu\n", elementsWithRareData);
     printf("  Number of Elements with NamedNodeMap: %zu [%zu]\n", elementsWithNamedNodeMap, sizeof(NamedNodeMap));
+    printf("  Number of Elements with UniqueElementData: %zu [%zu]\n", elementsWithUniqueElementData, sizeof(UniqueElementData));
+    printf("  Number of distinct ElementData: %u [%zu bytes total]\n", static_cast<unsigned>(distinctElementData.size()), elementDataBytes);
+
+    printf("Footprint:\n");
+    printf("  sizeof(Node): %zu, sizeof(ContainerNode): %zu, sizeof(Element): %zu, sizeof(Text): %zu\n", sizeof(Node), sizeof(ContainerNode), sizeof(Element), sizeof(Text));
+    if (elementNodes)
+        printf("  ElementData bytes per Element: %.1f\n", static_cast<double>(elementDataBytes) / elementNodes);
+
+    printf("Allocation:\n");
+    printf("  Number of Nodes allocated from a NodeArena: %zu\n", NodeArena::arenaAllocationCount());
+    printf("  Number of Nodes allocated with malloc: %zu\n", NodeArena::mallocAllocationCount());
 #endif
 }
 
@@ -341,8 +370,13 @@ Node::StyleChange Node::diff(const RenderStyle* s1, const RenderStyle* s2, Docum
     bool specifiesColumns1 = s1 && (!s1->hasAutoColumnCount() || !s1->hasAutoColumnWidth());
     bool specifiesColumns2 = s2 && (!s2->hasAutoColumnCount() || !s2->hasAutoColumnWidth());
 
+    // Whether children get renderers at all depends on content-visibility, see Element::attach.
+    ContentVisibility contentVisibility1 = s1 ? s1->contentVisibility() : ContentVisibilityVisible;
+    ContentVisibility contentVisibility2 = s2 ? s2->contentVisibility() : ContentVisibilityVisible;
+
     if (display1 != display2 || fl1 != fl2 || colSpan1 != colSpan2 
         || (specifiesColumns1 != specifiesColumns2 && doc->settings()->regionBasedColumnsEnabled())
+        || (contentVisibility1 != contentVisibility2 && doc->settings()->lazyOffscreenRenderingEnabled())
         || (s1 && s2 && !s1->contentDataEquivalent(s2)))
         ch = Detach;
     else if (!s1 || !s2)
@@ -30,6 +30,7 @@
 #include "KURLHash.h"
 #include "LayoutRect.h"
 #include "MutationObserver.h"
+#include "NodeArena.h"
 #include "RenderStyleConstants.h"
 #include "ScriptWrappable.h"
 #include "SimulatedClickOptions.h"
@@ -179,6 +180,11 @@ public:
     virtual ~Node();
     void willBeDeletedFrom(Document*);
 
+    // Nodes created inside a NodeArena::AllocationScope live in that arena. The sized
+    // delete gets the dynamic size through the virtual destructor.
+    void* operator new(size_t size) { return NodeArena::allocateNode(size); }
+    void operator delete(void* p, size_t size) { NodeArena::deallocateNode(p, size); }
+
     // DOM methods & attributes for Node
 
     bool hasTagName(const QualifiedName&) const;
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "NodeArena.h"
+
+#include <limits>
+#include <string.h>
+#include <wtf/Assertions.h>
+#include <wtf/CryptographicallyRandomNumber.h>
+#include <wtf/MainThread.h>
+#include <wtf/PageReservation.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// Every region starts with this header, followed by the nodes.
+struct NodeArena::Region {
+    NodeArena* arena;
+    Region* previous;
+    Region* next;
+    char* bumpPointer;
+    char* bumpEnd;
+    size_t liveNodeCount;
+    void* freeLists[freeListCount];
+};
+
+NodeArena* NodeArena::s_currentArena = 0;
+size_t NodeArena::s_arenaAllocationCount = 0;
+size_t NodeArena::s_mallocAllocationCount = 0;
+uintptr_t NodeArena::s_reservationBase = 0;
+uintptr_t NodeArena::s_reservationSize = 0;
+
+// Address space only; regions are committed as arenas need them. Once it is used up, nodes
+// simply go to malloc.
+static const size_t reservationSize = sizeof(void*) > 4 ? 256 * 1024 * 1024 : 32 * 1024 * 1024;
+
+static size_t usedRegionSlots;
+static Vector<char*>* freeRegionSlots;
+
+static inline size_t roundUpToGranularity(size_t size, size_t shift)
+{
+    return ((size + (1 << shift) - 1) >> shift) << shift;
+}
+
+static inline void* maskPtr(void* p, uintptr_t mask)
+{
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(p) ^ mask);
+}
+
+static PageReservation& regionReservation()
+{
+    static PageReservation* reservation;
+    if (!reservation) {
+        // Over-reserve by a region so the first one can be aligned; regionFor() relies on it.
+        reservation = new PageReservation(PageReservation::reserve(reservationSize + NodeArena::regionSize, OSAllocator::FastMallocPages));
+        freeRegionSlots = new Vector<char*>;
+    }
+    return *reservation;
+}
+
+static inline char* firstRegionSlot(const PageReservation& reservation)
+{
+    uintptr_t base = reinterpret_cast<uintptr_t>(reservation.base());
+    return reinterpret_cast<char*>((base + NodeArena::regionSize - 1) & ~static_cast<uintptr_t>(NodeArena::regionSize - 1));
+}
+
+NodeArena::AllocationScope::AllocationScope(NodeArena* arena)
+    : m_previousArena(s_currentArena)
+{
+    ASSERT(isMainThread());
+    s_currentArena = arena;
+}
+
+NodeArena::AllocationScope::~AllocationScope()
+{
+    s_currentArena = m_previousArena;
+}
+
+NodeArena::NodeArena()
+    : m_currentRegion(0)
+    , m_regions(0)
+    , m_liveNodeCount(0)
+    , m_regionCount(0)
+    , m_totalSize(0)
+{
+    // See RenderArena: the first word of a freed node overlaps its vtable pointer, and
+    // the mask makes sure a stale node crashes on its first virtual call.
+    WTF::cryptographicallyRandomValues(&m_mask, sizeof(m_mask));
+    m_mask |= (static_cast<uintptr_t>(3) << (std::numeric_limits<uintptr_t>::digits - 2)) | 1;
+
+    PageReservation& reservation = regionReservation();
+    if (reservation && !s_reservationBase) {
+        s_reservationBase = reinterpret_cast<uintptr_t>(firstRegionSlot(reservation));
+        s_reservationSize = reservationSize;
+    }
+}
+
+NodeArena::~NodeArena()
+{
+    ASSERT(!m_liveNodeCount);
+    ASSERT(s_currentArena != this);
+
+    // Only the current region can be left, since the others go away with their last node.
+    while (m_regions)
+        removeRegion(m_regions);
+}
+
+void* NodeArena::allocateNode(size_t size)
+{
+#ifndef ADDRESS_SANITIZER
+    if (s_currentArena && size <= maxNodeSize) {
+        if (void* result = s_currentArena->allocate(size)) {
+            ++s_arenaAllocationCount;
+            return result;
+        }
+    }
+#endif
+    ++s_mallocAllocationCount;
+    return ::operator new(size);
+}
+
+void NodeArena::deallocateArenaNode(void* p, size_t size)
+{
+    Region* region = reinterpret_cast<Region*>(reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(regionSize - 1));
+    region->arena->free(region, p, size);
+}
+
+void* NodeArena::allocate(size_t size)
+{
+    ASSERT(size && size <= maxNodeSize);
+    size = roundUpToGranularity(size, granularityShift);
+    const size_t index = size >> granularityShift;
+
+    Region* region = m_currentRegion;
+    void* result = 0;
+    if (region) {
+        if ((result = region->freeLists[index]))
+            region->freeLists[index] = maskPtr(*static_cast<void**>(result), m_mask);
+        else if (static_cast<size_t>(region->bumpEnd - region->bumpPointer) >= size) {
+            result = region->bumpPointer;
+            region->bumpPointer += size;
+        }
+    }
+    if (!result) {
+        // Whatever is left in the previous region is only reused once nodes there die.
+        if (!(region = addRegion()))
+            return 0;
+        result = region->bumpPointer;
+        region->bumpPointer += size;
+    }
+
+    ++region->liveNodeCount;
+    ++m_liveNodeCount;
+    m_totalSize += size;
+    // Dropped in free(), so the arena stays around for as long as any of its nodes lives.
+    ref();
+    return result;
+}
+
+NodeArena::Region* NodeArena::addRegion()
+{
+    PageReservation& reservation = regionReservation();
+    if (!reservation)
+        return 0;
+
+    char* slot;
+    if (!freeRegionSlots->isEmpty()) {
+        slot = freeRegionSlots->last();
+        freeRegionSlots->removeLast();
+    } else {
+        if (usedRegionSlots == reservationSize / regionSize)
+            return 0;
+        slot = firstRegionSlot(reservation) + usedRegionSlots++ * regionSize;
+    }
+    reservation.commit(slot, regionSize);
+
+    Region* region = reinterpret_cast<Region*>(slot);
+    memset(region, 0, sizeof(Region));
+    region->arena = this;
+    region->bumpPointer = slot + roundUpToGranularity(sizeof(Region), granularityShift);
+    region->bumpEnd = slot + regionSize;
+
+    region->next = m_regions;
+    if (m_regions)
+        m_regions->previous = region;
+    m_regions = region;
+    m_currentRegion = region;
+    ++m_regionCount;
+    return region;
+}
+
+void NodeArena::removeRegion(Region* region)
+{
+    ASSERT(!region->liveNodeCount);
+
+    if (region->previous)
+        region->previous->next = region->next;
+    else
+        m_regions = region->next;
+    if (region->next)
+        region->next->previous = region->previous;
+    if (m_currentRegion == region)
+        m_currentRegion = 0;
+    --m_regionCount;
+
+    char* slot = reinterpret_cast<char*>(region);
+    regionReservation().decommit(slot, regionSize);
+    freeRegionSlots->append(slot);
+}
+
+void NodeArena::free(Region* region, void* p, size_t size)
+{
+    ASSERT(region->arena == this);
+    ASSERT(region->liveNodeCount);
+    ASSERT(size && size <= maxNodeSize);
+    size = roundUpToGranularity(size, granularityShift);
+
+#ifndef NDEBUG
+    memset(p, 0xdb, size);
+#endif
+
+    --m_liveNodeCount;
+    m_totalSize -= size;
+
+    if (--region->liveNodeCount) {
+        const size_t index = size >> granularityShift;
+        *static_cast<void**>(p) = maskPtr(region->freeLists[index], m_mask);
+        region->freeLists[index] = p;
+    } else if (region == m_currentRegion) {
+        // Start over instead of handing back the region we are about to allocate from.
+        memset(region->freeLists, 0, sizeof(region->freeLists));
+        region->bumpPointer = reinterpret_cast<char*>(region) + roundUpToGranularity(sizeof(Region), granularityShift);
+    } else
+        removeRegion(region);
+
+    deref();
+}
+
+} // namespace WebCore
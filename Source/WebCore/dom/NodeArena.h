@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NodeArena_h
+#define NodeArena_h
+
+#include <stdint.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+
+namespace WebCore {
+
+// Backing store for the nodes the parser creates. Instead of going to malloc once per
+// Text or Element, nodes are bump allocated out of 64KB regions owned by the document,
+// and freed nodes are kept on size-classed free lists for the next node of that size.
+// Every node carved out of the arena holds a reference to it, so nodes that outlive their
+// document (or get adopted into another one) can still hand their memory back. A region
+// is returned to the system as soon as the last node in it dies.
+//
+// All regions come from one address range reserved up front, so telling an arena node
+// from a malloc'd one on delete is a range check.
+class NodeArena : public RefCounted<NodeArena> {
+public:
+    static PassRefPtr<NodeArena> create() { return adoptRef(new NodeArena); }
+    ~NodeArena();
+
+    // While an AllocationScope is alive, Node::operator new allocates from its arena.
+    class AllocationScope {
+        WTF_MAKE_NONCOPYABLE(AllocationScope);
+    public:
+        explicit AllocationScope(NodeArena*);
+        ~AllocationScope();
+
+    private:
+        NodeArena* m_previousArena;
+    };
+
+    // Used by Node::operator new and Node::operator delete.
+    static void* allocateNode(size_t);
+    static void deallocateNode(void* p, size_t size)
+    {
+        if (reinterpret_cast<uintptr_t>(p) - s_reservationBase < s_reservationSize)
+            deallocateArenaNode(p, size);
+        else
+            ::operator delete(p);
+    }
+
+    size_t liveNodeCount() const { return m_liveNodeCount; }
+    size_t regionCount() const { return m_regionCount; }
+    size_t totalNodeArenaSize() const { return m_totalSize; }
+    size_t totalNodeArenaAllocatedBytes() const { return m_regionCount * regionSize; }
+
+    // Process-wide counts of node allocations served by an arena and by malloc.
+    static size_t arenaAllocationCount() { return s_arenaAllocationCount; }
+    static size_t mallocAllocationCount() { return s_mallocAllocationCount; }
+
+    static const size_t regionSize = 64 * 1024;
+
+private:
+    NodeArena();
+
+    struct Region;
+
+    void* allocate(size_t);
+    void free(Region*, void*, size_t);
+    Region* addRegion();
+    void removeRegion(Region*);
+
+    static void deallocateArenaNode(void*, size_t);
+
+    static NodeArena* s_currentArena;
+    static size_t s_arenaAllocationCount;
+    static size_t s_mallocAllocationCount;
+
+    // The reserved address range all regions are committed from.
+    static uintptr_t s_reservationBase;
+    static uintptr_t s_reservationSize;
+
+    // Nodes are rounded up to multiples of 16 bytes; anything bigger than the largest
+    // class goes to malloc.
+    static const size_t granularityShift = 4;
+    static const size_t maxNodeSize = 512;
+    static const size_t freeListCount = (maxNodeSize >> granularityShift) + 1;
+
+    // New nodes only come from the current region. The others are kept until they empty.
+    Region* m_currentRegion;
+    Region* m_regions;
+
+    // The mask used to secure the free list pointers, as in RenderArena.
+    uintptr_t m_mask;
+
+    size_t m_liveNodeCount;
+    size_t m_regionCount;
+    size_t m_totalSize;
+};
+
+} // namespace WebCore
+
+#endif // NodeArena_h
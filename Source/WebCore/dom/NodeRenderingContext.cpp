@@ -191,6 +191,8 @@ bool NodeRenderingContext::shouldCreateRenderer() const
         return false;
     if (!parentRenderer->canHaveChildren() && !(m_node->isPseudoElement() && parentRenderer->canHaveGeneratedChildren()))
         return false;
+    if (m_renderingParent->isElementNode() && toElement(m_renderingParent)->childRenderersDeferred())
+        return false;
     if (!m_renderingParent->childShouldCreateRenderer(*this))
         return false;
     return true;
@@ -479,6 +479,7 @@ int Position::renderedOffset() const
                     
     int result = 0;
     RenderText* textRenderer = toRenderText(deprecatedNode()->renderer());
+    textRenderer->ensureLineBoxes();
     for (InlineTextBox *box = textRenderer->firstTextBox(); box; box = box->nextTextBox()) {
         int start = box->start();
         int end = box->start() + box->len();
@@ -658,6 +659,8 @@ Position Position::upstream(EditingBoundaryCrossingRule rule) const
         }
 
         // return current position if it is in rendered text
+        if (renderer->isText())
+            toRenderText(renderer)->ensureLineBoxes();
         if (renderer->isText() && toRenderText(renderer)->firstTextBox()) {
             if (currentNode != startNode) {
                 // This assertion fires in layout tests in the case-transform.html test because
@@ -786,6 +789,8 @@ Position Position::downstream(EditingBoundaryCrossingRule rule) const
         }
 
         // return current position if it is in rendered text
+        if (renderer->isText())
+            toRenderText(renderer)->ensureLineBoxes();
         if (renderer->isText() && toRenderText(renderer)->firstTextBox()) {
             if (currentNode != startNode) {
                 ASSERT(currentPos.atStartOfNode());
@@ -947,6 +952,7 @@ bool Position::inRenderedText() const
         return false;
     
     RenderText *textRenderer = toRenderText(renderer);
+    textRenderer->ensureLineBoxes();
     for (InlineTextBox *box = textRenderer->firstTextBox(); box; box = box->nextTextBox()) {
         if (m_offset < static_cast<int>(box->start()) && !textRenderer->containsReversedText()) {
             // The offset we're looking for is before this node
@@ -972,6 +978,7 @@ bool Position::isRenderedCharacter() const
         return false;
     
     RenderText* textRenderer = toRenderText(renderer);
+    textRenderer->ensureLineBoxes();
     for (InlineTextBox* box = textRenderer->firstTextBox(); box; box = box->nextTextBox()) {
         if (m_offset < static_cast<int>(box->start()) && !textRenderer->containsReversedText()) {
             // The offset we're looking for is before this node
@@ -1144,6 +1151,7 @@ static InlineTextBox* searchAheadForBetterMatch(RenderObject* renderer)
         if (next->isText()) {
             InlineTextBox* match = 0;
             int minOffset = INT_MAX;
+            toRenderText(next)->ensureLineBoxes();
             for (InlineTextBox* box = toRenderText(next)->firstTextBox(); box; box = box->nextTextBox()) {
                 int caretMinOffset = box->caretMinOffset();
                 if (caretMinOffset < minOffset) {
@@ -1206,6 +1214,7 @@ void Position::getInlineBoxAndOffset(EAffinity affinity, TextDirection primaryDi
         }
     } else {
         RenderText* textRenderer = toRenderText(renderer);
+        textRenderer->ensureLineBoxes();
 
         InlineTextBox* box;
         InlineTextBox* candidate = 0;
@@ -33,6 +33,10 @@ class CSSStyleSheet;
 
 class ProcessingInstruction FINAL : public Node, private CachedStyleSheetClient {
 public:
+    // CachedResourceClient is fast allocated too; nodes must go through Node's allocator.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<ProcessingInstruction> create(Document*, const String& target, const String& data);
     virtual ~ProcessingInstruction();
 
@@ -26,17 +26,28 @@
 #include "config.h"
 #include "SelectorQuery.h"
 
+#include "AncestorIdentifierFilter.h"
 #include "CSSParser.h"
 #include "CSSSelectorList.h"
 #include "Document.h"
+#include "HTMLNames.h"
 #include "NodeTraversal.h"
 #include "SelectorChecker.h"
 #include "SelectorCheckerFastPath.h"
+#include "SelectorFilter.h"
 #include "StaticNodeList.h"
 #include "StyledElement.h"
+#include "TreeScope.h"
 
 namespace WebCore {
 
+SelectorDataList::SelectorData::SelectorData(const CSSSelector* selector, bool isFastCheckable)
+    : selector(selector)
+    , isFastCheckable(isFastCheckable)
+{
+    SelectorFilter::collectIdentifierHashes(selector, ancestorIdentifierHashes, maximumIdentifierCount);
+}
+
 void SelectorDataList::initialize(const CSSSelectorList& selectorList)
 {
     ASSERT(m_selectors.isEmpty());
@@ -71,9 +82,25 @@ bool SelectorDataList::matches(Element* targetElement) const
 {
     ASSERT(targetElement);
 
+    Element* parent = targetElement->parentOrShadowHostElement();
+    const AncestorIdentifierFilter* ancestorFilter = 0;
+    bool lookedUpAncestorFilter = false;
     unsigned selectorCount = m_selectors.size();
     for (unsigned i = 0; i < selectorCount; ++i) {
-        if (selectorMatches(m_selectors[i], targetElement, targetElement))
+        const SelectorData& selectorData = m_selectors[i];
+        if (selectorData.hasAncestorIdentifiers()) {
+            if (!parent)
+                continue;
+            // The filter is the parent's, so repeated calls for the element or its siblings share it.
+            if (!lookedUpAncestorFilter) {
+                Document* document = parent->document();
+                ancestorFilter = document->ancestorIdentifierFilterCache()->filterFor(parent, document->domTreeVersion());
+                lookedUpAncestorFilter = true;
+            }
+            if (ancestorFilter && ancestorFilter->fastRejectSelector<SelectorData::maximumIdentifierCount>(selectorData.ancestorIdentifierHashes))
+                continue;
+        }
+        if (selectorMatches(selectorData, targetElement, targetElement))
             return true;
     }
 
@@ -87,6 +114,74 @@ PassRefPtr<NodeList> SelectorDataList::queryAll(Node* rootNode) const
     return StaticNodeList::adopt(result);
 }
 
+void SelectorDataList::collectAll(Node* rootNode, Vector<RefPtr<Node> >& result) const
+{
+    execute<false>(rootNode, result);
+}
+
+static bool selectorDependsOnlyOnTreeAndAttributes(const CSSSelector* selector)
+{
+    for (; selector; selector = selector->tagHistory()) {
+        switch (selector->m_match) {
+        case CSSSelector::Tag:
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+            break;
+        case CSSSelector::Exact:
+        case CSSSelector::Set:
+        case CSSSelector::List:
+        case CSSSelector::Hyphen:
+        case CSSSelector::Contain:
+        case CSSSelector::Begin:
+        case CSSSelector::End:
+            // The style attribute is synchronized lazily after inline style changes, without a DOM tree version bump.
+            if (selector->attribute().localName() == HTMLNames::styleAttr.localName())
+                return false;
+            break;
+        case CSSSelector::PseudoClass:
+            switch (selector->pseudoType()) {
+            case CSSSelector::PseudoEmpty:
+            case CSSSelector::PseudoFirstChild:
+            case CSSSelector::PseudoFirstOfType:
+            case CSSSelector::PseudoLastChild:
+            case CSSSelector::PseudoLastOfType:
+            case CSSSelector::PseudoOnlyChild:
+            case CSSSelector::PseudoOnlyOfType:
+            case CSSSelector::PseudoNthChild:
+            case CSSSelector::PseudoNthOfType:
+            case CSSSelector::PseudoNthLastChild:
+            case CSSSelector::PseudoNthLastOfType:
+            case CSSSelector::PseudoRoot:
+                break;
+            case CSSSelector::PseudoNot:
+                if (const CSSSelectorList* selectorList = selector->selectorList()) {
+                    for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector)) {
+                        if (!selectorDependsOnlyOnTreeAndAttributes(subSelector))
+                            return false;
+                    }
+                }
+                break;
+            default:
+                // Dynamic state such as :hover, :focus or :checked.
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SelectorDataList::dependsOnlyOnTreeAndAttributes() const
+{
+    for (unsigned i = 0; i < m_selectors.size(); ++i) {
+        if (!selectorDependsOnlyOnTreeAndAttributes(m_selectors[i].selector))
+            return false;
+    }
+    return true;
+}
+
 PassRefPtr<Element> SelectorDataList::queryFirst(Node* rootNode) const
 {
     Vector<RefPtr<Node> > result;
@@ -122,6 +217,41 @@ static inline bool isTreeScopeRoot(const Node* node)
     return node->isDocumentNode() || node->isShadowRoot();
 }
 
+// For a selector like "#list .item" only the subtree of the element with that id can contain matches, so
+// there is no need to walk anything else. Returns the root of the subtree to traverse, which is the parent
+// of that element if it sits to the left of a sibling combinator, or 0 if nothing can match.
+static const Node* traversalRootForSelector(const Node* rootNode, const CSSSelector* selector)
+{
+    if (!rootNode->inDocument() || rootNode->document()->inQuirksMode())
+        return rootNode;
+
+    bool isRightmostCompound = true;
+    bool startFromParent = false;
+    for (; selector; selector = selector->tagHistory()) {
+        if (selector->m_match == CSSSelector::Id && !isRightmostCompound) {
+            const AtomicString& id = selector->value();
+            if (rootNode->treeScope()->containsMultipleElementsWithId(id))
+                return rootNode;
+            Element* element = rootNode->treeScope()->getElementById(id);
+            if (!element)
+                return 0;
+            // The element may also be an ancestor of rootNode, in which case everything under rootNode is a candidate.
+            if (!isTreeScopeRoot(rootNode) && !element->isDescendantOf(rootNode))
+                return rootNode;
+            if (startFromParent)
+                return element->parentNode();
+            return element;
+        }
+        if (selector->relation() == CSSSelector::SubSelector)
+            continue;
+        if (selector->relation() == CSSSelector::ShadowDescendant)
+            return rootNode;
+        isRightmostCompound = false;
+        startFromParent = selector->relation() == CSSSelector::DirectAdjacent || selector->relation() == CSSSelector::IndirectAdjacent;
+    }
+    return rootNode;
+}
+
 template <bool firstMatchOnly>
 ALWAYS_INLINE void SelectorDataList::executeFastPathForIdSelector(const Node* rootNode, const SelectorData& selectorData, const CSSSelector* idSelector, Vector<RefPtr<Node> >& matchedElements) const
 {
@@ -150,6 +280,35 @@ ALWAYS_INLINE void SelectorDataList::executeFastPathForIdSelector(const Node* ro
         matchedElements.append(element);
 }
 
+// For document.querySelectorAll() and friends on a whole tree scope, a class or data-* attribute in the
+// rightmost compound lets the TreeScope's index supply the candidates instead of walking every element.
+// Returns false if no index applies; otherwise |candidates| is 0 if no element can match.
+static bool findCandidatesInTreeScopeIndex(const Node* rootNode, const CSSSelector* selector, const Vector<Element*>*& candidates)
+{
+    if (!isTreeScopeRoot(rootNode))
+        return false;
+
+    TreeScope* scope = rootNode->treeScope();
+    if (!scope->canUseElementIndexes())
+        return false;
+    for (; selector; selector = selector->tagHistory()) {
+        if (selector->m_match == CSSSelector::Class) {
+            candidates = scope->getAllElementsByClassName(selector->value());
+            return true;
+        }
+        if (selector->isAttributeSelector()) {
+            const QualifiedName& attribute = selector->attribute();
+            if (TreeScope::isIndexedDataAttribute(attribute) && attribute.localName() == selector->attributeCanonicalLocalName()) {
+                candidates = scope->getAllElementsWithDataAttribute(attribute.localName());
+                return true;
+            }
+        }
+        if (selector->relation() != CSSSelector::SubSelector)
+            break;
+    }
+    return false;
+}
+
 static bool isSingleTagNameSelector(const CSSSelector* selector)
 {
     return selector->isLastInTagHistory() && selector->m_match == CSSSelector::Tag;
@@ -226,6 +385,20 @@ ALWAYS_INLINE void SelectorDataList::executeSingleClassNameSelectorData(const No
     ASSERT(isSingleClassNameSelector(selectorData.selector));
 
     const AtomicString& className = selectorData.selector->value();
+    const Vector<Element*>* candidates;
+    if (findCandidatesInTreeScopeIndex(rootNode, selectorData.selector, candidates)) {
+        if (!candidates || candidates->isEmpty())
+            return;
+        if (firstMatchOnly) {
+            matchedElements.append(candidates->first());
+            return;
+        }
+        matchedElements.reserveCapacity(candidates->size());
+        for (size_t i = 0; i < candidates->size(); ++i)
+            matchedElements.uncheckedAppend(candidates->at(i));
+        return;
+    }
+
     for (Element* element = ElementTraversal::firstWithin(rootNode); element; element = ElementTraversal::next(element, rootNode)) {
         if (element->hasClass() && element->classNames().contains(className)) {
             matchedElements.append(element);
@@ -235,12 +408,69 @@ ALWAYS_INLINE void SelectorDataList::executeSingleClassNameSelectorData(const No
     }
 }
 
+// While walking a subtree in document order, these keep a SelectorFilter holding the ancestors of the
+// current element, the same way style recalc does, so that descendant and child selectors can be
+// rejected without walking up the tree for every element.
+static inline bool pushAncestorsForElement(SelectorFilter& selectorFilter, Element* element)
+{
+    Element* parent = element->parentOrShadowHostElement();
+    while (!selectorFilter.parentStackIsEmpty() && !selectorFilter.parentStackIsConsistent(parent))
+        selectorFilter.popParent();
+    if (!parent)
+        return false;
+    if (selectorFilter.parentStackIsEmpty())
+        selectorFilter.setupParentStack(parent);
+    return true;
+}
+
+static inline void pushElementIfParent(SelectorFilter& selectorFilter, Element* element)
+{
+    if (!element->firstElementChild())
+        return;
+    if (selectorFilter.parentStackIsEmpty())
+        selectorFilter.setupParentStack(element);
+    else
+        selectorFilter.pushParent(element);
+}
+
 template <bool firstMatchOnly>
-ALWAYS_INLINE void SelectorDataList::executeSingleSelectorData(const Node* rootNode, const SelectorData& selectorData, Vector<RefPtr<Node> >& matchedElements) const
+ALWAYS_INLINE void SelectorDataList::executeSingleSelectorData(const Node* rootNode, const Node* traversalRoot, const SelectorData& selectorData, Vector<RefPtr<Node> >& matchedElements) const
 {
     ASSERT(m_selectors.size() == 1);
 
-    for (Element* element = ElementTraversal::firstWithin(rootNode); element; element = ElementTraversal::next(element, rootNode)) {
+    if (!selectorData.hasAncestorIdentifiers()) {
+        for (Element* element = ElementTraversal::firstWithin(traversalRoot); element; element = ElementTraversal::next(element, traversalRoot)) {
+            if (selectorMatches(selectorData, element, rootNode)) {
+                matchedElements.append(element);
+                if (firstMatchOnly)
+                    return;
+            }
+        }
+        return;
+    }
+
+    SelectorFilter selectorFilter;
+    for (Element* element = ElementTraversal::firstWithin(traversalRoot); element; element = ElementTraversal::next(element, traversalRoot)) {
+        if (pushAncestorsForElement(selectorFilter, element)
+            && !selectorFilter.fastRejectSelector<SelectorData::maximumIdentifierCount>(selectorData.ancestorIdentifierHashes)
+            && selectorMatches(selectorData, element, rootNode)) {
+            matchedElements.append(element);
+            if (firstMatchOnly)
+                return;
+        }
+        pushElementIfParent(selectorFilter, element);
+    }
+}
+
+template <bool firstMatchOnly>
+ALWAYS_INLINE void SelectorDataList::executeSingleSelectorDataOnCandidates(const Node* rootNode, const Vector<Element*>* candidates, const SelectorData& selectorData, Vector<RefPtr<Node> >& matchedElements) const
+{
+    ASSERT(m_selectors.size() == 1);
+
+    if (!candidates)
+        return;
+    for (size_t i = 0; i < candidates->size(); ++i) {
+        Element* element = candidates->at(i);
         if (selectorMatches(selectorData, element, rootNode)) {
             matchedElements.append(element);
             if (firstMatchOnly)
@@ -253,15 +483,26 @@ template <bool firstMatchOnly>
 ALWAYS_INLINE void SelectorDataList::executeSingleMultiSelectorData(const Node* rootNode, Vector<RefPtr<Node> >& matchedElements) const
 {
     unsigned selectorCount = m_selectors.size();
+    bool useSelectorFilter = false;
+    for (unsigned i = 0; i < selectorCount; ++i)
+        useSelectorFilter |= m_selectors[i].hasAncestorIdentifiers();
+
+    SelectorFilter selectorFilter;
     for (Element* element = ElementTraversal::firstWithin(rootNode); element; element = ElementTraversal::next(element, rootNode)) {
+        bool hasAncestors = useSelectorFilter && pushAncestorsForElement(selectorFilter, element);
         for (unsigned i = 0; i < selectorCount; ++i) {
-            if (selectorMatches(m_selectors[i], element, rootNode)) {
+            const SelectorData& selectorData = m_selectors[i];
+            if (selectorData.hasAncestorIdentifiers() && (!hasAncestors || selectorFilter.fastRejectSelector<SelectorData::maximumIdentifierCount>(selectorData.ancestorIdentifierHashes)))
+                continue;
+            if (selectorMatches(selectorData, element, rootNode)) {
                 matchedElements.append(element);
                 if (firstMatchOnly)
                     return;
                 break;
             }
         }
+        if (useSelectorFilter)
+            pushElementIfParent(selectorFilter, element);
     }
 }
 
@@ -276,8 +517,13 @@ ALWAYS_INLINE void SelectorDataList::execute(Node* rootNode, Vector<RefPtr<Node>
             executeSingleTagNameSelectorData<firstMatchOnly>(rootNode, selectorData, matchedElements);
         else if (isSingleClassNameSelector(selectorData.selector))
             executeSingleClassNameSelectorData<firstMatchOnly>(rootNode, selectorData, matchedElements);
-        else
-            executeSingleSelectorData<firstMatchOnly>(rootNode, selectorData, matchedElements);
+        else if (const Node* traversalRoot = traversalRootForSelector(rootNode, selectorData.selector)) {
+            const Vector<Element*>* candidates;
+            if (traversalRoot == rootNode && findCandidatesInTreeScopeIndex(rootNode, selectorData.selector, candidates))
+                executeSingleSelectorDataOnCandidates<firstMatchOnly>(rootNode, candidates, selectorData, matchedElements);
+            else
+                executeSingleSelectorData<firstMatchOnly>(rootNode, traversalRoot, selectorData, matchedElements);
+        }
         return;
     }
     executeSingleMultiSelectorData<firstMatchOnly>(rootNode, matchedElements);
@@ -285,8 +531,60 @@ ALWAYS_INLINE void SelectorDataList::execute(Node* rootNode, Vector<RefPtr<Node>
 
 SelectorQuery::SelectorQuery(const CSSSelectorList& selectorList)
     : m_selectorList(selectorList)
+    , m_cachedResultsRootNode(0)
+    , m_cachedResultsDOMTreeVersion(0)
 {
     m_selectors.initialize(m_selectorList);
+    m_canCacheResults = m_selectors.dependsOnlyOnTreeAndAttributes();
+}
+
+bool SelectorQuery::hasCachedResultsFor(Node* rootNode) const
+{
+    return m_cachedResultsRootNode == rootNode && m_cachedResultsDOMTreeVersion == rootNode->document()->domTreeVersion();
+}
+
+void SelectorQuery::clearCachedResultsIfOutdated(Node* rootNode) const
+{
+    // Drop results from an older DOM as soon as we see it changed rather than holding them until the next queryAll().
+    if (!m_cachedResultsRootNode || m_cachedResultsDOMTreeVersion == rootNode->document()->domTreeVersion())
+        return;
+    m_cachedResultsRootNode = 0;
+    m_cachedResultsDOMTreeVersion = 0;
+    m_cachedResults.clear();
+}
+
+PassRefPtr<NodeList> SelectorQuery::queryAll(Node* rootNode) const
+{
+    clearCachedResultsIfOutdated(rootNode);
+
+    // Detached subtrees can be torn down without bumping the DOM tree version, so only cache for connected roots.
+    if (!m_canCacheResults || !rootNode->inDocument())
+        return m_selectors.queryAll(rootNode);
+
+    Vector<RefPtr<Node> > result;
+    if (hasCachedResultsFor(rootNode)) {
+        result.reserveInitialCapacity(m_cachedResults.size());
+        for (size_t i = 0; i < m_cachedResults.size(); ++i)
+            result.uncheckedAppend(m_cachedResults[i]);
+        return StaticNodeList::adopt(result);
+    }
+
+    m_selectors.collectAll(rootNode, result);
+    m_cachedResults.clear();
+    m_cachedResults.reserveCapacity(result.size());
+    for (size_t i = 0; i < result.size(); ++i)
+        m_cachedResults.uncheckedAppend(result[i].get());
+    m_cachedResultsRootNode = rootNode;
+    m_cachedResultsDOMTreeVersion = rootNode->document()->domTreeVersion();
+    return StaticNodeList::adopt(result);
+}
+
+PassRefPtr<Element> SelectorQuery::queryFirst(Node* rootNode) const
+{
+    clearCachedResultsIfOutdated(rootNode);
+    if (m_canCacheResults && rootNode->inDocument() && hasCachedResultsFor(rootNode))
+        return m_cachedResults.isEmpty() ? 0 : toElement(m_cachedResults.first());
+    return m_selectors.queryFirst(rootNode);
 }
 
 SelectorQuery* SelectorQueryCache::add(const AtomicString& selectors, Document* document, ExceptionCode& ec)
@@ -49,12 +49,22 @@ public:
     bool matches(Element*) const;
     PassRefPtr<NodeList> queryAll(Node* rootNode) const;
     PassRefPtr<Element> queryFirst(Node* rootNode) const;
+    void collectAll(Node* rootNode, Vector<RefPtr<Node> >&) const;
+
+    // True if matching only depends on the tree structure and attributes, i.e. on state
+    // that is covered by Document::domTreeVersion().
+    bool dependsOnlyOnTreeAndAttributes() const;
 
 private:
     struct SelectorData {
-        SelectorData(const CSSSelector* selector, bool isFastCheckable) : selector(selector), isFastCheckable(isFastCheckable) { }
+        SelectorData(const CSSSelector*, bool isFastCheckable);
+        bool hasAncestorIdentifiers() const { return ancestorIdentifierHashes[0]; }
+
+        static const unsigned maximumIdentifierCount = 4;
         const CSSSelector* selector;
         bool isFastCheckable;
+        // Identifiers the ancestors of a matching element must have, see SelectorFilter::collectIdentifierHashes().
+        unsigned ancestorIdentifierHashes[maximumIdentifierCount];
     };
 
     bool selectorMatches(const SelectorData&, Element*, const Node*) const;
@@ -64,7 +74,8 @@ private:
     template <bool firstMatchOnly> void executeFastPathForIdSelector(const Node* rootNode, const SelectorData&, const CSSSelector* idSelector, Vector<RefPtr<Node> >&) const;
     template <bool firstMatchOnly> void executeSingleTagNameSelectorData(const Node* rootNode, const SelectorData&, Vector<RefPtr<Node> >&) const;
     template <bool firstMatchOnly> void executeSingleClassNameSelectorData(const Node* rootNode, const SelectorData&, Vector<RefPtr<Node> >&) const;
-    template <bool firstMatchOnly> void executeSingleSelectorData(const Node* rootNode, const SelectorData&, Vector<RefPtr<Node> >&) const;
+    template <bool firstMatchOnly> void executeSingleSelectorData(const Node* rootNode, const Node* traversalRoot, const SelectorData&, Vector<RefPtr<Node> >&) const;
+    template <bool firstMatchOnly> void executeSingleSelectorDataOnCandidates(const Node* rootNode, const Vector<Element*>* candidates, const SelectorData&, Vector<RefPtr<Node> >&) const;
     template <bool firstMatchOnly> void executeSingleMultiSelectorData(const Node* rootNode, Vector<RefPtr<Node> >&) const;
 
     Vector<SelectorData> m_selectors;
@@ -79,8 +90,19 @@ public:
     PassRefPtr<NodeList> queryAll(Node* rootNode) const;
     PassRefPtr<Element> queryFirst(Node* rootNode) const;
 private:
+    bool hasCachedResultsFor(Node* rootNode) const;
+    void clearCachedResultsIfOutdated(Node* rootNode) const;
+
     SelectorDataList m_selectors;
     CSSSelectorList m_selectorList;
+
+    // Results of the last queryAll() call, reused for identical queries as long as the DOM is unchanged.
+    // Nodes leave the document only with a DOM tree version bump, so the pointers are valid while the
+    // version matches and the cache does not keep anything alive.
+    bool m_canCacheResults;
+    mutable Node* m_cachedResultsRootNode;
+    mutable uint64_t m_cachedResultsDOMTreeVersion;
+    mutable Vector<Node*> m_cachedResults;
 };
 
 class SelectorQueryCache {
@@ -98,16 +120,6 @@ inline bool SelectorQuery::matches(Element* element) const
     return m_selectors.matches(element);
 }
 
-inline PassRefPtr<NodeList> SelectorQuery::queryAll(Node* rootNode) const
-{
-    return m_selectors.queryAll(rootNode);
-}
-
-inline PassRefPtr<Element> SelectorQuery::queryFirst(Node* rootNode) const
-{
-    return m_selectors.queryFirst(rootNode);
-}
-
 }
 
 #endif
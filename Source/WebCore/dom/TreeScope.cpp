@@ -56,7 +56,7 @@ namespace WebCore {
 
 struct SameSizeAsTreeScope {
     virtual ~SameSizeAsTreeScope();
-    void* pointers[9];
+    void* pointers[11];
     int ints[1];
 };
 
@@ -116,6 +116,8 @@ void TreeScope::destroyTreeScopeData()
     m_elementsById.clear();
     m_imageMapsByName.clear();
     m_labelsByForAttribute.clear();
+    m_elementsByClassName.clear();
+    m_elementsByDataAttribute.clear();
 }
 
 void TreeScope::clearDocumentScope()
@@ -311,6 +313,119 @@ HTMLLabelElement* TreeScope::labelElementForId(const AtomicString& forAttributeV
     return toHTMLLabelElement(m_labelsByForAttribute->getElementByLabelForAttribute(forAttributeValue.impl(), this));
 }
 
+bool TreeScope::canUseElementIndexes() const
+{
+    return !documentScope()->isNotifyingInsertions();
+}
+
+// Class attributes may name the same class more than once, but each element must be counted only once.
+static inline bool isFirstOccurrenceOfClassName(const SpaceSplitString& classNames, size_t index)
+{
+    for (size_t i = 0; i < index; ++i) {
+        if (classNames[i] == classNames[index])
+            return false;
+    }
+    return true;
+}
+
+void TreeScope::addElementByClassNames(Element* element)
+{
+    ASSERT(m_elementsByClassName);
+    if (!element->hasClass())
+        return;
+    const SpaceSplitString& classNames = element->classNames();
+    for (size_t i = 0; i < classNames.size(); ++i) {
+        if (isFirstOccurrenceOfClassName(classNames, i))
+            m_elementsByClassName->add(classNames[i].impl(), element);
+    }
+}
+
+void TreeScope::removeElementByClassNames(Element* element)
+{
+    ASSERT(m_elementsByClassName);
+    if (!element->hasClass())
+        return;
+    const SpaceSplitString& classNames = element->classNames();
+    for (size_t i = 0; i < classNames.size(); ++i) {
+        if (isFirstOccurrenceOfClassName(classNames, i))
+            m_elementsByClassName->remove(classNames[i].impl(), element);
+    }
+}
+
+const Vector<Element*>* TreeScope::getAllElementsByClassName(const AtomicString& className)
+{
+    if (className.isEmpty())
+        return 0;
+
+    if (!m_elementsByClassName) {
+        // Populate the index on first access. After that, elements keep it up to date as they are
+        // inserted, removed or have their class attribute changed.
+        ASSERT(canUseElementIndexes());
+        m_elementsByClassName = adoptPtr(new ElementIndex);
+        for (Element* element = ElementTraversal::firstWithin(rootNode()); element; element = ElementTraversal::next(element))
+            addElementByClassNames(element);
+    }
+
+    return m_elementsByClassName->get(className.impl());
+}
+
+bool TreeScope::isIndexedDataAttribute(const QualifiedName& name)
+{
+    return name.namespaceURI().isNull() && name.localName().startsWith("data-");
+}
+
+void TreeScope::addElementByDataAttribute(const AtomicString& localName, Element* element)
+{
+    ASSERT(m_elementsByDataAttribute);
+    m_elementsByDataAttribute->add(localName.impl(), element);
+}
+
+void TreeScope::removeElementByDataAttribute(const AtomicString& localName, Element* element)
+{
+    ASSERT(m_elementsByDataAttribute);
+    m_elementsByDataAttribute->remove(localName.impl(), element);
+}
+
+void TreeScope::addElementByDataAttributes(Element* element)
+{
+    const ElementData* elementData = element->elementData();
+    if (!elementData)
+        return;
+    for (unsigned i = 0; i < elementData->length(); ++i) {
+        const QualifiedName& name = elementData->attributeItem(i)->name();
+        if (isIndexedDataAttribute(name))
+            addElementByDataAttribute(name.localName(), element);
+    }
+}
+
+void TreeScope::removeElementByDataAttributes(Element* element)
+{
+    const ElementData* elementData = element->elementData();
+    if (!elementData)
+        return;
+    for (unsigned i = 0; i < elementData->length(); ++i) {
+        const QualifiedName& name = elementData->attributeItem(i)->name();
+        if (isIndexedDataAttribute(name))
+            removeElementByDataAttribute(name.localName(), element);
+    }
+}
+
+const Vector<Element*>* TreeScope::getAllElementsWithDataAttribute(const AtomicString& localName)
+{
+    if (!localName.startsWith("data-"))
+        return 0;
+
+    if (!m_elementsByDataAttribute) {
+        // Populate the index on first access, as for class names above.
+        ASSERT(canUseElementIndexes());
+        m_elementsByDataAttribute = adoptPtr(new ElementIndex);
+        for (Element* element = ElementTraversal::firstWithin(rootNode()); element; element = ElementTraversal::next(element))
+            addElementByDataAttributes(element);
+    }
+
+    return m_elementsByDataAttribute->get(localName.impl());
+}
+
 DOMSelection* TreeScope::getSelection() const
 {
     if (!rootNode()->document()->frame())
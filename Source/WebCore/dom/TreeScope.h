@@ -28,6 +28,7 @@
 #define TreeScope_h
 
 #include "DocumentOrderedMap.h"
+#include "ElementIndex.h"
 #include <wtf/Forward.h>
 #include <wtf/text/AtomicString.h>
 
@@ -42,6 +43,7 @@ class HTMLMapElement;
 class LayoutPoint;
 class IdTargetObserverRegistry;
 class Node;
+class QualifiedName;
 
 // A class which inherits both Node and TreeScope must call clearRareData() in its destructor
 // so that the Node destructor no longer does problematic NodeList cache manipulation in
@@ -84,6 +86,24 @@ public:
     void removeLabel(const AtomicString& forAttributeValue, HTMLLabelElement*);
     HTMLLabelElement* labelElementForId(const AtomicString& forAttributeValue);
 
+    // Indexes of the elements carrying a given class or a given data-* attribute, built on first
+    // use and kept up to date by Element from then on. While insertion notifications are running,
+    // part of the inserted subtree has not been added yet, so callers must fall back to a tree walk
+    // unless canUseElementIndexes() is true.
+    bool canUseElementIndexes() const;
+    bool shouldCacheElementsByClassName() const { return m_elementsByClassName; }
+    void addElementByClassNames(Element*);
+    void removeElementByClassNames(Element*);
+    const Vector<Element*>* getAllElementsByClassName(const AtomicString&);
+
+    static bool isIndexedDataAttribute(const QualifiedName&);
+    bool shouldCacheElementsByDataAttribute() const { return m_elementsByDataAttribute; }
+    void addElementByDataAttribute(const AtomicString& localName, Element*);
+    void removeElementByDataAttribute(const AtomicString& localName, Element*);
+    void addElementByDataAttributes(Element*);
+    void removeElementByDataAttributes(Element*);
+    const Vector<Element*>* getAllElementsWithDataAttribute(const AtomicString& localName);
+
     DOMSelection* getSelection() const;
 
     // Find first anchor with the given name.
@@ -171,6 +191,8 @@ private:
     OwnPtr<DocumentOrderedMap> m_elementsByName;
     OwnPtr<DocumentOrderedMap> m_imageMapsByName;
     OwnPtr<DocumentOrderedMap> m_labelsByForAttribute;
+    OwnPtr<ElementIndex> m_elementsByClassName;
+    OwnPtr<ElementIndex> m_elementsByDataAttribute;
 
     OwnPtr<IdTargetObserverRegistry> m_idTargetObserverRegistry;
 
@@ -2834,6 +2834,9 @@ PassRefPtr<Range> Editor::rangeOfString(const String& target, Range* referenceRa
     if (target.isEmpty())
         return 0;
 
+    // Text under -webkit-content-visibility: auto elements has to be found too.
+    m_frame->document()->realizeDeferredChildRenderersInSubtree(m_frame->document());
+
     // Start from an edge of the reference range, if there's a reference range that's not in shadow content. Which edge
     // is used depends on whether we're searching forward or backward, and whether startInSelection is set.
     RefPtr<Range> searchRange(rangeOfContents(m_frame->document()));
@@ -2927,6 +2930,8 @@ unsigned Editor::countMatchesForText(const String& target, Range* range, FindOpt
     if (!searchRange)
         searchRange = rangeOfContents(m_frame->document());
 
+    searchRange->ownerDocument()->realizeDeferredChildRenderersInSubtree(searchRange->commonAncestorContainer(IGNORE_EXCEPTION));
+
     Node* originalEndContainer = searchRange->endContainer();
     int originalEndOffset = searchRange->endOffset();
 
@@ -378,8 +378,12 @@ inline Element* LiveNodeListBase::traverseLiveNodeListFirstElement(ContainerNode
     ASSERT(type() != ChildNodeListType);
     if (type() == HTMLTagNodeListType)
         return firstMatchingElement(static_cast<const HTMLTagNodeList*>(this), root);
-    if (type() == ClassNodeListType)
-        return firstMatchingElement(static_cast<const ClassNodeList*>(this), root);
+    if (type() == ClassNodeListType) {
+        const ClassNodeList* classNodeList = static_cast<const ClassNodeList*>(this);
+        if (classNodeList->canUseClassIndex(root))
+            return classNodeList->firstElementFromClassIndex(root);
+        return firstMatchingElement(classNodeList, root);
+    }
     return firstMatchingElement(static_cast<const LiveNodeList*>(this), root);
 }
 
@@ -390,8 +394,12 @@ inline Element* LiveNodeListBase::traverseLiveNodeListForwardToOffset(unsigned o
     ASSERT(type() != ChildNodeListType);
     if (type() == HTMLTagNodeListType)
         return traverseMatchingElementsForwardToOffset(static_cast<const HTMLTagNodeList*>(this), offset, currentElement, currentOffset, root);
-    if (type() == ClassNodeListType)
-        return traverseMatchingElementsForwardToOffset(static_cast<const ClassNodeList*>(this), offset, currentElement, currentOffset, root);
+    if (type() == ClassNodeListType) {
+        const ClassNodeList* classNodeList = static_cast<const ClassNodeList*>(this);
+        if (classNodeList->canUseClassIndex(root))
+            return classNodeList->traverseClassIndexForwardToOffset(offset, currentElement, currentOffset, root);
+        return traverseMatchingElementsForwardToOffset(classNodeList, offset, currentElement, currentOffset, root);
+    }
     return traverseMatchingElementsForwardToOffset(static_cast<const LiveNodeList*>(this), offset, currentElement, currentOffset, root);
 }
 
@@ -34,6 +34,10 @@ class HTMLElement;
 
 class HTMLDocument : public Document, public CachedResourceClient {
 public:
+    // CachedResourceClient is fast allocated too; nodes must go through Node's allocator.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<HTMLDocument> create(Frame* frame, const KURL& url)
     {
         return adoptRef(new HTMLDocument(frame, url));
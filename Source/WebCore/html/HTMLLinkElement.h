@@ -44,6 +44,10 @@ typedef EventSender<HTMLLinkElement> LinkEventSender;
 
 class HTMLLinkElement FINAL : public HTMLElement, public CachedStyleSheetClient, public LinkLoaderClient {
 public:
+    // CachedResourceClient is fast allocated too; nodes must go through Node's allocator.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<HTMLLinkElement> create(const QualifiedName&, Document*, bool createdByParser);
     virtual ~HTMLLinkElement();
 
@@ -31,6 +31,10 @@ namespace WebCore {
 
 class HTMLScriptElement FINAL : public HTMLElement, public ScriptElement {
 public:
+    // ScriptElement is fast allocated too; nodes must go through Node's allocator.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<HTMLScriptElement> create(const QualifiedName&, Document*, bool wasInsertedByParser, bool alreadyStarted = false);
 
     String text() const { return scriptContent(); }
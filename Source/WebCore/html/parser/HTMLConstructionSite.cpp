@@ -540,6 +540,11 @@ inline Document* HTMLConstructionSite::ownerDocumentForCurrentNode()
     return currentNode()->document();
 }
 
+NodeArena* HTMLConstructionSite::nodeArena() const
+{
+    return m_document->nodeArena();
+}
+
 PassRefPtr<Element> HTMLConstructionSite::createHTMLElement(AtomicHTMLToken* token)
 {
     QualifiedName tagName(nullAtom, token->name(), xhtmlNamespaceURI);
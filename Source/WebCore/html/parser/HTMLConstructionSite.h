@@ -67,6 +67,7 @@ class AtomicHTMLToken;
 class Document;
 class Element;
 class HTMLFormElement;
+class NodeArena;
 
 class HTMLConstructionSite {
     WTF_MAKE_NONCOPYABLE(HTMLConstructionSite);
@@ -119,6 +120,7 @@ public:
     HTMLStackItem* currentStackItem() const { return m_openElements.topStackItem(); }
     HTMLStackItem* oneBelowTop() const { return m_openElements.oneBelowTop(); }
     Document* ownerDocumentForCurrentNode();
+    NodeArena* nodeArena() const;
     HTMLElementStack* openElements() const { return &m_openElements; }
     HTMLFormattingElementList* activeFormattingElements() const { return &m_activeFormattingElements; }
     bool currentIsRootNode() { return m_openElements.topNode() == m_openElements.rootNode(); }
@@ -249,7 +249,10 @@ void HTMLDocumentParser::resumeParsingAfterYield()
 
 #if ENABLE(THREADED_HTML_PARSER)
     if (m_haveBackgroundParser) {
-        pumpPendingSpeculations();
+        // A script may have blocked parsing since we yielded, in which case
+        // resumeParsingAfterScriptExecution will pick up the speculations.
+        if (!isWaitingForScripts())
+            pumpPendingSpeculations();
         return;
     }
 #endif
@@ -454,9 +457,6 @@ void HTMLDocumentParser::processParsedChunkFromBackgroundParser(PassOwnPtr<Parse
 
 void HTMLDocumentParser::pumpPendingSpeculations()
 {
-    // FIXME: Share this constant with the parser scheduler.
-    const double parserTimeLimit = 0.500;
-
     // ASSERT that this object is both attached to the Document and protected.
     ASSERT(refCount() >= 2);
     // If this assert fails, you need to call validateSpeculations to make sure
@@ -476,7 +476,7 @@ void HTMLDocumentParser::pumpPendingSpeculations()
         if (isWaitingForScripts() || isStopped())
             break;
 
-        if (currentTime() - startTime > parserTimeLimit && !m_speculations.isEmpty()) {
+        if (!m_speculations.isEmpty() && m_parserScheduler->shouldYieldBeforeNextChunk(startTime)) {
             m_parserScheduler->scheduleForResume();
             break;
         }
@@ -130,6 +130,17 @@ void HTMLParserScheduler::checkForYieldBeforeScript(PumpSession& session)
     session.didSeeScript = true;
 }
 
+bool HTMLParserScheduler::shouldYieldBeforeNextChunk(double startTime) const
+{
+    // Like checkForYieldBeforeScript, give a page that has not painted yet the chance to do so
+    // as soon as a layout is pending rather than after a full time slice of tree building.
+    Document* document = m_parser->document();
+    bool needsFirstPaint = document->view() && !document->view()->hasEverPainted();
+    if (needsFirstPaint && document->isLayoutTimerActive())
+        return true;
+    return currentTime() - startTime > m_parserTimeLimit;
+}
+
 void HTMLParserScheduler::scheduleForResume()
 {
     m_continueNextChunkTimer.startOneShot(0);
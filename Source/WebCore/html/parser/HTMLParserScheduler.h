@@ -85,6 +85,8 @@ public:
         ++session.processedTokens;
     }
     void checkForYieldBeforeScript(PumpSession&);
+    // The threaded parser hands the main thread whole chunks of tokens, so it checks between chunks instead.
+    bool shouldYieldBeforeNextChunk(double startTime) const;
 
     void scheduleForResume();
     bool isScheduledForResume() const { return m_isSuspendedWithActiveTimer || m_continueNextChunkTimer.isActive(); }
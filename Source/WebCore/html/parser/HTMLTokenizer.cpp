@@ -40,6 +40,10 @@
 #include <wtf/text/CString.h>
 #include <wtf/unicode/Unicode.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace WTF;
 
 namespace WebCore {
@@ -158,6 +162,96 @@ void HTMLTokenizer::restoreFromCheckpoint(const Checkpoint& checkpoint)
 
 #endif
 
+// The data and quoted attribute value states append everything to the current token except their
+// delimiter, '&' and the characters the InputStreamPreprocessor has to look at ('\n', '\r' and '\0').
+template<typename CharacterType>
+static inline bool isSpecialInOrdinaryCharacterRun(CharacterType character, UChar delimiter)
+{
+    return character == delimiter || character == '&' || character == '\n' || character == '\r' || !character;
+}
+
+static inline unsigned ordinaryCharacterRunLength(const LChar* characters, unsigned length, UChar delimiter)
+{
+    unsigned i = 0;
+#ifdef __SSE2__
+    const __m128i delimiterMask = _mm_set1_epi8(static_cast<char>(delimiter));
+    const __m128i ampersandMask = _mm_set1_epi8('&');
+    const __m128i newlineMask = _mm_set1_epi8('\n');
+    const __m128i carriageReturnMask = _mm_set1_epi8('\r');
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i)) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + i));
+        __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, delimiterMask), _mm_cmpeq_epi8(chunk, ampersandMask)),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, newlineMask), _mm_cmpeq_epi8(chunk, carriageReturnMask)), _mm_cmpeq_epi8(chunk, zero)));
+        if (_mm_movemask_epi8(matches))
+            break;
+    }
+#endif
+    for (; i < length; ++i) {
+        if (isSpecialInOrdinaryCharacterRun(characters[i], delimiter))
+            break;
+    }
+    return i;
+}
+
+static inline unsigned ordinaryCharacterRunLength(const UChar* characters, unsigned length, UChar delimiter)
+{
+    unsigned i = 0;
+#ifdef __SSE2__
+    const __m128i delimiterMask = _mm_set1_epi16(static_cast<short>(delimiter));
+    const __m128i ampersandMask = _mm_set1_epi16('&');
+    const __m128i newlineMask = _mm_set1_epi16('\n');
+    const __m128i carriageReturnMask = _mm_set1_epi16('\r');
+    const __m128i zero = _mm_setzero_si128();
+    const unsigned charactersPerChunk = sizeof(__m128i) / sizeof(UChar);
+    for (; i + charactersPerChunk <= length; i += charactersPerChunk) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + i));
+        __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(chunk, delimiterMask), _mm_cmpeq_epi16(chunk, ampersandMask)),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(chunk, newlineMask), _mm_cmpeq_epi16(chunk, carriageReturnMask)), _mm_cmpeq_epi16(chunk, zero)));
+        if (_mm_movemask_epi8(matches))
+            break;
+    }
+#endif
+    for (; i < length; ++i) {
+        if (isSpecialInOrdinaryCharacterRun(characters[i], delimiter))
+            break;
+    }
+    return i;
+}
+
+// Called after |current|, the character |source| is positioned on, has been appended to the token.
+// Appends the run of ordinary characters following it too, and leaves |source| on the last of them
+// so that the caller's ADVANCE_TO moves past the whole run.
+inline void HTMLTokenizer::appendOrdinaryCharacterRun(SegmentedString& source, UChar current, UChar delimiter, bool toAttributeValue)
+{
+    // Characters rewritten by the InputStreamPreprocessor, and newlines (which need to update the
+    // line number when advanced past), take the regular path.
+    if (current == '\n' || source.currentChar() != current || !source.canScanAhead())
+        return;
+
+    unsigned length;
+    if (source.currentSubstringIs8Bit()) {
+        const LChar* characters = source.scanAheadCharacters8();
+        length = ordinaryCharacterRunLength(characters, source.scanAheadLength(), delimiter);
+        if (!length)
+            return;
+        if (toAttributeValue)
+            m_token->appendToAttributeValue(characters, length);
+        else
+            m_token->appendToCharacter(characters, length);
+    } else {
+        const UChar* characters = source.scanAheadCharacters16();
+        length = ordinaryCharacterRunLength(characters, source.scanAheadLength(), delimiter);
+        if (!length)
+            return;
+        if (toAttributeValue)
+            m_token->appendToAttributeValue(characters, length);
+        else
+            m_token->appendToCharacter(characters, length);
+    }
+    source.advancePastNonNewlines(length);
+}
+
 inline bool HTMLTokenizer::processEntity(SegmentedString& source)
 {
     bool notEnoughCharacters = false;
@@ -247,6 +341,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            appendOrdinaryCharacterRun(source, cc, '<', false);
             HTML_ADVANCE_TO(DataState);
         }
     }
@@ -963,6 +1058,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             HTML_RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            appendOrdinaryCharacterRun(source, cc, '"', true);
             HTML_ADVANCE_TO(AttributeValueDoubleQuotedState);
         }
     }
@@ -981,6 +1077,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             HTML_RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            appendOrdinaryCharacterRun(source, cc, '\'', true);
             HTML_ADVANCE_TO(AttributeValueSingleQuotedState);
         }
     }
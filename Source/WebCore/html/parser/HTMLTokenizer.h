@@ -206,6 +206,8 @@ private:
 
     inline void parseError();
 
+    inline void appendOrdinaryCharacterRun(SegmentedString&, UChar current, UChar delimiter, bool toAttributeValue);
+
     inline void bufferCharacter(UChar character)
     {
         ASSERT(character != kEndOfFileMarker);
@@ -364,10 +364,16 @@ PassRefPtr<Element> HTMLTreeBuilder::takeScriptToProcess(TextPosition& scriptSta
 
 void HTMLTreeBuilder::constructTree(AtomicHTMLToken* token)
 {
-    if (shouldProcessTokenInForeignContent(token))
-        processTokenInForeignContent(token);
-    else
-        processToken(token);
+    {
+        // Most insertions are queued and run below, outside the scope, so nodes created by
+        // script they trigger come from malloc. Anything that does land in the arena is
+        // still freed correctly.
+        NodeArena::AllocationScope allocationScope(m_tree.nodeArena());
+        if (shouldProcessTokenInForeignContent(token))
+            processTokenInForeignContent(token);
+        else
+            processToken(token);
+    }
 
     if (m_parser->tokenizer()) {
         bool inForeignContent = !m_tree.isEmpty()
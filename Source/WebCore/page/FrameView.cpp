@@ -1960,6 +1960,7 @@ void FrameView::maintainScrollPositionAtAnchor(Node* anchorNode)
     // We need to update the layout before scrolling, otherwise we could
     // really mess things up if an anchor scroll comes at a bad moment.
     m_frame->document()->updateStyleIfNeeded();
+    m_frame->document()->realizeDeferredChildRenderersForAncestors(anchorNode);
     // Only do a layout if changes have occurred that make it necessary.
     RenderView* renderView = this->renderView();
     if (renderView && renderView->needsLayout())
@@ -2051,6 +2052,21 @@ void FrameView::scrollPositionChanged()
             renderView->compositor()->frameViewDidScroll();
     }
 #endif
+
+    realizeDeferredChildRenderersNearViewport();
+}
+
+void FrameView::realizeDeferredChildRenderersNearViewport()
+{
+    Document* document = m_frame->document();
+    if (!document || !document->hasElementsWithDeferredChildRenderers() || needsLayout())
+        return;
+
+    // Look a screenful ahead in every direction so content is in place before it scrolls into view.
+    IntRect realizationRect = visibleContentRect();
+    realizationRect.inflateX(realizationRect.width());
+    realizationRect.inflateY(realizationRect.height());
+    document->realizeDeferredChildRenderersIntersecting(realizationRect);
 }
 
 // FIXME: this function is misnamed; its primary purpose is to update RenderLayer positions.
@@ -2851,6 +2867,8 @@ void FrameView::performPostLayoutTasks()
     }
 #endif
 
+    realizeDeferredChildRenderersNearViewport();
+
     scrollToAnchor();
 
     m_actionScheduler->resume();
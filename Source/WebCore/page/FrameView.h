@@ -538,6 +538,7 @@ private:
     void updateWidget(RenderObject*);
     void scrollToAnchor();
     void scrollPositionChanged();
+    void realizeDeferredChildRenderersNearViewport();
 
     bool hasCustomScrollbars() const;
 
@@ -34,10 +34,12 @@
 #include "CSSParser.h"
 #include "CSSPropertyAnimation.h"
 #include "CompositeAnimation.h"
+#include "Chrome.h"
 #include "EventNames.h"
 #include "Frame.h"
 #include "FrameView.h"
 #include "Logging.h"
+#include "Page.h"
 #include "PseudoElement.h"
 #include "RenderView.h"
 #include "TransitionEvent.h"
@@ -59,6 +61,9 @@ AnimationControllerPrivate::AnimationControllerPrivate(Frame* frame)
     , m_animationsWaitingForStartTimeResponse()
     , m_waitingForAsyncStartNotification(false)
     , m_isSuspended(false)
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    , m_hasDisplayID(false)
+#endif
 {
 }
 
@@ -97,7 +102,10 @@ double AnimationControllerPrivate::updateAnimations(SetChanged callSetChanged/*
             double t = compAnim->timeToNextService();
             if (t != -1 && (t < timeToNextService || timeToNextService == -1))
                 timeToNextService = t;
-            if (!timeToNextService) {
+            // Only dirty the renderers that need service themselves. Renderers whose animations
+            // all run on the compositor report a later service time and must not be restyled
+            // just because some other renderer needs sampling on this tick.
+            if (!t) {
                 if (callSetChanged == CallSetChanged) {
                     Node* node = it->key->node();
                     ASSERT(!node || (node->document() && !node->document()->inPageCache()));
@@ -127,6 +135,9 @@ void AnimationControllerPrivate::updateAnimationTimerForRenderer(RenderObject* r
     if (m_animationTimer.isActive() && (m_animationTimer.repeatInterval() || m_animationTimer.nextFireInterval() <= timeToNextService))
         return;
 
+    if (!timeToNextService && scheduleDisplayRefresh())
+        return;
+
     m_animationTimer.startOneShot(timeToNextService);
 }
 
@@ -136,7 +147,15 @@ void AnimationControllerPrivate::updateAnimationTimer(SetChanged callSetChanged/
 
     LOG(Animations, "updateAnimationTimer: timeToNextService is %.2f", timeToNextService);
 
-    // If we want service immediately, we start a repeating timer to reduce the overhead of starting
+    // If we want service immediately, sample on the next display refresh if the platform supports it
+    // so that all software animations are coalesced into a single style update per frame.
+    if (!timeToNextService && scheduleDisplayRefresh()) {
+        if (m_animationTimer.isActive())
+            m_animationTimer.stop();
+        return;
+    }
+
+    // Otherwise we start a repeating timer to reduce the overhead of starting
     if (!timeToNextService) {
         if (!m_animationTimer.isActive() || m_animationTimer.repeatInterval() == 0)
             m_animationTimer.startRepeating(cAnimationTimerDelay);
@@ -228,6 +247,11 @@ void AnimationControllerPrivate::animationFrameCallbackFired()
 #endif
 
 void AnimationControllerPrivate::animationTimerFired(Timer<AnimationControllerPrivate>*)
+{
+    serviceAnimationsAndFireEvents();
+}
+
+void AnimationControllerPrivate::serviceAnimationsAndFireEvents()
 {
     // Make sure animationUpdateTime is updated, so that it is current even if no
     // styleChange has happened (e.g. accelerated animations)
@@ -242,6 +266,38 @@ void AnimationControllerPrivate::animationTimerFired(Timer<AnimationControllerPr
     fireEventsAndUpdateStyle();
 }
 
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+void AnimationControllerPrivate::displayRefreshFired(double)
+{
+    serviceAnimationsAndFireEvents();
+}
+#endif
+
+bool AnimationControllerPrivate::scheduleDisplayRefresh()
+{
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    if (!m_hasDisplayID) {
+        Page* page = m_frame->page();
+        if (!page)
+            return false;
+        windowScreenDidChange(page->chrome().displayID());
+    }
+    return DisplayRefreshMonitorManager::sharedManager()->scheduleAnimation(this);
+#else
+    return false;
+#endif
+}
+
+void AnimationControllerPrivate::windowScreenDidChange(PlatformDisplayID displayID)
+{
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    m_hasDisplayID = true;
+    DisplayRefreshMonitorManager::sharedManager()->windowScreenDidChange(displayID, this);
+#else
+    UNUSED_PARAM(displayID);
+#endif
+}
+
 bool AnimationControllerPrivate::isRunningAnimationOnRenderer(RenderObject* renderer, CSSPropertyID property, bool isRunningNow) const
 {
     const CompositeAnimation* animation = m_compositeAnimations.get(renderer);
@@ -586,6 +642,11 @@ bool AnimationController::isRunningAcceleratedAnimationOnRenderer(RenderObject*
     return m_data->isRunningAcceleratedAnimationOnRenderer(renderer, property, isRunningNow);
 }
 
+void AnimationController::windowScreenDidChange(PlatformDisplayID displayID)
+{
+    m_data->windowScreenDidChange(displayID);
+}
+
 bool AnimationController::isSuspended() const
 {
     return m_data->isSuspended();
@@ -30,6 +30,7 @@
 #define AnimationController_h
 
 #include "CSSPropertyNames.h"
+#include "PlatformScreen.h"
 #include <wtf/Forward.h>
 #include <wtf/OwnPtr.h>
 
@@ -74,6 +75,8 @@ public:
     void resumeAnimationsForDocument(Document*);
     void startAnimationsIfNotSuspended(Document*);
 
+    void windowScreenDidChange(PlatformDisplayID);
+
     void beginAnimationUpdate();
     void endAnimationUpdate();
     
@@ -30,6 +30,7 @@
 #define AnimationControllerPrivate_h
 
 #include "CSSPropertyNames.h"
+#include "PlatformScreen.h"
 #include "Timer.h"
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
@@ -39,6 +40,10 @@
 #include <wtf/text/AtomicString.h>
 #include <wtf/text/WTFString.h>
 
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+#include "DisplayRefreshMonitor.h"
+#endif
+
 namespace WebCore {
 
 class AnimationBase;
@@ -55,7 +60,11 @@ enum SetChanged {
     CallSetChanged = 1
 };
 
-class AnimationControllerPrivate {
+class AnimationControllerPrivate
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    : public DisplayRefreshMonitorClient
+#endif
+{
     WTF_MAKE_NONCOPYABLE(AnimationControllerPrivate); WTF_MAKE_FAST_ALLOCATED;
 public:
     AnimationControllerPrivate(Frame*);
@@ -109,9 +118,18 @@ public:
     void animationWillBeRemoved(AnimationBase*);
 
     void updateAnimationTimerForRenderer(RenderObject*);
-    
+
+    void windowScreenDidChange(PlatformDisplayID);
+
 private:
     void animationTimerFired(Timer<AnimationControllerPrivate>*);
+    void serviceAnimationsAndFireEvents();
+
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    // Override for DisplayRefreshMonitorClient
+    virtual void displayRefreshFired(double timestamp) OVERRIDE;
+#endif
+    bool scheduleDisplayRefresh();
 
     void styleAvailable();
     void fireEventsAndUpdateStyle();
@@ -142,6 +160,9 @@ private:
     WaitingAnimationsSet m_animationsWaitingForStartTimeResponse;
     bool m_waitingForAsyncStartNotification;
     bool m_isSuspended;
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    bool m_hasDisplayID;
+#endif
 };
 
 } // namespace WebCore
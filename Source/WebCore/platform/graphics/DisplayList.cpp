@@ -0,0 +1,1331 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DisplayList.h"
+
+#include "ImageBuffer.h"
+#include "RoundedRect.h"
+#include "SimpleFontData.h"
+#include "TextRun.h"
+#include <wtf/MathExtras.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+class DisplayListItem {
+    WTF_MAKE_NONCOPYABLE(DisplayListItem); WTF_MAKE_FAST_ALLOCATED;
+public:
+    DisplayListItem()
+        : m_hasExtent(false)
+    {
+    }
+    virtual ~DisplayListItem() { }
+
+    // |baseCTM| is the transform of the context being replayed into when the replay started.
+    virtual void apply(GraphicsContext&, const AffineTransform& baseCTM) const = 0;
+    virtual size_t sizeInBytes() const = 0;
+
+    // Only drawing items have an extent; the others always need to be replayed.
+    bool hasExtent() const { return m_hasExtent; }
+    const FloatRect& extent() const { return m_extent; }
+    void setExtent(const FloatRect& extent)
+    {
+        m_extent = extent;
+        m_hasExtent = true;
+    }
+
+private:
+    FloatRect m_extent;
+    bool m_hasExtent;
+};
+
+static bool shadowsEqual(const GraphicsContextState& a, const GraphicsContextState& b)
+{
+    return a.shadowOffset == b.shadowOffset
+        && a.shadowBlur == b.shadowBlur
+        && a.shadowColor == b.shadowColor
+        && a.shadowColorSpace == b.shadowColorSpace
+        && a.shadowsIgnoreTransforms == b.shadowsIgnoreTransforms
+#if USE(CG)
+        && a.shadowsUseLegacyRadius == b.shadowsUseLegacyRadius
+#endif
+        ;
+}
+
+static bool statesEqual(const GraphicsContextState& a, const GraphicsContextState& b)
+{
+    return a.strokeGradient == b.strokeGradient
+        && a.strokePattern == b.strokePattern
+        && a.fillGradient == b.fillGradient
+        && a.fillPattern == b.fillPattern
+        && a.strokeThickness == b.strokeThickness
+        && a.textDrawingMode == b.textDrawingMode
+        && a.strokeColor == b.strokeColor
+        && a.fillColor == b.fillColor
+        && a.strokeStyle == b.strokeStyle
+        && a.fillRule == b.fillRule
+        && a.strokeColorSpace == b.strokeColorSpace
+        && a.fillColorSpace == b.fillColorSpace
+        && a.compositeOperator == b.compositeOperator
+        && a.blendMode == b.blendMode
+        && a.shouldAntialias == b.shouldAntialias
+        && a.shouldSmoothFonts == b.shouldSmoothFonts
+        && a.shouldSubpixelQuantizeFonts == b.shouldSubpixelQuantizeFonts
+        && shadowsEqual(a, b);
+}
+
+class DisplayListSetState : public DisplayListItem {
+public:
+    explicit DisplayListSetState(const GraphicsContextState& state)
+        : m_state(state)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        context.setStrokeThickness(m_state.strokeThickness);
+        context.setStrokeStyle(m_state.strokeStyle);
+        context.setStrokeColor(m_state.strokeColor, m_state.strokeColorSpace);
+        if (m_state.strokeGradient)
+            context.setStrokeGradient(m_state.strokeGradient);
+        else if (m_state.strokePattern)
+            context.setStrokePattern(m_state.strokePattern);
+
+        context.setFillRule(m_state.fillRule);
+        context.setFillColor(m_state.fillColor, m_state.fillColorSpace);
+        if (m_state.fillGradient)
+            context.setFillGradient(m_state.fillGradient);
+        else if (m_state.fillPattern)
+            context.setFillPattern(m_state.fillPattern);
+
+        // The platform shadow depends on whether it ignores transforms, so that goes first.
+        context.setShadowsIgnoreTransforms(m_state.shadowsIgnoreTransforms);
+        if (!m_state.shadowColor.isValid())
+            context.clearShadow();
+#if USE(CG)
+        else if (m_state.shadowsUseLegacyRadius)
+            context.setLegacyShadow(m_state.shadowOffset, m_state.shadowBlur, m_state.shadowColor, m_state.shadowColorSpace);
+#endif
+        else
+            context.setShadow(m_state.shadowOffset, m_state.shadowBlur, m_state.shadowColor, m_state.shadowColorSpace);
+
+        context.setTextDrawingMode(m_state.textDrawingMode);
+        context.setCompositeOperation(m_state.compositeOperator, m_state.blendMode);
+        context.setShouldAntialias(m_state.shouldAntialias);
+        context.setShouldSmoothFonts(m_state.shouldSmoothFonts);
+        context.setShouldSubpixelQuantizeFonts(m_state.shouldSubpixelQuantizeFonts);
+    }
+
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    GraphicsContextState m_state;
+};
+
+class DisplayListSave : public DisplayListItem {
+public:
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.save(); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+};
+
+class DisplayListRestore : public DisplayListItem {
+public:
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.restore(); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+};
+
+class DisplayListConcatCTM : public DisplayListItem {
+public:
+    explicit DisplayListConcatCTM(const AffineTransform& transform)
+        : m_transform(transform)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.concatCTM(m_transform); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    AffineTransform m_transform;
+};
+
+class DisplayListSetCTM : public DisplayListItem {
+public:
+    // |transform| is relative to the transform the recording started with.
+    explicit DisplayListSetCTM(const AffineTransform& transform)
+        : m_transform(transform)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform& baseCTM) const OVERRIDE
+    {
+        context.setCTM(AffineTransform(baseCTM).multiply(m_transform));
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    AffineTransform m_transform;
+};
+
+class DisplayListClip : public DisplayListItem {
+public:
+    explicit DisplayListClip(const FloatRect& rect)
+        : m_rect(rect)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.clip(m_rect); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    FloatRect m_rect;
+};
+
+class DisplayListClipPath : public DisplayListItem {
+public:
+    enum Type { ClipPath, CanvasClip, ClipOut };
+
+    DisplayListClipPath(Type type, const Path& path, WindRule windRule)
+        : m_type(type)
+        , m_path(path)
+        , m_windRule(windRule)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        switch (m_type) {
+        case ClipPath:
+            context.clipPath(m_path, m_windRule);
+            break;
+        case CanvasClip:
+            context.canvasClip(m_path, m_windRule);
+            break;
+        case ClipOut:
+            context.clipOut(m_path);
+            break;
+        }
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    Type m_type;
+    Path m_path;
+    WindRule m_windRule;
+};
+
+class DisplayListClipOut : public DisplayListItem {
+public:
+    explicit DisplayListClipOut(const IntRect& rect)
+        : m_rect(rect)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.clipOut(m_rect); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    IntRect m_rect;
+};
+
+class DisplayListConvexPolygon : public DisplayListItem {
+public:
+    enum Type { Draw, Clip };
+
+    DisplayListConvexPolygon(Type type, size_t numPoints, const FloatPoint* points, bool antialias)
+        : m_type(type)
+        , m_antialias(antialias)
+    {
+        m_points.append(points, numPoints);
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        if (m_type == Draw)
+            context.drawConvexPolygon(m_points.size(), m_points.data(), m_antialias);
+        else
+            context.clipConvexPolygon(m_points.size(), m_points.data(), m_antialias);
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this) + m_points.size() * sizeof(FloatPoint); }
+
+private:
+    Type m_type;
+    Vector<FloatPoint> m_points;
+    bool m_antialias;
+};
+
+class DisplayListSetLineCap : public DisplayListItem {
+public:
+    explicit DisplayListSetLineCap(LineCap lineCap)
+        : m_lineCap(lineCap)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.setLineCap(m_lineCap); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    LineCap m_lineCap;
+};
+
+class DisplayListSetLineDash : public DisplayListItem {
+public:
+    DisplayListSetLineDash(const DashArray& dashes, float dashOffset)
+        : m_dashes(dashes)
+        , m_dashOffset(dashOffset)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.setLineDash(m_dashes, m_dashOffset); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this) + m_dashes.size() * sizeof(DashArrayElement); }
+
+private:
+    DashArray m_dashes;
+    float m_dashOffset;
+};
+
+class DisplayListSetLineJoin : public DisplayListItem {
+public:
+    explicit DisplayListSetLineJoin(LineJoin lineJoin)
+        : m_lineJoin(lineJoin)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.setLineJoin(m_lineJoin); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    LineJoin m_lineJoin;
+};
+
+class DisplayListSetMiterLimit : public DisplayListItem {
+public:
+    explicit DisplayListSetMiterLimit(float miterLimit)
+        : m_miterLimit(miterLimit)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.setMiterLimit(m_miterLimit); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    float m_miterLimit;
+};
+
+class DisplayListSetAlpha : public DisplayListItem {
+public:
+    explicit DisplayListSetAlpha(float alpha)
+        : m_alpha(alpha)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.setAlpha(m_alpha); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    float m_alpha;
+};
+
+class DisplayListSetImageInterpolationQuality : public DisplayListItem {
+public:
+    explicit DisplayListSetImageInterpolationQuality(InterpolationQuality quality)
+        : m_quality(quality)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.setImageInterpolationQuality(m_quality); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    InterpolationQuality m_quality;
+};
+
+class DisplayListBeginTransparencyLayer : public DisplayListItem {
+public:
+    explicit DisplayListBeginTransparencyLayer(float opacity)
+        : m_opacity(opacity)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.beginTransparencyLayer(m_opacity); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    float m_opacity;
+};
+
+class DisplayListEndTransparencyLayer : public DisplayListItem {
+public:
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.endTransparencyLayer(); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+};
+
+class DisplayListDrawShape : public DisplayListItem {
+public:
+    enum Type { DrawRect, DrawEllipse };
+
+    DisplayListDrawShape(Type type, const IntRect& rect)
+        : m_type(type)
+        , m_rect(rect)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        if (m_type == DrawRect)
+            context.drawRect(m_rect);
+        else
+            context.drawEllipse(m_rect);
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    Type m_type;
+    IntRect m_rect;
+};
+
+class DisplayListDrawLine : public DisplayListItem {
+public:
+    DisplayListDrawLine(const IntPoint& point1, const IntPoint& point2)
+        : m_point1(point1)
+        , m_point2(point2)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.drawLine(m_point1, m_point2); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    IntPoint m_point1;
+    IntPoint m_point2;
+};
+
+class DisplayListDrawPath : public DisplayListItem {
+public:
+    enum Type { Fill, Stroke };
+
+    DisplayListDrawPath(Type type, const Path& path)
+        : m_type(type)
+        , m_path(path)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        if (m_type == Fill)
+            context.fillPath(m_path);
+        else
+            context.strokePath(m_path);
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    Type m_type;
+    Path m_path;
+};
+
+class DisplayListFillRect : public DisplayListItem {
+public:
+    explicit DisplayListFillRect(const FloatRect& rect)
+        : m_rect(rect)
+        , m_hasColor(false)
+        , m_colorSpace(ColorSpaceDeviceRGB)
+    {
+    }
+
+    DisplayListFillRect(const FloatRect& rect, const Color& color, ColorSpace colorSpace)
+        : m_rect(rect)
+        , m_hasColor(true)
+        , m_color(color)
+        , m_colorSpace(colorSpace)
+    {
+    }
+
+    DisplayListFillRect(const FloatRect& rect, Gradient& gradient)
+        : m_rect(rect)
+        , m_hasColor(false)
+        , m_colorSpace(ColorSpaceDeviceRGB)
+        , m_gradient(&gradient)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        if (m_gradient)
+            context.fillRect(m_rect, *m_gradient);
+        else if (m_hasColor)
+            context.fillRect(m_rect, m_color, m_colorSpace);
+        else
+            context.fillRect(m_rect);
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    FloatRect m_rect;
+    bool m_hasColor;
+    Color m_color;
+    ColorSpace m_colorSpace;
+    RefPtr<Gradient> m_gradient;
+};
+
+class DisplayListFillRoundedRect : public DisplayListItem {
+public:
+    DisplayListFillRoundedRect(const RoundedRect& rect, const Color& color, ColorSpace colorSpace)
+        : m_rect(rect)
+        , m_color(color)
+        , m_colorSpace(colorSpace)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        const RoundedRect::Radii& radii = m_rect.radii();
+        context.fillRoundedRect(m_rect.rect(), radii.topLeft(), radii.topRight(), radii.bottomLeft(), radii.bottomRight(), m_color, m_colorSpace);
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    RoundedRect m_rect;
+    Color m_color;
+    ColorSpace m_colorSpace;
+};
+
+class DisplayListFillRectWithRoundedHole : public DisplayListItem {
+public:
+    DisplayListFillRectWithRoundedHole(const IntRect& rect, const RoundedRect& roundedHoleRect, const Color& color, ColorSpace colorSpace)
+        : m_rect(rect)
+        , m_roundedHoleRect(roundedHoleRect)
+        , m_color(color)
+        , m_colorSpace(colorSpace)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.fillRectWithRoundedHole(m_rect, m_roundedHoleRect, m_color, m_colorSpace); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    IntRect m_rect;
+    RoundedRect m_roundedHoleRect;
+    Color m_color;
+    ColorSpace m_colorSpace;
+};
+
+class DisplayListClearRect : public DisplayListItem {
+public:
+    explicit DisplayListClearRect(const FloatRect& rect)
+        : m_rect(rect)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.clearRect(m_rect); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    FloatRect m_rect;
+};
+
+class DisplayListStrokeRect : public DisplayListItem {
+public:
+    DisplayListStrokeRect(const FloatRect& rect, float lineWidth)
+        : m_rect(rect)
+        , m_lineWidth(lineWidth)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.strokeRect(m_rect, m_lineWidth); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    FloatRect m_rect;
+    float m_lineWidth;
+};
+
+class DisplayListDrawFocusRing : public DisplayListItem {
+public:
+    DisplayListDrawFocusRing(const Vector<IntRect>& rects, int width, int offset, const Color& color)
+        : m_rects(rects)
+        , m_width(width)
+        , m_offset(offset)
+        , m_color(color)
+    {
+    }
+
+    DisplayListDrawFocusRing(const Path& path, int width, int offset, const Color& color)
+        : m_path(path)
+        , m_width(width)
+        , m_offset(offset)
+        , m_color(color)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        if (m_rects.isEmpty())
+            context.drawFocusRing(m_path, m_width, m_offset, m_color);
+        else
+            context.drawFocusRing(m_rects, m_width, m_offset, m_color);
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this) + m_rects.size() * sizeof(IntRect); }
+
+private:
+    Vector<IntRect> m_rects;
+    Path m_path;
+    int m_width;
+    int m_offset;
+    Color m_color;
+};
+
+class DisplayListDrawLineForText : public DisplayListItem {
+public:
+    DisplayListDrawLineForText(const FloatPoint& origin, float width, bool printing)
+        : m_origin(origin)
+        , m_width(width)
+        , m_printing(printing)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.drawLineForText(m_origin, m_width, m_printing); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    FloatPoint m_origin;
+    float m_width;
+    bool m_printing;
+};
+
+class DisplayListDrawLineForDocumentMarker : public DisplayListItem {
+public:
+    DisplayListDrawLineForDocumentMarker(const FloatPoint& origin, float width, GraphicsContext::DocumentMarkerLineStyle style)
+        : m_origin(origin)
+        , m_width(width)
+        , m_style(style)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.drawLineForDocumentMarker(m_origin, m_width, m_style); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    FloatPoint m_origin;
+    float m_width;
+    GraphicsContext::DocumentMarkerLineStyle m_style;
+};
+
+// The characters of a TextRun belong to the caller, so the item keeps its own copy. The run's
+// RenderingContext points into the render tree and is dropped; see DisplayListRecorder::canRecordText().
+class DisplayListTextItem : public DisplayListItem {
+protected:
+    DisplayListTextItem(const Font& font, const TextRun& run, const FloatPoint& point)
+        : m_font(font)
+        , m_run(run)
+        , m_point(point)
+    {
+        m_run.setRenderingContext(0);
+        unsigned charactersLength = std::max(run.length(), run.charactersLength());
+#if ENABLE(8BIT_TEXTRUN)
+        if (run.is8Bit()) {
+            m_characters = String(run.characters8(), charactersLength);
+            m_run.setText(m_characters.characters8(), run.length());
+            return;
+        }
+#endif
+        m_characters = String(run.characters16(), charactersLength);
+        m_run.setText(m_characters.characters16(), run.length());
+    }
+
+    size_t textSizeInBytes() const { return m_characters.length() * (m_characters.is8Bit() ? sizeof(LChar) : sizeof(UChar)); }
+
+    Font m_font;
+    String m_characters;
+    TextRun m_run;
+    FloatPoint m_point;
+};
+
+class DisplayListDrawText : public DisplayListTextItem {
+public:
+    DisplayListDrawText(const Font& font, const TextRun& run, const FloatPoint& point, int from, int to)
+        : DisplayListTextItem(font, run, point)
+        , m_from(from)
+        , m_to(to)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.drawText(m_font, m_run, m_point, m_from, m_to); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this) + textSizeInBytes(); }
+
+private:
+    int m_from;
+    int m_to;
+};
+
+class DisplayListDrawEmphasisMarks : public DisplayListTextItem {
+public:
+    DisplayListDrawEmphasisMarks(const Font& font, const TextRun& run, const AtomicString& mark, const FloatPoint& point, int from, int to)
+        : DisplayListTextItem(font, run, point)
+        , m_mark(mark)
+        , m_from(from)
+        , m_to(to)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.drawEmphasisMarks(m_font, m_run, m_mark, m_point, m_from, m_to); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this) + textSizeInBytes(); }
+
+private:
+    AtomicString m_mark;
+    int m_from;
+    int m_to;
+};
+
+class DisplayListDrawBidiText : public DisplayListTextItem {
+public:
+    DisplayListDrawBidiText(const Font& font, const TextRun& run, const FloatPoint& point, Font::CustomFontNotReadyAction customFontNotReadyAction)
+        : DisplayListTextItem(font, run, point)
+        , m_customFontNotReadyAction(customFontNotReadyAction)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE { context.drawBidiText(m_font, m_run, m_point, m_customFontNotReadyAction); }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this) + textSizeInBytes(); }
+
+private:
+    Font::CustomFontNotReadyAction m_customFontNotReadyAction;
+};
+
+class DisplayListDrawImage : public DisplayListItem {
+public:
+    DisplayListDrawImage(PassRefPtr<Image> image, ColorSpace colorSpace, const FloatRect& destRect, const FloatRect& srcRect, CompositeOperator op, BlendMode blendMode, RespectImageOrientationEnum orientation, bool useLowQualityScale)
+        : m_image(image)
+        , m_colorSpace(colorSpace)
+        , m_destRect(destRect)
+        , m_srcRect(srcRect)
+        , m_compositeOperator(op)
+        , m_blendMode(blendMode)
+        , m_orientation(orientation)
+        , m_useLowQualityScale(useLowQualityScale)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        context.drawImage(m_image.get(), m_colorSpace, m_destRect, m_srcRect, m_compositeOperator, m_blendMode, m_orientation, m_useLowQualityScale);
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    RefPtr<Image> m_image;
+    ColorSpace m_colorSpace;
+    FloatRect m_destRect;
+    FloatRect m_srcRect;
+    CompositeOperator m_compositeOperator;
+    BlendMode m_blendMode;
+    RespectImageOrientationEnum m_orientation;
+    bool m_useLowQualityScale;
+};
+
+class DisplayListDrawTiledImage : public DisplayListItem {
+public:
+    DisplayListDrawTiledImage(Image* image, ColorSpace colorSpace, const IntRect& destRect, const IntPoint& srcPoint, const IntSize& tileSize, CompositeOperator op, bool useLowQualityScale, BlendMode blendMode)
+        : m_image(image)
+        , m_colorSpace(colorSpace)
+        , m_destRect(destRect)
+        , m_srcPoint(srcPoint)
+        , m_tileSize(tileSize)
+        , m_usesTileRules(false)
+        , m_hRule(Image::StretchTile)
+        , m_vRule(Image::StretchTile)
+        , m_compositeOperator(op)
+        , m_useLowQualityScale(useLowQualityScale)
+        , m_blendMode(blendMode)
+    {
+    }
+
+    DisplayListDrawTiledImage(Image* image, ColorSpace colorSpace, const IntRect& destRect, const IntRect& srcRect, const FloatSize& tileScaleFactor, Image::TileRule hRule, Image::TileRule vRule, CompositeOperator op, bool useLowQualityScale)
+        : m_image(image)
+        , m_colorSpace(colorSpace)
+        , m_destRect(destRect)
+        , m_srcRect(srcRect)
+        , m_tileScaleFactor(tileScaleFactor)
+        , m_usesTileRules(true)
+        , m_hRule(hRule)
+        , m_vRule(vRule)
+        , m_compositeOperator(op)
+        , m_useLowQualityScale(useLowQualityScale)
+        , m_blendMode(BlendModeNormal)
+    {
+    }
+
+    virtual void apply(GraphicsContext& context, const AffineTransform&) const OVERRIDE
+    {
+        if (m_usesTileRules)
+            context.drawTiledImage(m_image.get(), m_colorSpace, m_destRect, m_srcRect, m_tileScaleFactor, m_hRule, m_vRule, m_compositeOperator, m_useLowQualityScale);
+        else
+            context.drawTiledImage(m_image.get(), m_colorSpace, m_destRect, m_srcPoint, m_tileSize, m_compositeOperator, m_useLowQualityScale, m_blendMode);
+    }
+    virtual size_t sizeInBytes() const OVERRIDE { return sizeof(*this); }
+
+private:
+    RefPtr<Image> m_image;
+    ColorSpace m_colorSpace;
+    IntRect m_destRect;
+    IntPoint m_srcPoint;
+    IntSize m_tileSize;
+    IntRect m_srcRect;
+    FloatSize m_tileScaleFactor;
+    bool m_usesTileRules;
+    Image::TileRule m_hRule;
+    Image::TileRule m_vRule;
+    CompositeOperator m_compositeOperator;
+    bool m_useLowQualityScale;
+    BlendMode m_blendMode;
+};
+
+DisplayList::DisplayList(const FloatRect& bounds)
+    : m_bounds(bounds)
+{
+}
+
+DisplayList::~DisplayList()
+{
+}
+
+void DisplayList::replay(GraphicsContext& context) const
+{
+    AffineTransform baseCTM = context.getCTM();
+    for (size_t i = 0; i < m_items.size(); ++i)
+        m_items[i]->apply(context, baseCTM);
+}
+
+void DisplayList::replay(GraphicsContext& context, const FloatRect& cullRect) const
+{
+    AffineTransform baseCTM = context.getCTM();
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        const DisplayListItem& item = *m_items[i];
+        if (item.hasExtent() && !item.extent().intersects(cullRect))
+            continue;
+        item.apply(context, baseCTM);
+    }
+}
+
+size_t DisplayList::sizeInBytes() const
+{
+    size_t size = sizeof(*this) + m_items.capacity() * sizeof(OwnPtr<DisplayListItem>);
+    for (size_t i = 0; i < m_items.size(); ++i)
+        size += m_items[i]->sizeInBytes();
+    return size;
+}
+
+DisplayListRecorder::DisplayListRecorder(const FloatRect& bounds, const AffineTransform& baseCTM)
+    : m_displayList(adoptPtr(new DisplayList(bounds)))
+    , m_context(adoptPtr(new GraphicsContext(static_cast<PlatformGraphicsContext*>(0))))
+    , m_baseCTM(baseCTM)
+    , m_inverseBaseCTM(baseCTM.isInvertible() ? baseCTM.inverse() : AffineTransform())
+    , m_pendingItemHasExtent(false)
+    , m_isComplete(true)
+{
+    State initialState;
+    initialState.clipBounds = bounds;
+    m_stateStack.append(initialState);
+
+    m_context->setDisplayListRecorder(this);
+}
+
+DisplayListRecorder::~DisplayListRecorder()
+{
+    m_context->setDisplayListRecorder(0);
+}
+
+PassOwnPtr<DisplayList> DisplayListRecorder::finishRecording()
+{
+    ASSERT(m_stateStack.size() == 1);
+    if (!m_isComplete)
+        return nullptr;
+    m_displayList->m_items.shrinkToFit();
+    return m_displayList.release();
+}
+
+PlatformGraphicsContext* DisplayListRecorder::platformContextForExternalPainting()
+{
+    markIncomplete();
+    if (!m_scratchBuffer)
+        m_scratchBuffer = ImageBuffer::create(IntSize(1, 1));
+    return m_scratchBuffer ? m_scratchBuffer->context()->platformContext() : 0;
+}
+
+void DisplayListRecorder::append(PassOwnPtr<DisplayListItem> item)
+{
+    if (!m_isComplete)
+        return;
+    m_displayList->m_items.append(item);
+}
+
+void DisplayListRecorder::appendStateIfNeeded()
+{
+    State& state = currentState();
+    const GraphicsContextState& contextState = m_context->state();
+    if (state.hasAppendedDrawingState && statesEqual(state.drawingState, contextState))
+        return;
+
+    append(adoptPtr(new DisplayListSetState(contextState)));
+    state.drawingState = contextState;
+    state.hasAppendedDrawingState = true;
+}
+
+bool DisplayListRecorder::willAppendDrawingItem(const FloatRect& localExtent, float outset)
+{
+    if (!m_isComplete)
+        return false;
+
+    const GraphicsContextState& contextState = m_context->state();
+    FloatRect extent = localExtent;
+    // Antialiasing and snapping to device pixels may touch one more pixel on each side.
+    extent.inflate(outset + 1);
+
+    if (m_context->hasShadow()) {
+        // Offsets of shadows that ignore transforms are in device space.
+        if (contextState.shadowsIgnoreTransforms)
+            return willAppendDrawingItemWithUnknownExtent();
+        FloatRect shadowExtent = extent;
+        shadowExtent.move(contextState.shadowOffset);
+        shadowExtent.inflate(2 * contextState.shadowBlur);
+        extent.unite(shadowExtent);
+    }
+
+    const State& state = currentState();
+    extent = state.ctm.mapRect(extent);
+    if (!extent.intersects(state.clipBounds))
+        return false;
+
+    appendStateIfNeeded();
+    m_pendingItemExtent = extent;
+    m_pendingItemHasExtent = true;
+    return true;
+}
+
+bool DisplayListRecorder::willAppendStrokeItem(const FloatRect& localExtent)
+{
+    // Miter joins reach out up to half the miter limit times the stroke width.
+    float outset = m_context->strokeThickness() / 2 * std::max(currentState().miterLimit, 1.f);
+    return willAppendDrawingItem(localExtent, outset);
+}
+
+bool DisplayListRecorder::willAppendDrawingItemWithUnknownExtent()
+{
+    if (!m_isComplete)
+        return false;
+
+    appendStateIfNeeded();
+    m_pendingItemHasExtent = false;
+    return true;
+}
+
+void DisplayListRecorder::appendDrawingItem(PassOwnPtr<DisplayListItem> passItem)
+{
+    OwnPtr<DisplayListItem> item = passItem;
+    if (m_pendingItemHasExtent)
+        item->setExtent(m_pendingItemExtent);
+    m_pendingItemHasExtent = false;
+    append(item.release());
+}
+
+void DisplayListRecorder::intersectClip(const FloatRect& localRect)
+{
+    State& state = currentState();
+    state.clipBounds.intersect(state.ctm.mapRect(localRect));
+}
+
+void DisplayListRecorder::save()
+{
+    m_stateStack.append(currentState());
+    append(adoptPtr(new DisplayListSave));
+}
+
+void DisplayListRecorder::restore()
+{
+    if (m_stateStack.size() <= 1) {
+        ASSERT_NOT_REACHED();
+        return;
+    }
+    m_stateStack.removeLast();
+    append(adoptPtr(new DisplayListRestore));
+}
+
+void DisplayListRecorder::translate(float x, float y)
+{
+    concatCTM(AffineTransform().translate(x, y));
+}
+
+void DisplayListRecorder::rotate(float angleInRadians)
+{
+    concatCTM(AffineTransform().rotate(rad2deg(angleInRadians)));
+}
+
+void DisplayListRecorder::scale(const FloatSize& size)
+{
+    concatCTM(AffineTransform().scaleNonUniform(size.width(), size.height()));
+}
+
+void DisplayListRecorder::concatCTM(const AffineTransform& transform)
+{
+    currentState().ctm.multiply(transform);
+    append(adoptPtr(new DisplayListConcatCTM(transform)));
+}
+
+void DisplayListRecorder::setCTM(const AffineTransform& transform)
+{
+    AffineTransform relativeTransform = m_inverseBaseCTM;
+    relativeTransform.multiply(transform);
+    currentState().ctm = relativeTransform;
+    append(adoptPtr(new DisplayListSetCTM(relativeTransform)));
+}
+
+AffineTransform DisplayListRecorder::getCTM() const
+{
+    AffineTransform transform = m_baseCTM;
+    return transform.multiply(currentState().ctm);
+}
+
+FloatRect DisplayListRecorder::roundToDevicePixels(const FloatRect& rect) const
+{
+    AffineTransform transform = getCTM();
+    if (!transform.isInvertible())
+        return rect;
+
+    FloatPoint p1 = transform.mapPoint(rect.location());
+    FloatPoint p2 = transform.mapPoint(rect.maxXMaxYCorner());
+    p1 = FloatPoint(roundf(p1.x()), roundf(p1.y()));
+    p2 = FloatPoint(roundf(p2.x()), roundf(p2.y()));
+
+    AffineTransform inverse = transform.inverse();
+    p1 = inverse.mapPoint(p1);
+    p2 = inverse.mapPoint(p2);
+    return FloatRect(p1, FloatSize(p2.x() - p1.x(), p2.y() - p1.y()));
+}
+
+void DisplayListRecorder::clip(const FloatRect& rect)
+{
+    intersectClip(rect);
+    append(adoptPtr(new DisplayListClip(rect)));
+}
+
+void DisplayListRecorder::clipPath(const Path& path, WindRule windRule)
+{
+    intersectClip(path.boundingRect());
+    append(adoptPtr(new DisplayListClipPath(DisplayListClipPath::ClipPath, path, windRule)));
+}
+
+void DisplayListRecorder::canvasClip(const Path& path, WindRule windRule)
+{
+    intersectClip(path.boundingRect());
+    append(adoptPtr(new DisplayListClipPath(DisplayListClipPath::CanvasClip, path, windRule)));
+}
+
+void DisplayListRecorder::clipOut(const IntRect& rect)
+{
+    append(adoptPtr(new DisplayListClipOut(rect)));
+}
+
+void DisplayListRecorder::clipOut(const Path& path)
+{
+    append(adoptPtr(new DisplayListClipPath(DisplayListClipPath::ClipOut, path, RULE_EVENODD)));
+}
+
+static FloatRect boundsOfPoints(size_t numPoints, const FloatPoint* points)
+{
+    if (!numPoints)
+        return FloatRect();
+
+    FloatPoint minimum = points[0];
+    FloatPoint maximum = points[0];
+    for (size_t i = 1; i < numPoints; ++i) {
+        minimum = FloatPoint(std::min(minimum.x(), points[i].x()), std::min(minimum.y(), points[i].y()));
+        maximum = FloatPoint(std::max(maximum.x(), points[i].x()), std::max(maximum.y(), points[i].y()));
+    }
+    return FloatRect(minimum, FloatSize(maximum.x() - minimum.x(), maximum.y() - minimum.y()));
+}
+
+void DisplayListRecorder::clipConvexPolygon(size_t numPoints, const FloatPoint* points, bool antialias)
+{
+    if (numPoints <= 1)
+        return;
+    intersectClip(boundsOfPoints(numPoints, points));
+    append(adoptPtr(new DisplayListConvexPolygon(DisplayListConvexPolygon::Clip, numPoints, points, antialias)));
+}
+
+IntRect DisplayListRecorder::clipBounds() const
+{
+    const State& state = currentState();
+    if (!state.ctm.isInvertible())
+        return IntRect();
+    return enclosingIntRect(state.ctm.inverse().mapRect(state.clipBounds));
+}
+
+void DisplayListRecorder::setLineCap(LineCap lineCap)
+{
+    append(adoptPtr(new DisplayListSetLineCap(lineCap)));
+}
+
+void DisplayListRecorder::setLineDash(const DashArray& dashes, float dashOffset)
+{
+    append(adoptPtr(new DisplayListSetLineDash(dashes, dashOffset)));
+}
+
+void DisplayListRecorder::setLineJoin(LineJoin lineJoin)
+{
+    append(adoptPtr(new DisplayListSetLineJoin(lineJoin)));
+}
+
+void DisplayListRecorder::setMiterLimit(float miterLimit)
+{
+    currentState().miterLimit = miterLimit;
+    append(adoptPtr(new DisplayListSetMiterLimit(miterLimit)));
+}
+
+void DisplayListRecorder::setAlpha(float alpha)
+{
+    append(adoptPtr(new DisplayListSetAlpha(alpha)));
+}
+
+void DisplayListRecorder::setImageInterpolationQuality(InterpolationQuality quality)
+{
+    currentState().imageInterpolationQuality = quality;
+    append(adoptPtr(new DisplayListSetImageInterpolationQuality(quality)));
+}
+
+void DisplayListRecorder::beginTransparencyLayer(float opacity)
+{
+    append(adoptPtr(new DisplayListBeginTransparencyLayer(opacity)));
+}
+
+void DisplayListRecorder::endTransparencyLayer()
+{
+    append(adoptPtr(new DisplayListEndTransparencyLayer));
+}
+
+void DisplayListRecorder::drawRect(const IntRect& rect)
+{
+    if (willAppendStrokeItem(rect))
+        appendDrawingItem(adoptPtr(new DisplayListDrawShape(DisplayListDrawShape::DrawRect, rect)));
+}
+
+void DisplayListRecorder::drawLine(const IntPoint& point1, const IntPoint& point2)
+{
+    FloatPoint points[2] = { point1, point2 };
+    if (willAppendStrokeItem(boundsOfPoints(2, points)))
+        appendDrawingItem(adoptPtr(new DisplayListDrawLine(point1, point2)));
+}
+
+void DisplayListRecorder::drawEllipse(const IntRect& rect)
+{
+    if (willAppendStrokeItem(rect))
+        appendDrawingItem(adoptPtr(new DisplayListDrawShape(DisplayListDrawShape::DrawEllipse, rect)));
+}
+
+void DisplayListRecorder::drawConvexPolygon(size_t numPoints, const FloatPoint* points, bool shouldAntialias)
+{
+    if (numPoints <= 1)
+        return;
+    if (willAppendStrokeItem(boundsOfPoints(numPoints, points)))
+        appendDrawingItem(adoptPtr(new DisplayListConvexPolygon(DisplayListConvexPolygon::Draw, numPoints, points, shouldAntialias)));
+}
+
+void DisplayListRecorder::fillPath(const Path& path)
+{
+    if (willAppendDrawingItem(path.boundingRect()))
+        appendDrawingItem(adoptPtr(new DisplayListDrawPath(DisplayListDrawPath::Fill, path)));
+}
+
+void DisplayListRecorder::strokePath(const Path& path)
+{
+    if (willAppendStrokeItem(path.boundingRect()))
+        appendDrawingItem(adoptPtr(new DisplayListDrawPath(DisplayListDrawPath::Stroke, path)));
+}
+
+void DisplayListRecorder::fillRect(const FloatRect& rect)
+{
+    if (willAppendDrawingItem(rect))
+        appendDrawingItem(adoptPtr(new DisplayListFillRect(rect)));
+}
+
+void DisplayListRecorder::fillRect(const FloatRect& rect, const Color& color, ColorSpace colorSpace)
+{
+    if (willAppendDrawingItem(rect))
+        appendDrawingItem(adoptPtr(new DisplayListFillRect(rect, color, colorSpace)));
+}
+
+void DisplayListRecorder::fillRect(const FloatRect& rect, Gradient& gradient)
+{
+    if (willAppendDrawingItem(rect))
+        appendDrawingItem(adoptPtr(new DisplayListFillRect(rect, gradient)));
+}
+
+void DisplayListRecorder::fillRoundedRect(const IntRect& rect, const IntSize& topLeft, const IntSize& topRight, const IntSize& bottomLeft, const IntSize& bottomRight, const Color& color, ColorSpace colorSpace)
+{
+    if (willAppendDrawingItem(rect))
+        appendDrawingItem(adoptPtr(new DisplayListFillRoundedRect(RoundedRect(rect, topLeft, topRight, bottomLeft, bottomRight), color, colorSpace)));
+}
+
+void DisplayListRecorder::fillRectWithRoundedHole(const IntRect& rect, const RoundedRect& roundedHoleRect, const Color& color, ColorSpace colorSpace)
+{
+    if (willAppendDrawingItem(rect))
+        appendDrawingItem(adoptPtr(new DisplayListFillRectWithRoundedHole(rect, roundedHoleRect, color, colorSpace)));
+}
+
+void DisplayListRecorder::clearRect(const FloatRect& rect)
+{
+    if (willAppendDrawingItem(rect))
+        appendDrawingItem(adoptPtr(new DisplayListClearRect(rect)));
+}
+
+void DisplayListRecorder::strokeRect(const FloatRect& rect, float lineWidth)
+{
+    if (willAppendDrawingItem(rect, lineWidth / 2 * std::max(currentState().miterLimit, 1.f)))
+        appendDrawingItem(adoptPtr(new DisplayListStrokeRect(rect, lineWidth)));
+}
+
+void DisplayListRecorder::drawFocusRing(const Vector<IntRect>& rects, int width, int offset, const Color& color)
+{
+    if (rects.isEmpty())
+        return;
+
+    FloatRect extent;
+    for (size_t i = 0; i < rects.size(); ++i)
+        extent.unite(rects[i]);
+    if (willAppendDrawingItem(extent, width + std::max(offset, 0)))
+        appendDrawingItem(adoptPtr(new DisplayListDrawFocusRing(rects, width, offset, color)));
+}
+
+void DisplayListRecorder::drawFocusRing(const Path& path, int width, int offset, const Color& color)
+{
+    if (willAppendDrawingItem(path.boundingRect(), width + std::max(offset, 0)))
+        appendDrawingItem(adoptPtr(new DisplayListDrawFocusRing(path, width, offset, color)));
+}
+
+void DisplayListRecorder::drawLineForText(const FloatPoint& origin, float width, bool printing)
+{
+    FloatRect extent(origin, FloatSize(width, std::max(m_context->strokeThickness(), 1.f)));
+    if (willAppendDrawingItem(extent))
+        appendDrawingItem(adoptPtr(new DisplayListDrawLineForText(origin, width, printing)));
+}
+
+void DisplayListRecorder::drawLineForDocumentMarker(const FloatPoint& origin, float width, GraphicsContext::DocumentMarkerLineStyle style)
+{
+    FloatRect extent(origin, FloatSize(width, cMisspellingLineThickness));
+    if (willAppendDrawingItem(extent, cMisspellingLineThickness))
+        appendDrawingItem(adoptPtr(new DisplayListDrawLineForDocumentMarker(origin, width, style)));
+}
+
+bool DisplayListRecorder::canRecordText(const Font& font, const TextRun& run)
+{
+    // Only SVG fonts use the run's RenderingContext, which must not outlive this paint.
+    if (run.renderingContext() && font.primaryFont()->isSVGFont()) {
+        markIncomplete();
+        return false;
+    }
+    return run.length();
+}
+
+FloatRect DisplayListRecorder::textExtent(const Font& font, const TextRun& run, const FloatPoint& point) const
+{
+    // The whole run is covered even when only part of it is drawn, since the part is drawn where
+    // it sits within the run. Measuring complex text means shaping it, which every replay does
+    // again, so its extent runs up to the clip instead. Glyphs can overhang their advance and line
+    // box, by up to about the font size for italics and decorated fonts.
+    const FontMetrics& fontMetrics = font.fontMetrics();
+    FloatRect extent(point.x(), point.y() - fontMetrics.floatAscent(), 0, fontMetrics.floatHeight());
+    if (font.codePath(run) == Font::Complex)
+        extent.shiftMaxXEdgeTo(std::max<float>(point.x(), clipBounds().maxX()));
+    else
+        extent.setWidth(font.width(run));
+    extent.inflate(font.pixelSize());
+    return extent;
+}
+
+void DisplayListRecorder::drawText(const Font& font, const TextRun& run, const FloatPoint& point, int from, int to)
+{
+    if (!canRecordText(font, run))
+        return;
+    if (willAppendStrokeItem(textExtent(font, run, point)))
+        appendDrawingItem(adoptPtr(new DisplayListDrawText(font, run, point, from, to)));
+}
+
+void DisplayListRecorder::drawEmphasisMarks(const Font& font, const TextRun& run, const AtomicString& mark, const FloatPoint& point, int from, int to)
+{
+    if (!canRecordText(font, run))
+        return;
+    // The caller places the marks above or below the text; |point| already accounts for that.
+    if (willAppendDrawingItem(textExtent(font, run, point), font.pixelSize()))
+        appendDrawingItem(adoptPtr(new DisplayListDrawEmphasisMarks(font, run, mark, point, from, to)));
+}
+
+void DisplayListRecorder::drawBidiText(const Font& font, const TextRun& run, const FloatPoint& point, Font::CustomFontNotReadyAction customFontNotReadyAction)
+{
+    if (!canRecordText(font, run))
+        return;
+    if (willAppendStrokeItem(textExtent(font, run, point)))
+        appendDrawingItem(adoptPtr(new DisplayListDrawBidiText(font, run, point, customFontNotReadyAction)));
+}
+
+void DisplayListRecorder::drawImage(Image* image, ColorSpace colorSpace, const FloatRect& destRect, const FloatRect& srcRect, CompositeOperator op, BlendMode blendMode, RespectImageOrientationEnum orientation, bool useLowQualityScale)
+{
+    if (willAppendDrawingItem(destRect))
+        appendDrawingItem(adoptPtr(new DisplayListDrawImage(image, colorSpace, destRect, srcRect, op, blendMode, orientation, useLowQualityScale)));
+}
+
+void DisplayListRecorder::drawTiledImage(Image* image, ColorSpace colorSpace, const IntRect& destRect, const IntPoint& srcPoint, const IntSize& tileSize, CompositeOperator op, bool useLowQualityScale, BlendMode blendMode)
+{
+    if (willAppendDrawingItem(destRect))
+        appendDrawingItem(adoptPtr(new DisplayListDrawTiledImage(image, colorSpace, destRect, srcPoint, tileSize, op, useLowQualityScale, blendMode)));
+}
+
+void DisplayListRecorder::drawTiledImage(Image* image, ColorSpace colorSpace, const IntRect& destRect, const IntRect& srcRect, const FloatSize& tileScaleFactor, Image::TileRule hRule, Image::TileRule vRule, CompositeOperator op, bool useLowQualityScale)
+{
+    if (willAppendDrawingItem(destRect))
+        appendDrawingItem(adoptPtr(new DisplayListDrawTiledImage(image, colorSpace, destRect, srcRect, tileScaleFactor, hRule, vRule, op, useLowQualityScale)));
+}
+
+void DisplayListRecorder::drawImageBuffer(ImageBuffer* buffer, ColorSpace colorSpace, const FloatRect& destRect, const FloatRect& srcRect, CompositeOperator op, BlendMode blendMode, bool useLowQualityScale)
+{
+    if (!willAppendDrawingItem(destRect))
+        return;
+
+    // The buffer may be drawn into again before the list is replayed, so keep a snapshot.
+    RefPtr<Image> image = buffer->copyImage(CopyBackingStore);
+    if (!image) {
+        markIncomplete();
+        return;
+    }
+
+    // The snapshot has the size of the backing store, while |srcRect| is in logical coordinates.
+    FloatRect scaledSrcRect = srcRect;
+    const IntSize& logicalSize = buffer->logicalSize();
+    const IntSize& internalSize = buffer->internalSize();
+    if (!logicalSize.isEmpty() && logicalSize != internalSize)
+        scaledSrcRect.scale(static_cast<float>(internalSize.width()) / logicalSize.width(), static_cast<float>(internalSize.height()) / logicalSize.height());
+
+    appendDrawingItem(adoptPtr(new DisplayListDrawImage(image.release(), colorSpace, destRect, scaledSrcRect, op, blendMode, DoNotRespectImageOrientation, useLowQualityScale)));
+}
+
+} // namespace WebCore
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DisplayList_h
+#define DisplayList_h
+
+#include "AffineTransform.h"
+#include "FloatRect.h"
+#include "GraphicsContext.h"
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class DisplayListItem;
+class DisplayListRecorder;
+class ImageBuffer;
+
+// A platform independent list of the GraphicsContext operations that painted an area, which
+// can be replayed into any GraphicsContext. Coordinates are those of the context at the time
+// recording started. Replaying with a cull rect skips the drawing operations that cannot touch
+// it, which is what makes one recording cheap to reuse for every tile of a layer.
+class DisplayList {
+    WTF_MAKE_NONCOPYABLE(DisplayList); WTF_MAKE_FAST_ALLOCATED;
+public:
+    ~DisplayList();
+
+    const FloatRect& bounds() const { return m_bounds; }
+
+    void replay(GraphicsContext&) const;
+    void replay(GraphicsContext&, const FloatRect& cullRect) const;
+
+    size_t itemCount() const { return m_items.size(); }
+    size_t sizeInBytes() const;
+
+private:
+    friend class DisplayListRecorder;
+    explicit DisplayList(const FloatRect& bounds);
+
+    FloatRect m_bounds;
+    Vector<OwnPtr<DisplayListItem> > m_items;
+};
+
+// Owns a GraphicsContext whose operations are appended to a DisplayList instead of being
+// painted. Painting code can use context() like any other context; operations that cannot be
+// represented (clipping to an image buffer, 3D transforms, or code drawing straight into the
+// platform context) make the recording incomplete, in which case finishRecording() returns 0
+// and the caller has to paint directly.
+class DisplayListRecorder {
+    WTF_MAKE_NONCOPYABLE(DisplayListRecorder); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // |baseCTM| is what getCTM() reports when recording starts, so that code snapping to device
+    // pixels behaves as it would when painting directly. It is not part of the recording.
+    DisplayListRecorder(const FloatRect& bounds, const AffineTransform& baseCTM = AffineTransform());
+    ~DisplayListRecorder();
+
+    GraphicsContext* context() const { return m_context.get(); }
+
+    PassOwnPtr<DisplayList> finishRecording();
+
+    bool isComplete() const { return m_isComplete; }
+    void markIncomplete() { m_isComplete = false; }
+
+    // Called by the GraphicsContext being recorded.
+    void save();
+    void restore();
+
+    void translate(float x, float y);
+    void rotate(float angleInRadians);
+    void scale(const FloatSize&);
+    void concatCTM(const AffineTransform&);
+    void setCTM(const AffineTransform&);
+    AffineTransform getCTM() const;
+    FloatRect roundToDevicePixels(const FloatRect&) const;
+
+    void clip(const FloatRect&);
+    void clipPath(const Path&, WindRule);
+    void canvasClip(const Path&, WindRule);
+    void clipOut(const IntRect&);
+    void clipOut(const Path&);
+    void clipConvexPolygon(size_t numPoints, const FloatPoint*, bool antialias);
+    IntRect clipBounds() const;
+
+    void setLineCap(LineCap);
+    void setLineDash(const DashArray&, float dashOffset);
+    void setLineJoin(LineJoin);
+    void setMiterLimit(float);
+    void setAlpha(float);
+    void setImageInterpolationQuality(InterpolationQuality);
+    InterpolationQuality imageInterpolationQuality() const { return currentState().imageInterpolationQuality; }
+
+    void beginTransparencyLayer(float opacity);
+    void endTransparencyLayer();
+
+    void drawRect(const IntRect&);
+    void drawLine(const IntPoint&, const IntPoint&);
+    void drawEllipse(const IntRect&);
+    void drawConvexPolygon(size_t numPoints, const FloatPoint*, bool shouldAntialias);
+    void fillPath(const Path&);
+    void strokePath(const Path&);
+    void fillRect(const FloatRect&);
+    void fillRect(const FloatRect&, const Color&, ColorSpace);
+    void fillRect(const FloatRect&, Gradient&);
+    void fillRoundedRect(const IntRect&, const IntSize& topLeft, const IntSize& topRight, const IntSize& bottomLeft, const IntSize& bottomRight, const Color&, ColorSpace);
+    void fillRectWithRoundedHole(const IntRect&, const RoundedRect& roundedHoleRect, const Color&, ColorSpace);
+    void clearRect(const FloatRect&);
+    void strokeRect(const FloatRect&, float lineWidth);
+    void drawFocusRing(const Vector<IntRect>&, int width, int offset, const Color&);
+    void drawFocusRing(const Path&, int width, int offset, const Color&);
+    void drawLineForText(const FloatPoint&, float width, bool printing);
+    void drawLineForDocumentMarker(const FloatPoint&, float width, GraphicsContext::DocumentMarkerLineStyle);
+
+    void drawText(const Font&, const TextRun&, const FloatPoint&, int from, int to);
+    void drawEmphasisMarks(const Font&, const TextRun&, const AtomicString& mark, const FloatPoint&, int from, int to);
+    void drawBidiText(const Font&, const TextRun&, const FloatPoint&, Font::CustomFontNotReadyAction);
+
+    void drawImage(Image*, ColorSpace, const FloatRect& destRect, const FloatRect& srcRect, CompositeOperator, BlendMode, RespectImageOrientationEnum, bool useLowQualityScale);
+    void drawTiledImage(Image*, ColorSpace, const IntRect& destRect, const IntPoint& srcPoint, const IntSize& tileSize, CompositeOperator, bool useLowQualityScale, BlendMode);
+    void drawTiledImage(Image*, ColorSpace, const IntRect& destRect, const IntRect& srcRect, const FloatSize& tileScaleFactor, Image::TileRule hRule, Image::TileRule vRule, CompositeOperator, bool useLowQualityScale);
+    void drawImageBuffer(ImageBuffer*, ColorSpace, const FloatRect& destRect, const FloatRect& srcRect, CompositeOperator, BlendMode, bool useLowQualityScale);
+
+    // Code that paints with the platform API directly cannot be recorded. It gets a scratch
+    // platform context to draw into, and the recording is marked incomplete.
+    PlatformGraphicsContext* platformContextForExternalPainting();
+
+private:
+    struct State {
+        State()
+            : imageInterpolationQuality(InterpolationDefault)
+            , miterLimit(10)
+            , hasAppendedDrawingState(false)
+        {
+        }
+
+        AffineTransform ctm;
+        FloatRect clipBounds;
+        InterpolationQuality imageInterpolationQuality;
+        float miterLimit;
+
+        // The GraphicsContextState the last drawing item was recorded with.
+        GraphicsContextState drawingState;
+        bool hasAppendedDrawingState;
+    };
+
+    State& currentState() { return m_stateStack.last(); }
+    const State& currentState() const { return m_stateStack.last(); }
+
+    void append(PassOwnPtr<DisplayListItem>);
+
+    bool canRecordText(const Font&, const TextRun&);
+    FloatRect textExtent(const Font&, const TextRun&, const FloatPoint&) const;
+
+    // Compute the extent of the drawing item about to be appended and record the state it is
+    // drawn with. They return false if the current clip hides the item, which is then dropped.
+    bool willAppendDrawingItem(const FloatRect& localExtent, float outset = 0);
+    bool willAppendStrokeItem(const FloatRect& localExtent);
+    bool willAppendDrawingItemWithUnknownExtent();
+    void appendDrawingItem(PassOwnPtr<DisplayListItem>);
+
+    void appendStateIfNeeded();
+    void intersectClip(const FloatRect& localRect);
+
+    OwnPtr<DisplayList> m_displayList;
+    OwnPtr<GraphicsContext> m_context;
+    OwnPtr<ImageBuffer> m_scratchBuffer;
+    Vector<State, 8> m_stateStack;
+    AffineTransform m_baseCTM;
+    AffineTransform m_inverseBaseCTM;
+    FloatRect m_pendingItemExtent;
+    bool m_pendingItemHasExtent;
+    bool m_isComplete;
+};
+
+} // namespace WebCore
+
+#endif // DisplayList_h
@@ -30,6 +30,7 @@
 #include "IntPoint.h"
 #include "GlyphBuffer.h"
 #include "TextRun.h"
+#include "WidthCache.h"
 #include "WidthIterator.h"
 #include <wtf/MainThread.h>
 #include <wtf/MathExtras.h>
@@ -298,7 +299,15 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
 
     bool hasKerningOrLigatures = typesettingFeatures() & (Kerning | Ligatures);
     bool hasWordSpacingOrLetterSpacing = wordSpacing() | letterSpacing();
-    float* cacheEntry = m_glyphs->widthCache().add(run, std::numeric_limits<float>::quiet_NaN(), hasKerningOrLigatures, hasWordSpacingOrLetterSpacing, glyphOverflow);
+    float* cacheEntry = 0;
+    const SimpleFontData* primarySimpleFontData = primaryFont();
+    if (!primarySimpleFontData->isSVGFont()) {
+        unsigned fontFlags = typesettingFeatures()
+            | m_fontDescription.smallCaps() << 2
+            | m_fontDescription.orientation() << 3
+            | m_fontDescription.nonCJKGlyphOrientation() << 4;
+        cacheEntry = WidthCache::shared().add(primarySimpleFontData, fontFlags, run, std::numeric_limits<float>::quiet_NaN(), codePathToUse == Complex, m_fontDescription.featureSettings(), hasKerningOrLigatures, hasWordSpacingOrLetterSpacing, glyphOverflow);
+    }
     if (cacheEntry && !std::isnan(*cacheEntry))
         return *cacheEntry;
 
@@ -35,6 +35,7 @@
 #include "FontPlatformData.h"
 #include "FontSelector.h"
 #include "WebKitFontFamilyNames.h"
+#include "WidthCache.h"
 #include <wtf/HashMap.h>
 #include <wtf/ListHashSet.h>
 #include <wtf/StdLibExtras.h>
@@ -532,6 +533,7 @@ void FontCache::invalidate()
     if (gFontPlatformDataCache)
         gFontPlatformDataCache->clear();
     invalidateFontGlyphsCache();
+    WidthCache::shared().clear();
 
     gGeneration++;
 
@@ -23,7 +23,6 @@
 
 #include "FontSelector.h"
 #include "SimpleFontData.h"
-#include "WidthCache.h"
 #include <wtf/Forward.h>
 #include <wtf/MainThread.h>
 
@@ -83,8 +82,6 @@ public:
     unsigned fontSelectorVersion() const { return m_fontSelectorVersion; }
     unsigned generation() const { return m_generation; }
 
-    WidthCache& widthCache() const { return m_widthCache; }
-
     const SimpleFontData* primarySimpleFontData(const FontDescription&) const;
     const FontData* primaryFontData(const FontDescription& description) const { return realizeFontDataAt(description, 0); }
     const FontData* realizeFontDataAt(const FontDescription&, unsigned index) const;
@@ -100,7 +97,6 @@ private:
     mutable GlyphPageTreeNode* m_pageZero;
     mutable const SimpleFontData* m_cachedPrimarySimpleFontData;
     RefPtr<FontSelector> m_fontSelector;
-    mutable WidthCache m_widthCache;
     unsigned m_fontSelectorVersion;
     mutable int m_familyIndex;
     unsigned short m_generation;
@@ -28,6 +28,7 @@
 
 #include "BidiResolver.h"
 #include "BitmapImage.h"
+#include "DisplayList.h"
 #include "Gradient.h"
 #include "ImageBuffer.h"
 #include "IntRect.h"
@@ -81,6 +82,7 @@ private:
 GraphicsContext::GraphicsContext(PlatformGraphicsContext* platformGraphicsContext)
     : m_updatingControlTints(false)
     , m_transparencyCount(0)
+    , m_displayListRecorder(0)
 {
     platformInit(platformGraphicsContext);
 }
@@ -99,6 +101,11 @@ void GraphicsContext::save()
 
     m_stack.append(m_state);
 
+    if (isRecording()) {
+        m_displayListRecorder->save();
+        return;
+    }
+
     savePlatformState();
 }
 
@@ -114,19 +121,26 @@ void GraphicsContext::restore()
     m_state = m_stack.last();
     m_stack.removeLast();
 
+    if (isRecording()) {
+        m_displayListRecorder->restore();
+        return;
+    }
+
     restorePlatformState();
 }
 
 void GraphicsContext::setStrokeThickness(float thickness)
 {
     m_state.strokeThickness = thickness;
-    setPlatformStrokeThickness(thickness);
+    if (!isRecording())
+        setPlatformStrokeThickness(thickness);
 }
 
 void GraphicsContext::setStrokeStyle(StrokeStyle style)
 {
     m_state.strokeStyle = style;
-    setPlatformStrokeStyle(style);
+    if (!isRecording())
+        setPlatformStrokeStyle(style);
 }
 
 void GraphicsContext::setStrokeColor(const Color& color, ColorSpace colorSpace)
@@ -135,7 +149,8 @@ void GraphicsContext::setStrokeColor(const Color& color, ColorSpace colorSpace)
     m_state.strokeColorSpace = colorSpace;
     m_state.strokeGradient.clear();
     m_state.strokePattern.clear();
-    setPlatformStrokeColor(color, colorSpace);
+    if (!isRecording())
+        setPlatformStrokeColor(color, colorSpace);
 }
 
 void GraphicsContext::setShadow(const FloatSize& offset, float blur, const Color& color, ColorSpace colorSpace)
@@ -144,7 +159,8 @@ void GraphicsContext::setShadow(const FloatSize& offset, float blur, const Color
     m_state.shadowBlur = blur;
     m_state.shadowColor = color;
     m_state.shadowColorSpace = colorSpace;
-    setPlatformShadow(offset, blur, color, colorSpace);
+    if (!isRecording())
+        setPlatformShadow(offset, blur, color, colorSpace);
 }
 
 void GraphicsContext::setLegacyShadow(const FloatSize& offset, float blur, const Color& color, ColorSpace colorSpace)
@@ -156,7 +172,8 @@ void GraphicsContext::setLegacyShadow(const FloatSize& offset, float blur, const
 #if USE(CG)
     m_state.shadowsUseLegacyRadius = true;
 #endif
-    setPlatformShadow(offset, blur, color, colorSpace);
+    if (!isRecording())
+        setPlatformShadow(offset, blur, color, colorSpace);
 }
 
 void GraphicsContext::clearShadow()
@@ -165,7 +182,8 @@ void GraphicsContext::clearShadow()
     m_state.shadowBlur = 0;
     m_state.shadowColor = Color();
     m_state.shadowColorSpace = ColorSpaceDeviceRGB;
-    clearPlatformShadow();
+    if (!isRecording())
+        clearPlatformShadow();
 }
 
 bool GraphicsContext::hasShadow() const
@@ -243,7 +261,8 @@ void GraphicsContext::setFillColor(const Color& color, ColorSpace colorSpace)
     m_state.fillColorSpace = colorSpace;
     m_state.fillGradient.clear();
     m_state.fillPattern.clear();
-    setPlatformFillColor(color, colorSpace);
+    if (!isRecording())
+        setPlatformFillColor(color, colorSpace);
 }
 
 Color GraphicsContext::fillColor() const
@@ -259,7 +278,8 @@ ColorSpace GraphicsContext::fillColorSpace() const
 void GraphicsContext::setShouldAntialias(bool b)
 {
     m_state.shouldAntialias = b;
-    setPlatformShouldAntialias(b);
+    if (!isRecording())
+        setPlatformShouldAntialias(b);
 }
 
 bool GraphicsContext::shouldAntialias() const
@@ -270,7 +290,8 @@ bool GraphicsContext::shouldAntialias() const
 void GraphicsContext::setShouldSmoothFonts(bool b)
 {
     m_state.shouldSmoothFonts = b;
-    setPlatformShouldSmoothFonts(b);
+    if (!isRecording())
+        setPlatformShouldSmoothFonts(b);
 }
 
 bool GraphicsContext::shouldSmoothFonts() const
@@ -369,13 +390,19 @@ bool GraphicsContext::shadowsIgnoreTransforms() const
 
 void GraphicsContext::beginTransparencyLayer(float opacity)
 {
-    beginPlatformTransparencyLayer(opacity);
+    if (isRecording())
+        m_displayListRecorder->beginTransparencyLayer(opacity);
+    else
+        beginPlatformTransparencyLayer(opacity);
     ++m_transparencyCount;
 }
 
 void GraphicsContext::endTransparencyLayer()
 {
-    endPlatformTransparencyLayer();
+    if (isRecording())
+        m_displayListRecorder->endTransparencyLayer();
+    else
+        endPlatformTransparencyLayer();
     ASSERT(m_transparencyCount > 0);
     --m_transparencyCount;
 }
@@ -408,12 +435,24 @@ bool GraphicsContext::paintingDisabled() const
     return m_state.paintingDisabled;
 }
 
+void GraphicsContext::setDisplayListRecorder(DisplayListRecorder* recorder)
+{
+    ASSERT(isRecording() || !platformContext());
+    m_displayListRecorder = recorder;
+    setPaintingDisabled(!recorder);
+}
+
 #if !USE(WINGDI)
 void GraphicsContext::drawText(const Font& font, const TextRun& run, const FloatPoint& point, int from, int to)
 {
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawText(font, run, point, from, to);
+        return;
+    }
+
     font.drawText(this, run, point, from, to);
 }
 #endif
@@ -423,6 +462,11 @@ void GraphicsContext::drawEmphasisMarks(const Font& font, const TextRun& run, co
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawEmphasisMarks(font, run, mark, point, from, to);
+        return;
+    }
+
     font.drawEmphasisMarks(this, run, mark, point, from, to);
 }
 
@@ -431,6 +475,11 @@ void GraphicsContext::drawBidiText(const Font& font, const TextRun& run, const F
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawBidiText(font, run, point, customFontNotReadyAction);
+        return;
+    }
+
     BidiResolver<TextRunIterator, BidiCharacterRun> bidiResolver;
     bidiResolver.setStatus(BidiStatus(run.direction(), run.directionalOverride()));
     bidiResolver.setPositionIgnoringNestedIsolates(TextRunIterator(&run, 0));
@@ -504,6 +553,11 @@ void GraphicsContext::drawImage(Image* image, ColorSpace styleColorSpace, const
 {    if (paintingDisabled() || !image)
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawImage(image, styleColorSpace, dest, src, op, blendMode, shouldRespectImageOrientation, useLowQualityScale);
+        return;
+    }
+
     InterpolationQuality previousInterpolationQuality = InterpolationDefault;
 
     if (useLowQualityScale) {
@@ -523,6 +577,11 @@ void GraphicsContext::drawTiledImage(Image* image, ColorSpace styleColorSpace, c
     if (paintingDisabled() || !image)
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawTiledImage(image, styleColorSpace, destRect, srcPoint, tileSize, op, useLowQualityScale, blendMode);
+        return;
+    }
+
     if (useLowQualityScale) {
         InterpolationQuality previousInterpolationQuality = imageInterpolationQuality();
         setImageInterpolationQuality(InterpolationLow);
@@ -544,6 +603,11 @@ void GraphicsContext::drawTiledImage(Image* image, ColorSpace styleColorSpace, c
         return;
     }
 
+    if (isRecording()) {
+        m_displayListRecorder->drawTiledImage(image, styleColorSpace, dest, srcRect, tileScaleFactor, hRule, vRule, op, useLowQualityScale);
+        return;
+    }
+
     if (useLowQualityScale) {
         InterpolationQuality previousInterpolationQuality = imageInterpolationQuality();
         setImageInterpolationQuality(InterpolationLow);
@@ -589,6 +653,11 @@ void GraphicsContext::drawImageBuffer(ImageBuffer* image, ColorSpace styleColorS
     if (paintingDisabled() || !image)
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawImageBuffer(image, styleColorSpace, dest, src, op, blendMode, useLowQualityScale);
+        return;
+    }
+
     if (useLowQualityScale) {
         InterpolationQuality previousInterpolationQuality = imageInterpolationQuality();
         // FIXME (49002): Should be InterpolationLow
@@ -640,6 +709,13 @@ void GraphicsContext::clipToImageBuffer(ImageBuffer* buffer, const FloatRect& re
 {
     if (paintingDisabled())
         return;
+
+    if (isRecording()) {
+        // Image buffer clips are applied by the platform and cannot be recorded.
+        m_displayListRecorder->markIncomplete();
+        return;
+    }
+
     buffer->clip(this, rect);
 }
 
@@ -659,7 +735,7 @@ TextDrawingModeFlags GraphicsContext::textDrawingMode() const
 void GraphicsContext::setTextDrawingMode(TextDrawingModeFlags mode)
 {
     m_state.textDrawingMode = mode;
-    if (paintingDisabled())
+    if (paintingDisabled() || isRecording())
         return;
     setPlatformTextDrawingMode(mode);
 }
@@ -668,6 +744,12 @@ void GraphicsContext::fillRect(const FloatRect& rect, Gradient& gradient)
 {
     if (paintingDisabled())
         return;
+
+    if (isRecording()) {
+        m_displayListRecorder->fillRect(rect, gradient);
+        return;
+    }
+
     gradient.fill(this, rect);
 }
 
@@ -725,7 +807,8 @@ void GraphicsContext::setCompositeOperation(CompositeOperator compositeOperation
 {
     m_state.compositeOperator = compositeOperation;
     m_state.blendMode = blendMode;
-    setPlatformCompositeOperation(compositeOperation, blendMode);
+    if (!isRecording())
+        setPlatformCompositeOperation(compositeOperation, blendMode);
 }
 
 CompositeOperator GraphicsContext::compositeOperation() const
@@ -90,6 +90,7 @@ namespace WebCore {
     const int cMisspellingLinePatternGapWidth = 1;
 
     class AffineTransform;
+    class DisplayListRecorder;
     class DrawingBuffer;
     class Gradient;
     class GraphicsContextPlatformPrivate;
@@ -347,6 +348,11 @@ namespace WebCore {
         bool paintingDisabled() const;
         void setPaintingDisabled(bool);
 
+        // Used by DisplayListRecorder on the context it owns, which has no platform context:
+        // operations are appended to the recorder's display list instead of being painted.
+        void setDisplayListRecorder(DisplayListRecorder*);
+        bool isRecording() const { return m_displayListRecorder; }
+
         bool updatingControlTints() const;
         void setUpdatingControlTints(bool);
 
@@ -541,6 +547,8 @@ namespace WebCore {
         Vector<GraphicsContextState> m_stack;
         bool m_updatingControlTints;
         unsigned m_transparencyCount;
+
+        DisplayListRecorder* m_displayListRecorder;
     };
 
     class GraphicsContextStateSaver {
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PaintRecording_h
+#define PaintRecording_h
+
+#include "IntSize.h"
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+
+#if PLATFORM(QT)
+#include <QImage>
+#elif USE(CAIRO)
+#include "RefPtrCairo.h"
+#endif
+
+#if PLATFORM(QT)
+QT_BEGIN_NAMESPACE
+class QPainter;
+QT_END_NAMESPACE
+#endif
+
+namespace WebCore {
+
+class GraphicsContext;
+class IntPoint;
+#if PLATFORM(QT)
+class PaintRecordingDevice;
+#endif
+#if USE(CAIRO)
+class PlatformContextCairo;
+#endif
+
+// Captures what is drawn into context() as platform drawing commands (QPainter paths, images and
+// glyph runs, or a cairo recording surface), so that rasterizing it can happen later and on
+// another thread. Recording walks the render tree and must happen on the main thread. Once
+// endRecording() has been called, rasterize() no longer touches any WebCore state and may run on
+// any thread, as long as a single thread uses the recording at a time.
+class PaintRecording {
+    WTF_MAKE_NONCOPYABLE(PaintRecording); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Returns 0 if the platform fails to set up the recording.
+    static PassOwnPtr<PaintRecording> create(const IntSize&);
+    ~PaintRecording();
+
+    const IntSize& size() const { return m_size; }
+
+    // Null once endRecording() has been called.
+    GraphicsContext* context() const { return m_context.get(); }
+    void endRecording();
+
+    void rasterize();
+    bool isRasterized() const;
+
+    // Draws the rasterized image over |context| at |location|. Clearing the area first, where the
+    // surface has an alpha channel, is up to the caller, as it is when painting directly.
+    void drawRasterizedImage(GraphicsContext*, const IntPoint& location) const;
+
+private:
+    explicit PaintRecording(const IntSize&);
+
+    IntSize m_size;
+    OwnPtr<GraphicsContext> m_context;
+#if PLATFORM(QT)
+    OwnPtr<PaintRecordingDevice> m_device;
+    OwnPtr<QPainter> m_painter;
+    QImage m_image;
+#elif USE(CAIRO)
+    RefPtr<cairo_surface_t> m_recordingSurface;
+    OwnPtr<PlatformContextCairo> m_platformContext;
+    RefPtr<cairo_surface_t> m_image;
+#endif
+};
+
+} // namespace WebCore
+
+#endif // PaintRecording_h
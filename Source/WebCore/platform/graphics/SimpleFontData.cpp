@@ -32,6 +32,7 @@
 
 #include "Font.h"
 #include "FontCache.h"
+#include "WidthCache.h"
 #include <wtf/MathExtras.h>
 
 #if ENABLE(OPENTYPE_VERTICAL)
@@ -152,6 +153,8 @@ void SimpleFontData::platformGlyphInit()
 
 SimpleFontData::~SimpleFontData()
 {
+    WidthCache::shared().fontDataWillBeDestroyed(this);
+
     if (!m_fontData)
         platformDestroy();
 
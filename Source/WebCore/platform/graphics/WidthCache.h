@@ -29,15 +29,29 @@
 #include "TextRun.h"
 #include <wtf/Forward.h>
 #include <wtf/HashFunctions.h>
-#include <wtf/HashSet.h>
-#include <wtf/RefPtr.h>
+#include <wtf/HashMap.h>
+#include <wtf/MathExtras.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
 #include <wtf/StringHasher.h>
 
 namespace WebCore {
 
+class SimpleFontData;
 struct GlyphOverflow;
 
+// Widths of short words, shared by every Font in the process. A width only depends on the
+// primary font it was measured with when no fallback font was needed, so entries are kept in a
+// map per font and keyed by the font flags that change shaping (typesetting features, small caps,
+// orientation) and the word itself. Both the simple and the complex text code paths use it, but
+// complex text with font feature settings is not cached since they are not part of the key.
+//
+// The cache is bounded with two generations: new entries go into the current generation, and
+// once that fills up it replaces the previous one, which is dropped. Hits in the previous
+// generation are promoted, so the words that keep being measured survive, approximating LRU
+// without per-entry bookkeeping.
 class WidthCache {
+    WTF_MAKE_NONCOPYABLE(WidthCache); WTF_MAKE_FAST_ALLOCATED;
 private:
     // Used to optimize small strings as hash table keys. Avoids malloc'ing an out-of-line StringImpl.
     class SmallStringKey {
@@ -45,17 +59,20 @@ private:
         static unsigned capacity() { return s_capacity; }
 
         SmallStringKey()
-            : m_length(s_emptyValueLength)
+            : m_flags(0)
+            , m_length(s_emptyValueLength)
         {
         }
 
         SmallStringKey(WTF::HashTableDeletedValueType)
-            : m_length(s_deletedValueLength)
+            : m_flags(0)
+            , m_length(s_deletedValueLength)
         {
         }
 
-        template<typename CharacterType> SmallStringKey(CharacterType* characters, unsigned short length)
-            : m_length(length)
+        template<typename CharacterType> SmallStringKey(unsigned flags, CharacterType* characters, unsigned short length)
+            : m_flags(flags)
+            , m_length(length)
         {
             ASSERT(length <= s_capacity);
 
@@ -77,9 +94,11 @@ private:
                 hasher.addCharacter(characters[i]);
             }
 
-            m_hash = hasher.hash();
+            unsigned hashCodes[2] = { hasher.hash(), flags };
+            m_hash = StringHasher::hashMemory<sizeof(hashCodes)>(hashCodes);
         }
 
+        unsigned flags() const { return m_flags; }
         const UChar* characters() const { return m_characters; }
         unsigned short length() const { return m_length; }
         unsigned hash() const { return m_hash; }
@@ -88,11 +107,12 @@ private:
         bool isHashTableEmptyValue() const { return m_length == s_emptyValueLength; }
 
     private:
-        static const unsigned s_capacity = 15;
+        static const unsigned s_capacity = 31;
         static const unsigned s_emptyValueLength = s_capacity + 1;
         static const unsigned s_deletedValueLength = s_capacity + 2;
 
         unsigned m_hash;
+        unsigned m_flags;
         unsigned short m_length;
         UChar m_characters[s_capacity];
     };
@@ -113,16 +133,29 @@ private:
     friend bool operator==(const SmallStringKey&, const SmallStringKey&);
 
 public:
-    WidthCache()
-        : m_interval(s_maxInterval)
-        , m_countdown(m_interval)
-    {
-    }
+    struct Statistics {
+        Statistics()
+            : hits(0)
+            , misses(0)
+            , evictions(0)
+        {
+        }
 
-    float* add(const TextRun& run, float entry, bool hasKerningOrLigatures, bool hasWordSpacingOrLetterSpacing, GlyphOverflow* glyphOverflow)
+        unsigned hits;
+        unsigned misses;
+        unsigned evictions;
+    };
+
+    static WidthCache& shared();
+
+    // fontFlags describes everything besides the primary font and the text that the width depends on.
+    float* add(const SimpleFontData* primaryFont, unsigned fontFlags, const TextRun& run, float entry, bool isComplexText, bool hasFeatureSettings, bool hasKerningOrLigatures, bool hasWordSpacingOrLetterSpacing, GlyphOverflow* glyphOverflow)
     {
         // The width cache is not really profitable unless we're doing expensive glyph transformations.
-        if (!hasKerningOrLigatures)
+        if (!hasKerningOrLigatures && !isComplexText)
+            return 0;
+        // Feature settings change how complex text is shaped, but they are not part of the key.
+        if (isComplexText && hasFeatureSettings)
             return 0;
         // Word spacing and letter spacing can change the width of a word.
         if (hasWordSpacingOrLetterSpacing)
@@ -133,7 +166,10 @@ public:
         // If we allow tabs and a tab occurs inside a word, the width of the word varies based on its position on the line.
         if (run.allowTabs())
             return 0;
-        if (static_cast<unsigned>(run.length()) > SmallStringKey::capacity())
+        // Justified text is wider than the word itself.
+        if (run.expansion())
+            return 0;
+        if (!run.length() || static_cast<unsigned>(run.length()) > SmallStringKey::capacity())
             return 0;
 
         if (m_countdown > 0) {
@@ -141,72 +177,144 @@ public:
             return 0;
         }
 
-        return addSlowCase(run, entry);
+        unsigned flags = fontFlags << 2 | run.applyRunRounding() << 1 | run.applyWordRounding();
+        return addSlowCase(primaryFont, flags, run, entry);
     }
 
+    // Entries of a font must go away with it, since its address may be reused.
+    void fontDataWillBeDestroyed(const SimpleFontData*);
+
     void clear()
     {
-        m_singleCharMap.clear();
-        m_map.clear();
+        m_generation.clear();
+        m_previousGeneration.clear();
     }
 
+    const Statistics& statistics() const { return m_statistics; }
+
 private:
-    float* addSlowCase(const TextRun& run, float entry)
+    typedef HashMap<SmallStringKey, float, SmallStringKeyHash, SmallStringKeyHashTraits> Map;
+
+    // The words of one generation, grouped by the primary font they were measured with.
+    class Generation {
+    public:
+        Generation()
+            : m_size(0)
+        {
+        }
+
+        unsigned size() const { return m_size; }
+
+        Map* find(const SimpleFontData* fontData, const SmallStringKey& key, Map::iterator& it)
+        {
+            Map* map = m_maps.get(fontData);
+            if (!map)
+                return 0;
+            it = map->find(key);
+            return it == map->end() ? 0 : map;
+        }
+
+        Map::iterator add(const SimpleFontData* fontData, const SmallStringKey& key, float entry)
+        {
+            OwnPtr<Map>& map = m_maps.add(fontData, nullptr).iterator->value;
+            if (!map)
+                map = adoptPtr(new Map);
+            ++m_size;
+            return map->add(key, entry).iterator;
+        }
+
+        void remove(const SimpleFontData* fontData, Map* map, Map::iterator it)
+        {
+            map->remove(it);
+            --m_size;
+            if (map->isEmpty())
+                m_maps.remove(fontData);
+        }
+
+        void removeFont(const SimpleFontData* fontData)
+        {
+            OwnPtr<Map> map = m_maps.take(fontData);
+            if (map)
+                m_size -= map->size();
+        }
+
+        void swap(Generation& other)
+        {
+            m_maps.swap(other.m_maps);
+            std::swap(m_size, other.m_size);
+        }
+
+        void clear()
+        {
+            m_maps.clear();
+            m_size = 0;
+        }
+
+    private:
+        HashMap<const SimpleFontData*, OwnPtr<Map> > m_maps;
+        unsigned m_size;
+    };
+
+    WidthCache()
+        : m_interval(s_maxInterval)
+        , m_countdown(m_interval)
+    {
+    }
+
+    float* addSlowCase(const SimpleFontData* primaryFont, unsigned flags, const TextRun& run, float entry)
     {
-        int length = run.length();
-        bool isNewEntry;
-        float *value;
-        if (length == 1) {
-            SingleCharMap::AddResult addResult = m_singleCharMap.add(run[0], entry);
-            isNewEntry = addResult.isNewEntry;
-            value = &addResult.iterator->value;
-        } else {
-            SmallStringKey smallStringKey;
-            if (run.is8Bit())
-                smallStringKey = SmallStringKey(run.characters8(), length);
-            else
-                smallStringKey = SmallStringKey(run.characters16(), length);
-
-            Map::AddResult addResult = m_map.add(smallStringKey, entry);
-            isNewEntry = addResult.isNewEntry;
-            value = &addResult.iterator->value;
+        SmallStringKey smallStringKey;
+        if (run.is8Bit())
+            smallStringKey = SmallStringKey(flags, run.characters8(), run.length());
+        else
+            smallStringKey = SmallStringKey(flags, run.characters16(), run.length());
+
+        Map::iterator it;
+        if (!m_generation.find(primaryFont, smallStringKey, it)) {
+            Map::iterator previous;
+            if (Map* previousMap = m_previousGeneration.find(primaryFont, smallStringKey, previous)) {
+                // Promote words that are still in use to the current generation.
+                entry = previous->value;
+                m_previousGeneration.remove(primaryFont, previousMap, previous);
+            }
+
+            if (m_generation.size() >= s_maxGenerationSize) {
+                m_statistics.evictions += m_previousGeneration.size();
+                m_previousGeneration.swap(m_generation);
+                m_generation.clear();
+            }
+            it = m_generation.add(primaryFont, smallStringKey, entry);
         }
 
         // Cache hit: ramp up by sampling the next few words.
-        if (!isNewEntry) {
+        if (!std::isnan(it->value)) {
+            ++m_statistics.hits;
             m_interval = s_minInterval;
-            return value;
+            return &it->value;
         }
 
         // Cache miss: ramp down by increasing our sampling interval.
+        ++m_statistics.misses;
         if (m_interval < s_maxInterval)
             ++m_interval;
         m_countdown = m_interval;
-
-        if ((m_singleCharMap.size() + m_map.size()) < s_maxSize)
-            return value;
-
-        // No need to be fancy: we're just trying to avoid pathological growth.
-        m_singleCharMap.clear();
-        m_map.clear();
-        return 0;
+        return &it->value;
     }
 
-    typedef HashMap<SmallStringKey, float, SmallStringKeyHash, SmallStringKeyHashTraits> Map;
-    typedef HashMap<uint32_t, float, DefaultHash<uint32_t>::Hash, WTF::UnsignedWithZeroKeyHashTraits<uint32_t> > SingleCharMap;
     static const int s_minInterval = -3; // A cache hit pays for about 3 cache misses.
     static const int s_maxInterval = 20; // Sampling at this interval has almost no overhead.
-    static const int s_maxSize = 500000; // Just enough to guard against pathological growth.
+    static const unsigned s_maxGenerationSize = 16384; // Bounds both generations to a few megabytes.
 
     int m_interval;
     int m_countdown;
-    SingleCharMap m_singleCharMap;
-    Map m_map;
+    Generation m_generation;
+    Generation m_previousGeneration;
+    Statistics m_statistics;
 };
 
 inline bool operator==(const WidthCache::SmallStringKey& a, const WidthCache::SmallStringKey& b)
 {
-    if (a.length() != b.length())
+    if (a.length() != b.length() || a.flags() != b.flags())
         return false;
     return WTF::equal(a.characters(), b.characters(), a.length());
 }
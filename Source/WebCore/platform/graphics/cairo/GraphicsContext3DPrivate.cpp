@@ -145,6 +145,12 @@ void GraphicsContext3DPrivate::paintToTextureMapper(TextureMapper* textureMapper
     texmapGL->drawTexture(m_context->m_texture, flags, textureSize, targetRect, matrix, opacity);
 #endif // USE(ACCELERATED_COMPOSITING_GL)
 }
+
+bool GraphicsContext3DPrivate::isOpaque() const
+{
+    // Without an alpha channel the drawing buffer is painted without blending.
+    return !m_context->m_attrs.alpha;
+}
 #endif // USE(ACCELERATED_COMPOSITING)
 
 } // namespace WebCore
@@ -45,6 +45,7 @@ public:
 
 #if USE(ACCELERATED_COMPOSITING) && USE(TEXTURE_MAPPER)
     virtual void paintToTextureMapper(TextureMapper*, const FloatRect& target, const TransformationMatrix&, float opacity);
+    virtual bool isOpaque() const;
 #endif
 
 private:
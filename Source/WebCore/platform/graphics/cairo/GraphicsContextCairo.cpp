@@ -37,6 +37,7 @@
 
 #include "AffineTransform.h"
 #include "CairoUtilities.h"
+#include "DisplayList.h"
 #include "DrawErrorUnderline.h"
 #include "FloatConversion.h"
 #include "FloatRect.h"
@@ -172,7 +173,8 @@ static inline void shadowAndStrokeCurrentCairoPath(GraphicsContext* context)
 
 GraphicsContext::GraphicsContext(cairo_t* cr)
     : m_updatingControlTints(false),
-      m_transparencyCount(0)
+      m_transparencyCount(0),
+      m_displayListRecorder(0)
 {
     m_data = new GraphicsContextPlatformPrivateToplevel(new PlatformContextCairo(cr));
 }
@@ -196,6 +198,9 @@ AffineTransform GraphicsContext::getCTM(IncludeDeviceScale) const
     if (paintingDisabled())
         return AffineTransform();
 
+    if (isRecording())
+        return m_displayListRecorder->getCTM();
+
     cairo_t* cr = platformContext()->cr();
     cairo_matrix_t m;
     cairo_get_matrix(cr, &m);
@@ -204,6 +209,8 @@ AffineTransform GraphicsContext::getCTM(IncludeDeviceScale) const
 
 PlatformContextCairo* GraphicsContext::platformContext() const
 {
+    if (isRecording())
+        return m_displayListRecorder->platformContextForExternalPainting();
     return m_data->platformContext;
 }
 
@@ -231,6 +238,11 @@ void GraphicsContext::drawRect(const IntRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawRect(rect);
+        return;
+    }
+
     ASSERT(!rect.isEmpty());
 
     cairo_t* cr = platformContext()->cr();
@@ -333,6 +345,11 @@ void GraphicsContext::drawLine(const IntPoint& point1, const IntPoint& point2)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawLine(point1, point2);
+        return;
+    }
+
     cairo_t* cairoContext = platformContext()->cr();
     cairo_save(cairoContext);
     drawLineOnCairoContext(this, cairoContext, point1, point2);
@@ -345,6 +362,11 @@ void GraphicsContext::drawEllipse(const IntRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawEllipse(rect);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     cairo_save(cr);
     float yRadius = .5 * rect.height();
@@ -372,6 +394,11 @@ void GraphicsContext::drawConvexPolygon(size_t npoints, const FloatPoint* points
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawConvexPolygon(npoints, points, shouldAntialias);
+        return;
+    }
+
     if (npoints <= 1)
         return;
 
@@ -402,6 +429,11 @@ void GraphicsContext::clipConvexPolygon(size_t numPoints, const FloatPoint* poin
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipConvexPolygon(numPoints, points, antialiased);
+        return;
+    }
+
     if (numPoints <= 1)
         return;
 
@@ -425,6 +457,11 @@ void GraphicsContext::fillPath(const Path& path)
     if (paintingDisabled() || path.isEmpty())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillPath(path);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     setPathOnCairoContext(cr, path.platformPath()->context());
     shadowAndFillCurrentCairoPath(this);
@@ -435,6 +472,11 @@ void GraphicsContext::strokePath(const Path& path)
     if (paintingDisabled() || path.isEmpty())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->strokePath(path);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     setPathOnCairoContext(cr, path.platformPath()->context());
     shadowAndStrokeCurrentCairoPath(this);
@@ -445,16 +487,26 @@ void GraphicsContext::fillRect(const FloatRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillRect(rect);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     cairo_rectangle(cr, rect.x(), rect.y(), rect.width(), rect.height());
     shadowAndFillCurrentCairoPath(this);
 }
 
-void GraphicsContext::fillRect(const FloatRect& rect, const Color& color, ColorSpace)
+void GraphicsContext::fillRect(const FloatRect& rect, const Color& color, ColorSpace colorSpace)
 {
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillRect(rect, color, colorSpace);
+        return;
+    }
+
     if (hasShadow())
         platformContext()->shadowBlur().drawRectShadow(this, rect, RoundedRect::Radii());
 
@@ -466,6 +518,11 @@ void GraphicsContext::clip(const FloatRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clip(rect);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     cairo_rectangle(cr, rect.x(), rect.y(), rect.width(), rect.height());
     cairo_fill_rule_t savedFillRule = cairo_get_fill_rule(cr);
@@ -488,6 +545,11 @@ void GraphicsContext::clipPath(const Path& path, WindRule clipRule)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipPath(path, clipRule);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     if (!path.isNull())
         setPathOnCairoContext(cr, path.platformPath()->context());
@@ -497,6 +559,9 @@ void GraphicsContext::clipPath(const Path& path, WindRule clipRule)
 
 IntRect GraphicsContext::clipBounds() const
 {
+    if (isRecording())
+        return m_displayListRecorder->clipBounds();
+
     double x1, x2, y1, y2;
     cairo_clip_extents(platformContext()->cr(), &x1, &y1, &x2, &y2);
     return enclosingIntRect(FloatRect(x1, y1, x2 - x1, y2 - y1));
@@ -528,8 +593,13 @@ static inline StrokeStyle focusRingStrokeStyle()
 #endif
 }
 
-void GraphicsContext::drawFocusRing(const Path& path, int width, int /* offset */, const Color& color)
+void GraphicsContext::drawFocusRing(const Path& path, int width, int offset, const Color& color)
 {
+    if (isRecording()) {
+        m_displayListRecorder->drawFocusRing(path, width, offset, color);
+        return;
+    }
+
     // FIXME: We should draw paths that describe a rectangle with rounded corners
     // so as to be consistent with how we draw rectangular focus rings.
     Color ringColor = color;
@@ -546,11 +616,16 @@ void GraphicsContext::drawFocusRing(const Path& path, int width, int /* offset *
     cairo_restore(cr);
 }
 
-void GraphicsContext::drawFocusRing(const Vector<IntRect>& rects, int width, int /* offset */, const Color& color)
+void GraphicsContext::drawFocusRing(const Vector<IntRect>& rects, int width, int offset, const Color& color)
 {
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawFocusRing(rects, width, offset, color);
+        return;
+    }
+
     unsigned rectCount = rects.size();
 
     cairo_t* cr = platformContext()->cr();
@@ -610,11 +685,16 @@ void GraphicsContext::drawFocusRing(const Vector<IntRect>& rects, int width, int
     cairo_restore(cr);
 }
 
-void GraphicsContext::drawLineForText(const FloatPoint& origin, float width, bool)
+void GraphicsContext::drawLineForText(const FloatPoint& origin, float width, bool printing)
 {
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawLineForText(origin, width, printing);
+        return;
+    }
+
     cairo_t* cairoContext = platformContext()->cr();
     cairo_save(cairoContext);
 
@@ -637,6 +717,11 @@ void GraphicsContext::drawLineForDocumentMarker(const FloatPoint& origin, float
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawLineForDocumentMarker(origin, width, style);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     cairo_save(cr);
 
@@ -659,6 +744,9 @@ void GraphicsContext::drawLineForDocumentMarker(const FloatPoint& origin, float
 
 FloatRect GraphicsContext::roundToDevicePixels(const FloatRect& frect, RoundingMode)
 {
+    if (isRecording())
+        return m_displayListRecorder->roundToDevicePixels(frect);
+
     FloatRect result;
     double x = frect.x();
     double y = frect.y();
@@ -699,6 +787,11 @@ void GraphicsContext::translate(float x, float y)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->translate(x, y);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     cairo_translate(cr, x, y);
     m_data->translate(x, y);
@@ -763,6 +856,11 @@ void GraphicsContext::concatCTM(const AffineTransform& transform)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->concatCTM(transform);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     const cairo_matrix_t matrix = cairo_matrix_t(transform);
     cairo_transform(cr, &matrix);
@@ -774,6 +872,11 @@ void GraphicsContext::setCTM(const AffineTransform& transform)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->setCTM(transform);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     const cairo_matrix_t matrix = cairo_matrix_t(transform);
     cairo_set_matrix(cr, &matrix);
@@ -839,6 +942,11 @@ void GraphicsContext::clearRect(const FloatRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clearRect(rect);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
 
     cairo_save(cr);
@@ -853,6 +961,11 @@ void GraphicsContext::strokeRect(const FloatRect& rect, float width)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->strokeRect(rect, width);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     cairo_save(cr);
     cairo_rectangle(cr, rect.x(), rect.y(), rect.width(), rect.height());
@@ -866,6 +979,11 @@ void GraphicsContext::setLineCap(LineCap lineCap)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->setLineCap(lineCap);
+        return;
+    }
+
     cairo_line_cap_t cairoCap = CAIRO_LINE_CAP_BUTT;
     switch (lineCap) {
     case ButtCap:
@@ -883,6 +1001,11 @@ void GraphicsContext::setLineCap(LineCap lineCap)
 
 void GraphicsContext::setLineDash(const DashArray& dashes, float dashOffset)
 {
+    if (isRecording()) {
+        m_displayListRecorder->setLineDash(dashes, dashOffset);
+        return;
+    }
+
     cairo_set_dash(platformContext()->cr(), dashes.data(), dashes.size(), dashOffset);
 }
 
@@ -891,6 +1014,11 @@ void GraphicsContext::setLineJoin(LineJoin lineJoin)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->setLineJoin(lineJoin);
+        return;
+    }
+
     cairo_line_join_t cairoJoin = CAIRO_LINE_JOIN_MITER;
     switch (lineJoin) {
     case MiterJoin:
@@ -911,11 +1039,21 @@ void GraphicsContext::setMiterLimit(float miter)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->setMiterLimit(miter);
+        return;
+    }
+
     cairo_set_miter_limit(platformContext()->cr(), miter);
 }
 
 void GraphicsContext::setAlpha(float alpha)
 {
+    if (isRecording()) {
+        m_displayListRecorder->setAlpha(alpha);
+        return;
+    }
+
     platformContext()->setGlobalAlpha(alpha);
 }
 
@@ -938,6 +1076,11 @@ void GraphicsContext::clip(const Path& path, WindRule windRule)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipPath(path, windRule);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     OwnPtr<cairo_path_t> pathCopy;
     if (!path.isNull()) {
@@ -956,6 +1099,11 @@ void GraphicsContext::clip(const Path& path, WindRule windRule)
 
 void GraphicsContext::canvasClip(const Path& path, WindRule windRule)
 {
+    if (isRecording()) {
+        m_displayListRecorder->canvasClip(path, windRule);
+        return;
+    }
+
     clip(path, windRule);
 }
 
@@ -964,6 +1112,11 @@ void GraphicsContext::clipOut(const Path& path)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipOut(path);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     double x1, y1, x2, y2;
     cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
@@ -981,6 +1134,11 @@ void GraphicsContext::rotate(float radians)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->rotate(radians);
+        return;
+    }
+
     cairo_rotate(platformContext()->cr(), radians);
     m_data->rotate(radians);
 }
@@ -990,6 +1148,11 @@ void GraphicsContext::scale(const FloatSize& size)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->scale(size);
+        return;
+    }
+
     cairo_scale(platformContext()->cr(), size.width(), size.height());
     m_data->scale(size);
 }
@@ -999,6 +1162,11 @@ void GraphicsContext::clipOut(const IntRect& r)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipOut(r);
+        return;
+    }
+
     cairo_t* cr = platformContext()->cr();
     double x1, y1, x2, y2;
     cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
@@ -1018,11 +1186,16 @@ static inline FloatPoint getPhase(const FloatRect& dest, const FloatRect& tile)
     return phase;
 }
 
-void GraphicsContext::fillRoundedRect(const IntRect& r, const IntSize& topLeft, const IntSize& topRight, const IntSize& bottomLeft, const IntSize& bottomRight, const Color& color, ColorSpace)
+void GraphicsContext::fillRoundedRect(const IntRect& r, const IntSize& topLeft, const IntSize& topRight, const IntSize& bottomLeft, const IntSize& bottomRight, const Color& color, ColorSpace colorSpace)
 {
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillRoundedRect(r, topLeft, topRight, bottomLeft, bottomRight, color, colorSpace);
+        return;
+    }
+
     if (hasShadow())
         platformContext()->shadowBlur().drawRectShadow(this, r, RoundedRect::Radii(topLeft, topRight, bottomLeft, bottomRight));
 
@@ -1069,16 +1242,27 @@ void GraphicsContext::setPlatformShouldAntialias(bool enable)
 
 void GraphicsContext::setImageInterpolationQuality(InterpolationQuality quality)
 {
+    if (isRecording()) {
+        m_displayListRecorder->setImageInterpolationQuality(quality);
+        return;
+    }
+
     platformContext()->setImageInterpolationQuality(quality);
 }
 
 InterpolationQuality GraphicsContext::imageInterpolationQuality() const
 {
+    if (isRecording())
+        return m_displayListRecorder->imageInterpolationQuality();
+
     return platformContext()->imageInterpolationQuality();
 }
 
 bool GraphicsContext::isAcceleratedContext() const
 {
+    if (isRecording())
+        return false;
+
     return cairo_surface_get_type(cairo_get_target(platformContext()->cr())) == CAIRO_SURFACE_TYPE_GL;
 }
 
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "PaintRecording.h"
+
+#include "GraphicsContext.h"
+#include "IntPoint.h"
+#include "PlatformContextCairo.h"
+#include <cairo.h>
+
+namespace WebCore {
+
+PassOwnPtr<PaintRecording> PaintRecording::create(const IntSize& size)
+{
+    OwnPtr<PaintRecording> recording = adoptPtr(new PaintRecording(size));
+    if (!recording->m_context)
+        return nullptr;
+    return recording.release();
+}
+
+PaintRecording::PaintRecording(const IntSize& size)
+    : m_size(size)
+{
+    cairo_rectangle_t extents = { 0, 0, static_cast<double>(size.width()), static_cast<double>(size.height()) };
+    m_recordingSurface = adoptRef(cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents));
+    if (cairo_surface_status(m_recordingSurface.get()) != CAIRO_STATUS_SUCCESS)
+        return;
+
+    RefPtr<cairo_t> cr = adoptRef(cairo_create(m_recordingSurface.get()));
+    m_platformContext = adoptPtr(new PlatformContextCairo(cr.get()));
+    m_context = adoptPtr(new GraphicsContext(m_platformContext.get()));
+}
+
+PaintRecording::~PaintRecording()
+{
+}
+
+void PaintRecording::endRecording()
+{
+    m_context.clear();
+    m_platformContext.clear();
+}
+
+void PaintRecording::rasterize()
+{
+    ASSERT(!m_context);
+    m_image = adoptRef(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, m_size.width(), m_size.height()));
+
+    RefPtr<cairo_t> cr = adoptRef(cairo_create(m_image.get()));
+    cairo_set_source_surface(cr.get(), m_recordingSurface.get(), 0, 0);
+    cairo_paint(cr.get());
+
+    // The commands are not needed anymore, and the surfaces they reference can go away.
+    m_recordingSurface = 0;
+}
+
+bool PaintRecording::isRasterized() const
+{
+    return m_image.get();
+}
+
+void PaintRecording::drawRasterizedImage(GraphicsContext* context, const IntPoint& location) const
+{
+    ASSERT(isRasterized());
+    cairo_t* cr = context->platformContext()->cr();
+    cairo_save(cr);
+    cairo_set_source_surface(cr, m_image.get(), location.x(), location.y());
+    cairo_rectangle(cr, location.x(), location.y(), m_size.width(), m_size.height());
+    cairo_fill(cr);
+    cairo_restore(cr);
+}
+
+} // namespace WebCore
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEColorMatrixSSE2_h
+#define FEColorMatrixSSE2_h
+
+#if ENABLE(FILTERS) && defined(__SSE2__)
+
+#include "FEColorMatrix.h"
+#include "SSE2Helpers.h"
+
+namespace WebCore {
+
+// Each output channel is its own lane, and the lanes are summed in the same order as the scalar
+// matrix() and saturateAndHueRotate(), so the results are identical.
+
+inline void colorMatrixSSE2(unsigned char* pixels, unsigned pixelCount, const float* values)
+{
+    __m128 redColumn = _mm_setr_ps(values[0], values[5], values[10], values[15]);
+    __m128 greenColumn = _mm_setr_ps(values[1], values[6], values[11], values[16]);
+    __m128 blueColumn = _mm_setr_ps(values[2], values[7], values[12], values[17]);
+    __m128 alphaColumn = _mm_setr_ps(values[3], values[8], values[13], values[18]);
+    __m128 offset = _mm_setr_ps(values[4] * 255, values[9] * 255, values[14] * 255, values[19] * 255);
+
+    uint32_t* pixel = reinterpret_cast<uint32_t*>(pixels);
+    uint32_t* end = pixel + pixelCount;
+    for (; pixel < end; ++pixel) {
+        __m128 color = loadRGBA8AsFloat(pixel);
+        __m128 result = _mm_mul_ps(redColumn, _mm_shuffle_ps(color, color, _MM_SHUFFLE(0, 0, 0, 0)));
+        result = _mm_add_ps(result, _mm_mul_ps(greenColumn, _mm_shuffle_ps(color, color, _MM_SHUFFLE(1, 1, 1, 1))));
+        result = _mm_add_ps(result, _mm_mul_ps(blueColumn, _mm_shuffle_ps(color, color, _MM_SHUFFLE(2, 2, 2, 2))));
+        result = _mm_add_ps(result, _mm_mul_ps(alphaColumn, _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3))));
+        result = _mm_add_ps(result, offset);
+        storeFloatAsClampedRGBA8(result, pixel);
+    }
+}
+
+inline void saturateAndHueRotateSSE2(unsigned char* pixels, unsigned pixelCount, const float* components)
+{
+    __m128 redColumn = _mm_setr_ps(components[0], components[3], components[6], 0);
+    __m128 greenColumn = _mm_setr_ps(components[1], components[4], components[7], 0);
+    __m128 blueColumn = _mm_setr_ps(components[2], components[5], components[8], 0);
+    __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+    uint32_t* pixel = reinterpret_cast<uint32_t*>(pixels);
+    uint32_t* end = pixel + pixelCount;
+    for (; pixel < end; ++pixel) {
+        __m128 color = loadRGBA8AsFloat(pixel);
+        __m128 result = _mm_mul_ps(_mm_shuffle_ps(color, color, _MM_SHUFFLE(0, 0, 0, 0)), redColumn);
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(color, color, _MM_SHUFFLE(1, 1, 1, 1)), greenColumn));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(color, color, _MM_SHUFFLE(2, 2, 2, 2)), blueColumn));
+        // Alpha passes through unchanged.
+        result = _mm_or_ps(_mm_andnot_ps(alphaMask, result), _mm_and_ps(alphaMask, color));
+        storeFloatAsClampedRGBA8(result, pixel);
+    }
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS) && defined(__SSE2__)
+
+#endif // FEColorMatrixSSE2_h
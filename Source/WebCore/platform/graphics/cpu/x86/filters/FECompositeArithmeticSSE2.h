@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FECompositeArithmeticSSE2_h
+#define FECompositeArithmeticSSE2_h
+
+#if ENABLE(FILTERS) && defined(__SSE2__)
+
+#include "FEComposite.h"
+#include <emmintrin.h>
+
+namespace WebCore {
+
+// Evaluates k1 * i1 * i2 + k2 * i1 + k3 * i2 + k4 with the same operation order as the scalar
+// computeArithmeticPixels(), sixteen components at a time.
+template <int b1, int b4>
+inline __m128 computeArithmeticSSE2(__m128i source, __m128i destination, __m128 k1x4, __m128 k2x4, __m128 k3x4, __m128 k4x4)
+{
+    __m128 i1 = _mm_cvtepi32_ps(source);
+    __m128 i2 = _mm_cvtepi32_ps(destination);
+    __m128 result = _mm_add_ps(_mm_mul_ps(k2x4, i1), _mm_mul_ps(k3x4, i2));
+    if (b1)
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(k1x4, i1), i2));
+    if (b4)
+        result = _mm_add_ps(result, k4x4);
+    // Clamp to [0, 255], then truncate like the conversion to unsigned char.
+    return _mm_min_ps(_mm_max_ps(result, _mm_setzero_ps()), _mm_set1_ps(255));
+}
+
+template <int b1, int b4>
+inline void FEComposite::computeArithmeticPixelsSSE2(unsigned char* source, unsigned char* destination,
+    unsigned pixelArrayLength, float k1, float k2, float k3, float k4)
+{
+    float scaledK1 = b1 ? k1 / 255.0f : 0;
+    float scaledK4 = b4 ? k4 * 255.0f : 0;
+    __m128 k1x4 = _mm_set1_ps(scaledK1);
+    __m128 k2x4 = _mm_set1_ps(k2);
+    __m128 k3x4 = _mm_set1_ps(k3);
+    __m128 k4x4 = _mm_set1_ps(scaledK4);
+    __m128i zero = _mm_setzero_si128();
+
+    unsigned char* end = destination + (pixelArrayLength & ~15);
+    while (destination < end) {
+        __m128i sourceBytes = _mm_loadu_si128(reinterpret_cast<__m128i*>(source));
+        __m128i destinationBytes = _mm_loadu_si128(reinterpret_cast<__m128i*>(destination));
+        __m128i sourceLow = _mm_unpacklo_epi8(sourceBytes, zero);
+        __m128i sourceHigh = _mm_unpackhi_epi8(sourceBytes, zero);
+        __m128i destinationLow = _mm_unpacklo_epi8(destinationBytes, zero);
+        __m128i destinationHigh = _mm_unpackhi_epi8(destinationBytes, zero);
+
+        __m128i result0 = _mm_cvttps_epi32(computeArithmeticSSE2<b1, b4>(_mm_unpacklo_epi16(sourceLow, zero), _mm_unpacklo_epi16(destinationLow, zero), k1x4, k2x4, k3x4, k4x4));
+        __m128i result1 = _mm_cvttps_epi32(computeArithmeticSSE2<b1, b4>(_mm_unpackhi_epi16(sourceLow, zero), _mm_unpackhi_epi16(destinationLow, zero), k1x4, k2x4, k3x4, k4x4));
+        __m128i result2 = _mm_cvttps_epi32(computeArithmeticSSE2<b1, b4>(_mm_unpacklo_epi16(sourceHigh, zero), _mm_unpacklo_epi16(destinationHigh, zero), k1x4, k2x4, k3x4, k4x4));
+        __m128i result3 = _mm_cvttps_epi32(computeArithmeticSSE2<b1, b4>(_mm_unpackhi_epi16(sourceHigh, zero), _mm_unpackhi_epi16(destinationHigh, zero), k1x4, k2x4, k3x4, k4x4));
+
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(result0, result1), _mm_packs_epi32(result2, result3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), packed);
+        source += 16;
+        destination += 16;
+    }
+
+    unsigned remainder = pixelArrayLength & 15;
+    while (remainder--) {
+        float i1 = *source;
+        float i2 = *destination;
+        float result = k2 * i1 + k3 * i2;
+        if (b1)
+            result += scaledK1 * i1 * i2;
+        if (b4)
+            result += scaledK4;
+
+        if (result <= 0)
+            *destination = 0;
+        else if (result >= 255)
+            *destination = 255;
+        else
+            *destination = result;
+        ++source;
+        ++destination;
+    }
+}
+
+inline void FEComposite::platformArithmeticSSE2(unsigned char* source, unsigned char* destination,
+    unsigned pixelArrayLength, float k1, float k2, float k3, float k4)
+{
+    if (!k4) {
+        if (!k1) {
+            computeArithmeticPixelsSSE2<0, 0>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+            return;
+        }
+
+        computeArithmeticPixelsSSE2<1, 0>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+        return;
+    }
+
+    if (!k1) {
+        computeArithmeticPixelsSSE2<0, 1>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+        return;
+    }
+    computeArithmeticPixelsSSE2<1, 1>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS) && defined(__SSE2__)
+
+#endif // FECompositeArithmeticSSE2_h
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SSE2Helpers_h
+#define SSE2Helpers_h
+
+#if ENABLE(FILTERS) && defined(__SSE2__)
+
+#include <emmintrin.h>
+#include <stdint.h>
+
+namespace WebCore {
+
+inline __m128i loadRGBA8AsInt32(const uint32_t* source)
+{
+    __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*source), zero), zero);
+}
+
+inline __m128 loadRGBA8AsFloat(const uint32_t* source)
+{
+    return _mm_cvtepi32_ps(loadRGBA8AsInt32(source));
+}
+
+// The components must already be in the [0, 255] range.
+inline void storeInt32AsRGBA8(__m128i data, uint32_t* destination)
+{
+    __m128i packed = _mm_packs_epi32(data, data);
+    *destination = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+}
+
+// Clamps to [0, 255] and rounds to nearest like Uint8ClampedArray::set(); NaN becomes 0.
+inline void storeFloatAsClampedRGBA8(__m128 data, uint32_t* destination)
+{
+    data = _mm_min_ps(_mm_max_ps(data, _mm_setzero_ps()), _mm_set1_ps(255));
+    storeInt32AsRGBA8(_mm_cvtps_epi32(data), destination);
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS) && defined(__SSE2__)
+
+#endif // SSE2Helpers_h
@@ -25,6 +25,7 @@
 #if ENABLE(FILTERS)
 #include "FEColorMatrix.h"
 
+#include "FEColorMatrixSSE2.h"
 #include "Filter.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
@@ -105,22 +106,25 @@ inline void luminance(float& red, float& green, float& blue, float& alpha)
     blue = 0;
 }
 
-template<ColorMatrixType filterType>
-void effectType(Uint8ClampedArray* pixelArray, const Vector<float>& values)
+static inline unsigned char clampedChannel(double value)
 {
-    unsigned pixelArrayLength = pixelArray->length();
-    float components[9];
-
-    if (filterType == FECOLORMATRIX_TYPE_SATURATE)
-        FEColorMatrix::calculateSaturateComponents(components, values[0]);
-    else if (filterType == FECOLORMATRIX_TYPE_HUEROTATE)
-        FEColorMatrix::calculateHueRotateComponents(components, values[0]);
+    // Same rounding as Uint8ClampedArray::set().
+    if (std::isnan(value) || value < 0)
+        return 0;
+    if (value > 255)
+        return 255;
+    return static_cast<unsigned char>(lrint(value));
+}
 
-    for (unsigned pixelByteOffset = 0; pixelByteOffset < pixelArrayLength; pixelByteOffset += 4) {
-        float red = pixelArray->item(pixelByteOffset);
-        float green = pixelArray->item(pixelByteOffset + 1);
-        float blue = pixelArray->item(pixelByteOffset + 2);
-        float alpha = pixelArray->item(pixelByteOffset + 3);
+template<ColorMatrixType filterType>
+static void effectType(unsigned char* pixels, unsigned pixelCount, const Vector<float>& values, const float* components)
+{
+    unsigned char* end = pixels + pixelCount * 4;
+    for (; pixels < end; pixels += 4) {
+        float red = pixels[0];
+        float green = pixels[1];
+        float blue = pixels[2];
+        float alpha = pixels[3];
 
         switch (filterType) {
             case FECOLORMATRIX_TYPE_MATRIX:
@@ -135,45 +139,70 @@ void effectType(Uint8ClampedArray* pixelArray, const Vector<float>& values)
                 break;
         }
 
-        pixelArray->set(pixelByteOffset, red);
-        pixelArray->set(pixelByteOffset + 1, green);
-        pixelArray->set(pixelByteOffset + 2, blue);
-        pixelArray->set(pixelByteOffset + 3, alpha);
+        pixels[0] = clampedChannel(red);
+        pixels[1] = clampedChannel(green);
+        pixels[2] = clampedChannel(blue);
+        pixels[3] = clampedChannel(alpha);
     }
 }
 
-void FEColorMatrix::platformApplySoftware()
+void FEColorMatrix::prepareToApplyToUnmultipliedPixels()
 {
-    FilterEffect* in = inputEffect(0);
-
-    ImageBuffer* resultImage = createImageBufferResult();
-    if (!resultImage)
-        return;
+    if (m_type == FECOLORMATRIX_TYPE_SATURATE)
+        calculateSaturateComponents(m_components, m_values[0]);
+    else if (m_type == FECOLORMATRIX_TYPE_HUEROTATE)
+        calculateHueRotateComponents(m_components, m_values[0]);
+    else if (m_type == FECOLORMATRIX_TYPE_LUMINANCETOALPHA)
+        setIsAlphaImage(true);
+}
 
-    resultImage->context()->drawImageBuffer(in->asImageBuffer(), ColorSpaceDeviceRGB, drawingRegionOfInputImage(in->absolutePaintRect()));
+void FEColorMatrix::applyToUnmultipliedPixels(unsigned char* pixels, unsigned pixelCount) const
+{
+    transformPixels(m_type, m_values, m_components, pixels, pixelCount);
+}
 
-    IntRect imageRect(IntPoint(), absolutePaintRect().size());
-    RefPtr<Uint8ClampedArray> pixelArray = resultImage->getUnmultipliedImageData(imageRect);
+void FEColorMatrix::transformPixels(ColorMatrixType type, const Vector<float>& values, const float* components, unsigned char* pixels, unsigned pixelCount, bool allowSIMD)
+{
+#if defined(__SSE2__)
+    if (allowSIMD) {
+        switch (type) {
+        case FECOLORMATRIX_TYPE_MATRIX:
+            colorMatrixSSE2(pixels, pixelCount, values.data());
+            return;
+        case FECOLORMATRIX_TYPE_SATURATE:
+        case FECOLORMATRIX_TYPE_HUEROTATE:
+            saturateAndHueRotateSSE2(pixels, pixelCount, components);
+            return;
+        default:
+            // The luminanceToAlpha matrix computes in double and stays scalar.
+            break;
+        }
+    }
+#else
+    UNUSED_PARAM(allowSIMD);
+#endif
 
-    switch (m_type) {
+    switch (type) {
     case FECOLORMATRIX_TYPE_UNKNOWN:
         break;
     case FECOLORMATRIX_TYPE_MATRIX:
-        effectType<FECOLORMATRIX_TYPE_MATRIX>(pixelArray.get(), m_values);
+        effectType<FECOLORMATRIX_TYPE_MATRIX>(pixels, pixelCount, values, components);
         break;
-    case FECOLORMATRIX_TYPE_SATURATE: 
-        effectType<FECOLORMATRIX_TYPE_SATURATE>(pixelArray.get(), m_values);
+    case FECOLORMATRIX_TYPE_SATURATE:
+        effectType<FECOLORMATRIX_TYPE_SATURATE>(pixels, pixelCount, values, components);
         break;
     case FECOLORMATRIX_TYPE_HUEROTATE:
-        effectType<FECOLORMATRIX_TYPE_HUEROTATE>(pixelArray.get(), m_values);
+        effectType<FECOLORMATRIX_TYPE_HUEROTATE>(pixels, pixelCount, values, components);
         break;
     case FECOLORMATRIX_TYPE_LUMINANCETOALPHA:
-        effectType<FECOLORMATRIX_TYPE_LUMINANCETOALPHA>(pixelArray.get(), m_values);
-        setIsAlphaImage(true);
+        effectType<FECOLORMATRIX_TYPE_LUMINANCETOALPHA>(pixels, pixelCount, values, components);
         break;
     }
+}
 
-    resultImage->putByteArray(Unmultiplied, pixelArray.get(), imageRect.size(), imageRect, IntPoint());
+void FEColorMatrix::platformApplySoftware()
+{
+    applyUnmultipliedPixelEffects(inputEffect(0), Vector<FilterEffect*>(1, this));
 }
 
 void FEColorMatrix::dump()
@@ -49,6 +49,9 @@ public:
     bool setValues(const Vector<float>&);
 
     virtual void platformApplySoftware();
+    virtual bool isUnmultipliedPixelEffect() const { return true; }
+    virtual void prepareToApplyToUnmultipliedPixels();
+    virtual void applyToUnmultipliedPixels(unsigned char*, unsigned) const;
 #if ENABLE(OPENCL)
     virtual bool platformApplyOpenCL();
 #endif
@@ -59,11 +62,19 @@ public:
     static inline void calculateSaturateComponents(float* components, float value);
     static inline void calculateHueRotateComponents(float* components, float value);
 
+    // Transforms unmultiplied pixels in place. |components| holds the nine coefficients computed by
+    // calculateSaturateComponents() or calculateHueRotateComponents() for those two types. Passing false
+    // for |allowSIMD| forces the scalar code, so that tests can check the SSE2 kernels against it.
+    static void transformPixels(ColorMatrixType, const Vector<float>& values, const float* components, unsigned char* pixels, unsigned pixelCount, bool allowSIMD = true);
+
 private:
     FEColorMatrix(Filter*, ColorMatrixType, const Vector<float>&);
 
     ColorMatrixType m_type;
     Vector<float> m_values;
+
+    // Saturate and hue rotate coefficients, computed by prepareToApplyToUnmultipliedPixels().
+    float m_components[9];
 };
 
 inline void FEColorMatrix::calculateSaturateComponents(float* components, float value)
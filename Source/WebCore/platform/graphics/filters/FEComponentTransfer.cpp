@@ -152,26 +152,20 @@ static void gamma(unsigned char* values, const ComponentTransferFunction& transf
 
 void FEComponentTransfer::platformApplySoftware()
 {
-    FilterEffect* in = inputEffect(0);
-
-    Uint8ClampedArray* pixelArray = createUnmultipliedImageResult();
-    if (!pixelArray)
-        return;
-
-    unsigned char rValues[256], gValues[256], bValues[256], aValues[256];
-    getValues(rValues, gValues, bValues, aValues);
-    unsigned char* tables[] = { rValues, gValues, bValues, aValues };
+    applyUnmultipliedPixelEffects(inputEffect(0), Vector<FilterEffect*>(1, this));
+}
 
-    IntRect drawingRect = requestedRegionOfInputImageData(in->absolutePaintRect());
-    in->copyUnmultipliedImage(pixelArray, drawingRect);
+void FEComponentTransfer::prepareToApplyToUnmultipliedPixels()
+{
+    getValues(m_tables[0], m_tables[1], m_tables[2], m_tables[3]);
+}
 
-    unsigned pixelArrayLength = pixelArray->length();
-    unsigned char* data = pixelArray->data();
-    for (unsigned pixelOffset = 0; pixelOffset < pixelArrayLength; pixelOffset += 4) {
-        for (unsigned channel = 0; channel < 4; ++channel) {
-            unsigned char c = data[pixelOffset + channel];
-            data[pixelOffset + channel] = tables[channel][c];
-        }
+void FEComponentTransfer::applyToUnmultipliedPixels(unsigned char* pixels, unsigned pixelCount) const
+{
+    unsigned char* end = pixels + pixelCount * 4;
+    for (; pixels < end; pixels += 4) {
+        for (unsigned channel = 0; channel < 4; ++channel)
+            pixels[channel] = m_tables[channel][pixels[channel]];
     }
 }
 
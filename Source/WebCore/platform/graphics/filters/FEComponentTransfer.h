@@ -79,6 +79,9 @@ public:
     void setAlphaFunction(const ComponentTransferFunction&);
 
     virtual void platformApplySoftware();
+    virtual bool isUnmultipliedPixelEffect() const { return true; }
+    virtual void prepareToApplyToUnmultipliedPixels();
+    virtual void applyToUnmultipliedPixels(unsigned char*, unsigned) const;
     virtual void dump();
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
@@ -93,6 +96,9 @@ private:
     ComponentTransferFunction m_greenFunc;
     ComponentTransferFunction m_blueFunc;
     ComponentTransferFunction m_alphaFunc;
+
+    // Lookup tables for red, green, blue and alpha, computed by prepareToApplyToUnmultipliedPixels().
+    unsigned char m_tables[4][256];
 };
 
 } // namespace WebCore
@@ -27,11 +27,13 @@
 #include "FEComposite.h"
 
 #include "FECompositeArithmeticNEON.h"
+#include "FECompositeArithmeticSSE2.h"
 #include "Filter.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
 
+#include <wtf/ParallelJobs.h>
 #include <wtf/Uint8ClampedArray.h>
 
 namespace WebCore {
@@ -214,18 +216,69 @@ static inline void arithmeticSoftware(unsigned char* source, unsigned char* dest
     }
 }
 
-inline void FEComposite::platformArithmeticSoftware(Uint8ClampedArray* source, Uint8ClampedArray* destination,
-    float k1, float k2, float k3, float k4)
+void FEComposite::platformArithmeticSoftware(unsigned char* source, unsigned char* destination, int length,
+    float k1, float k2, float k3, float k4, bool allowSIMD)
 {
-    int length = source->length();
-    ASSERT(length == static_cast<int>(destination->length()));
     // The selection here eventually should happen dynamically.
 #if HAVE(ARM_NEON_INTRINSICS)
     ASSERT(!(length & 0x3));
-    platformArithmeticNeon(source->data(), destination->data(), length, k1, k2, k3, k4);
+    if (allowSIMD) {
+        platformArithmeticNeon(source, destination, length, k1, k2, k3, k4);
+        return;
+    }
+#elif defined(__SSE2__)
+    if (allowSIMD) {
+        platformArithmeticSSE2(source, destination, length, k1, k2, k3, k4);
+        return;
+    }
 #else
-    arithmeticSoftware(source->data(), destination->data(), length, k1, k2, k3, k4);
+    UNUSED_PARAM(allowSIMD);
 #endif
+    arithmeticSoftware(source, destination, length, k1, k2, k3, k4);
+}
+
+void FEComposite::platformArithmeticWorker(PlatformApplyParameters* parameters)
+{
+    FEComposite* filter = parameters->filter;
+    filter->platformArithmeticSoftware(parameters->source, parameters->destination, parameters->length,
+        filter->m_k1, filter->m_k2, filter->m_k3, filter->m_k4);
+}
+
+inline void FEComposite::platformArithmetic(Uint8ClampedArray* source, Uint8ClampedArray* destination)
+{
+    int length = source->length();
+    ASSERT(length == static_cast<int>(destination->length()));
+
+    int pixelCount = length / 4;
+    int optimalThreadNumber = pixelCount / s_minimalRectDimension;
+    if (optimalThreadNumber > 1) {
+        WTF::ParallelJobs<PlatformApplyParameters> parallelJobs(&platformArithmeticWorker, optimalThreadNumber);
+
+        int jobs = parallelJobs.numberOfJobs();
+        if (jobs > 1) {
+            // Every byte only depends on the bytes at the same offset, so the jobs can split the arrays
+            // anywhere; keep whole pixels together for the NEON code path.
+            const int blockSize = pixelCount / jobs;
+            const int jobsWithExtra = pixelCount % jobs;
+
+            int offset = 0;
+            for (int job = 0; job < jobs; ++job) {
+                int jobLength = 4 * (job < jobsWithExtra ? blockSize + 1 : blockSize);
+                PlatformApplyParameters& params = parallelJobs.parameter(job);
+                params.filter = this;
+                params.source = source->data() + offset;
+                params.destination = destination->data() + offset;
+                params.length = jobLength;
+                offset += jobLength;
+            }
+
+            parallelJobs.execute();
+            return;
+        }
+        // Fallback to single threaded mode.
+    }
+
+    platformArithmeticSoftware(source->data(), destination->data(), length, m_k1, m_k2, m_k3, m_k4);
 }
 
 void FEComposite::determineAbsolutePaintRect()
@@ -265,7 +318,7 @@ void FEComposite::platformApplySoftware()
         IntRect effectBDrawingRect = requestedRegionOfInputImageData(in2->absolutePaintRect());
         in2->copyPremultipliedImage(dstPixelArray, effectBDrawingRect);
 
-        platformArithmeticSoftware(srcPixelArray.get(), dstPixelArray, m_k1, m_k2, m_k3, m_k4);
+        platformArithmetic(srcPixelArray.get(), dstPixelArray);
         return;
     }
 
@@ -28,6 +28,10 @@
 #include "Filter.h"
 #include <wtf/text/WTFString.h>
 
+namespace WTF {
+template<typename Type> class ParallelJobs;
+}
+
 namespace WebCore {
 
 enum CompositeOperationType {
@@ -68,19 +72,42 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    // Computes the arithmetic operator over |length| premultiplied components, writing to |destination|. Passing false
+    // for |allowSIMD| forces the scalar code, so that tests can check the SSE2 and NEON kernels against it.
+    static void platformArithmeticSoftware(unsigned char* source, unsigned char* destination, int length,
+        float k1, float k2, float k3, float k4, bool allowSIMD = true);
+
 protected:
     virtual bool requiresValidPreMultipliedPixels() OVERRIDE { return m_type != FECOMPOSITE_OPERATOR_ARITHMETIC; }
 
 private:
+    static const int s_minimalRectDimension = 100 * 100; // Empirical data limit for parallel jobs
+
+    template<typename Type>
+    friend class WTF::ParallelJobs;
+
+    struct PlatformApplyParameters {
+        FEComposite* filter;
+        unsigned char* source;
+        unsigned char* destination;
+        int length;
+    };
+
+    static void platformArithmeticWorker(PlatformApplyParameters*);
+
     FEComposite(Filter*, const CompositeOperationType&, float, float, float, float);
 
-    inline void platformArithmeticSoftware(Uint8ClampedArray* source, Uint8ClampedArray* destination,
-        float k1, float k2, float k3, float k4);
+    inline void platformArithmetic(Uint8ClampedArray* source, Uint8ClampedArray* destination);
     template <int b1, int b4>
     static inline void computeArithmeticPixelsNeon(unsigned char* source, unsigned  char* destination,
         unsigned pixelArrayLength, float k1, float k2, float k3, float k4);
     static inline void platformArithmeticNeon(unsigned char* source, unsigned  char* destination,
         unsigned pixelArrayLength, float k1, float k2, float k3, float k4);
+    template <int b1, int b4>
+    static inline void computeArithmeticPixelsSSE2(unsigned char* source, unsigned char* destination,
+        unsigned pixelArrayLength, float k1, float k2, float k3, float k4);
+    static inline void platformArithmeticSSE2(unsigned char* source, unsigned char* destination,
+        unsigned pixelArrayLength, float k1, float k2, float k3, float k4);
 
     CompositeOperationType m_type;
     float m_k1;
@@ -51,6 +51,11 @@ public:
     static void calculateKernelSize(Filter*, unsigned& kernelSizeX, unsigned& kernelSizeY, float stdX, float stdY);
     static void calculateUnscaledKernelSize(unsigned& kernelSizeX, unsigned& kernelSizeY, float stdX, float stdY);
 
+    // One box blur pass along |effectHeight| lines of |effectWidth| pixels. Passing false for |allowSIMD| forces the
+    // scalar code, so that tests can check the SSE2 and NEON kernels against it.
+    static void boxBlur(Uint8ClampedArray* srcPixelArray, Uint8ClampedArray* dstPixelArray, unsigned dx, int dxLeft, int dxRight,
+        int stride, int strideLine, int effectWidth, int effectHeight, bool alphaImage, bool allowSIMD = true);
+
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
 private:
@@ -28,6 +28,7 @@
 #include "Filter.h"
 #include "ImageBuffer.h"
 #include "TextStream.h"
+#include <wtf/ParallelJobs.h>
 #include <wtf/Uint8ClampedArray.h>
 
 #if HAVE(ARM_NEON_INTRINSICS)
@@ -39,6 +40,7 @@ namespace WebCore {
 FilterEffect::FilterEffect(Filter* filter)
     : m_alphaImage(false)
     , m_filter(filter)
+    , m_consumerCount(0)
     , m_hasX(false)
     , m_hasY(false)
     , m_hasWidth(false)
@@ -97,11 +99,15 @@ FilterEffect* FilterEffect::inputEffect(unsigned number) const
     return m_inputEffects.at(number).get();
 }
 
-#if ENABLE(OPENCL)
 void FilterEffect::applyAll()
 {
     if (hasResult())
         return;
+
+    resetConsumerCountsRecursive();
+    countConsumersRecursive();
+
+#if ENABLE(OPENCL)
     FilterContextOpenCL* context = FilterContextOpenCL::context();
     if (context) {
         apply();
@@ -110,15 +116,37 @@ void FilterEffect::applyAll()
         clearResultsRecursive();
         context->destroyContext();
     }
+#endif
     // Software code path.
     apply();
 }
-#endif
+
+void FilterEffect::resetConsumerCountsRecursive()
+{
+    m_consumerCount = 0;
+    unsigned size = m_inputEffects.size();
+    for (unsigned i = 0; i < size; ++i)
+        m_inputEffects.at(i)->resetConsumerCountsRecursive();
+}
+
+void FilterEffect::countConsumersRecursive()
+{
+    unsigned size = m_inputEffects.size();
+    for (unsigned i = 0; i < size; ++i) {
+        FilterEffect* in = m_inputEffects.at(i).get();
+        // Only descend the first time an effect is reached, shared subgraphs are counted once.
+        if (!in->m_consumerCount++)
+            in->countConsumersRecursive();
+    }
+}
 
 void FilterEffect::apply()
 {
     if (hasResult())
         return;
+    if (applyUnmultipliedPixelEffectChain())
+        return;
+
     unsigned size = m_inputEffects.size();
     for (unsigned i = 0; i < size; ++i) {
         FilterEffect* in = m_inputEffects.at(i).get();
@@ -174,6 +202,128 @@ bool FilterEffect::platformApplyOpenCL()
 }
 #endif
 
+bool FilterEffect::applyUnmultipliedPixelEffectChain()
+{
+    if (!isUnmultipliedPixelEffect() || m_inputEffects.size() != 1)
+        return false;
+#if ENABLE(OPENCL)
+    // The OpenCL path evaluates one effect at a time.
+    if (FilterContextOpenCL::context())
+        return false;
+#endif
+
+    // Walk towards the source while the inputs are per-pixel effects whose result is read by nobody
+    // else; they don't need a result of their own and can run over this effect's pixels instead.
+    // Should another effect ask for one of their results after all, apply() still computes it.
+    Vector<FilterEffect*> chain;
+    chain.append(this);
+    FilterEffect* source = inputEffect(0);
+    while (source->isUnmultipliedPixelEffect() && source->m_consumerCount == 1 && !source->hasResult()
+        && source->numberOfEffectInputs() == 1 && source->operatingColorSpace() == m_operatingColorSpace) {
+        chain.append(source);
+        source = source->inputEffect(0);
+    }
+    if (chain.size() < 2)
+        return false;
+
+    source->apply();
+    if (!source->hasResult())
+        return true;
+    chain.last()->transformResultColorSpace(source, 0);
+
+    // Every effect of the chain has to cover the same pixels, otherwise fall back to one effect at a time.
+    Vector<FilterEffect*> effects;
+    effects.reserveInitialCapacity(chain.size());
+    for (size_t i = chain.size(); i > 0; --i) {
+        FilterEffect* effect = chain[i - 1];
+        effect->determineAbsolutePaintRect();
+        effect->setResultColorSpace(m_operatingColorSpace);
+        if (effect->absolutePaintRect() != chain.last()->absolutePaintRect())
+            return false;
+        effects.uncheckedAppend(effect);
+    }
+
+    if (!isFilterSizeValid(m_absolutePaintRect))
+        return true;
+
+    if (chain.last()->requiresValidPreMultipliedPixels())
+        source->correctFilterResultIfNeeded();
+
+    applyUnmultipliedPixelEffects(source, effects);
+    return true;
+}
+
+struct UnmultipliedPixelEffectsParameters {
+    const Vector<FilterEffect*>* effects;
+    unsigned char* pixels;
+    unsigned pixelCount;
+};
+
+static const unsigned minimalPixelCountForParallelJobs = 100 * 100; // Empirical data limit for parallel jobs
+// Every effect runs over a chunk before the next chunk is touched, so that the pixels stay in the cache.
+static const unsigned pixelsPerChunk = 4096;
+
+static void applyUnmultipliedPixelEffectsToRange(const Vector<FilterEffect*>& effects, unsigned char* pixels, unsigned pixelCount)
+{
+    size_t numberOfEffects = effects.size();
+    while (pixelCount) {
+        unsigned chunkPixelCount = std::min(pixelCount, pixelsPerChunk);
+        for (size_t i = 0; i < numberOfEffects; ++i)
+            effects[i]->applyToUnmultipliedPixels(pixels, chunkPixelCount);
+        pixels += chunkPixelCount * 4;
+        pixelCount -= chunkPixelCount;
+    }
+}
+
+static void applyUnmultipliedPixelEffectsWorker(UnmultipliedPixelEffectsParameters* parameters)
+{
+    applyUnmultipliedPixelEffectsToRange(*parameters->effects, parameters->pixels, parameters->pixelCount);
+}
+
+void FilterEffect::applyUnmultipliedPixelEffects(FilterEffect* source, const Vector<FilterEffect*>& effects)
+{
+    Uint8ClampedArray* pixelArray = createUnmultipliedImageResult();
+    if (!pixelArray)
+        return;
+
+    source->copyUnmultipliedImage(pixelArray, requestedRegionOfInputImageData(source->absolutePaintRect()));
+
+    for (size_t i = 0; i < effects.size(); ++i)
+        effects[i]->prepareToApplyToUnmultipliedPixels();
+
+    int width = m_absolutePaintRect.width();
+    int height = m_absolutePaintRect.height();
+    unsigned char* pixels = pixelArray->data();
+
+    int optimalThreadNumber = (width * height) / minimalPixelCountForParallelJobs;
+    if (optimalThreadNumber > 1) {
+        WTF::ParallelJobs<UnmultipliedPixelEffectsParameters> parallelJobs(&applyUnmultipliedPixelEffectsWorker, optimalThreadNumber);
+
+        int jobs = parallelJobs.numberOfJobs();
+        if (jobs > 1) {
+            // Split the image into bands of whole rows, the first "jobsWithExtra" bands get one more row.
+            const int blockHeight = height / jobs;
+            const int jobsWithExtra = height % jobs;
+
+            int currentY = 0;
+            for (int job = 0; job < jobs; ++job) {
+                int jobHeight = job < jobsWithExtra ? blockHeight + 1 : blockHeight;
+                UnmultipliedPixelEffectsParameters& params = parallelJobs.parameter(job);
+                params.effects = &effects;
+                params.pixels = pixels + currentY * width * 4;
+                params.pixelCount = jobHeight * width;
+                currentY += jobHeight;
+            }
+
+            parallelJobs.execute();
+            return;
+        }
+        // Fallback to single threaded mode.
+    }
+
+    applyUnmultipliedPixelEffectsToRange(effects, pixels, width * height);
+}
+
 void FilterEffect::forceValidPreMultipliedPixels()
 {
     // Must operate on pre-multiplied results; other formats cannot have invalid pixels.
@@ -103,11 +103,12 @@ public:
     void setMaxEffectRect(const FloatRect& maxEffectRect) { m_maxEffectRect = maxEffectRect; } 
 
     void apply();
-#if ENABLE(OPENCL)
+    // Entry point for the last effect of a filter. Records how many effects read each result
+    // so that apply() can evaluate chains of per-pixel effects in a single pass. Every other effect,
+    // including FEGaussianBlur, FEOffset and FEMerge, still produces its whole absolute paint rect
+    // on its own; the evaluated area is only limited by maxEffectRect(), which CSS filters set to
+    // what the dirty rect needs (see FilterEffectRenderer::restrictEffectsToResultRect()).
     void applyAll();
-#else
-    inline void applyAll() { apply(); }
-#endif
 
     // Correct any invalid pixels, if necessary, in the result of a filter operation.
     // This method is used to ensure valid pixel values on filter inputs and the final result.
@@ -115,6 +116,13 @@ public:
     virtual void correctFilterResultIfNeeded() { }
 
     virtual void platformApplySoftware() = 0;
+
+    // Effects whose software path maps every unmultiplied pixel independently of its neighbours
+    // and of its position. prepareToApplyToUnmultipliedPixels() is called once on the main thread,
+    // applyToUnmultipliedPixels() may then run on several threads for disjoint ranges of pixels.
+    virtual bool isUnmultipliedPixelEffect() const { return false; }
+    virtual void prepareToApplyToUnmultipliedPixels() { }
+    virtual void applyToUnmultipliedPixels(unsigned char*, unsigned) const { }
 #if ENABLE(OPENCL)
     virtual bool platformApplyOpenCL();
 #endif
@@ -177,7 +185,15 @@ protected:
     // If a pre-multiplied image, check every pixel for validity and correct if necessary.
     void forceValidPreMultipliedPixels();
 
+    // Creates an unmultiplied result from the result of |source| and runs |effects| over it in order.
+    // Large results are split into horizontal bands that are processed in parallel.
+    void applyUnmultipliedPixelEffects(FilterEffect* source, const Vector<FilterEffect*>& effects);
+
 private:
+    bool applyUnmultipliedPixelEffectChain();
+    void countConsumersRecursive();
+    void resetConsumerCountsRecursive();
+
     OwnPtr<ImageBuffer> m_imageBufferResult;
     RefPtr<Uint8ClampedArray> m_unmultipliedImageResult;
     RefPtr<Uint8ClampedArray> m_premultipliedImageResult;
@@ -194,6 +210,9 @@ private:
     // The absolute paint rect should never be bigger than m_maxEffectRect.
     FloatRect m_maxEffectRect;
     Filter* m_filter;
+
+    // Number of effects reading this result, as seen by the last applyAll().
+    unsigned m_consumerCount;
     
 private:
     inline void copyImageBytes(Uint8ClampedArray* source, Uint8ClampedArray* destination, const IntRect&);
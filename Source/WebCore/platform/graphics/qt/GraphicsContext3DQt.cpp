@@ -71,6 +71,9 @@ public:
 
 #if USE(ACCELERATED_COMPOSITING)
     virtual void paintToTextureMapper(TextureMapper*, const FloatRect& target, const TransformationMatrix&, float opacity);
+#if !USE(GRAPHICS_SURFACE)
+    virtual bool isOpaque() const { return !m_context->m_attrs.alpha; }
+#endif
 #endif
 #if USE(GRAPHICS_SURFACE)
     virtual IntSize platformLayerSize() const;
@@ -45,6 +45,7 @@
 
 #include "AffineTransform.h"
 #include "Color.h"
+#include "DisplayList.h"
 #include "FloatConversion.h"
 #include "Font.h"
 #include "ImageBuffer.h"
@@ -365,6 +366,8 @@ void GraphicsContext::platformDestroy()
 
 PlatformGraphicsContext* GraphicsContext::platformContext() const
 {
+    if (isRecording())
+        return m_displayListRecorder->platformContextForExternalPainting();
     return m_data->p();
 }
 
@@ -373,6 +376,9 @@ AffineTransform GraphicsContext::getCTM(IncludeDeviceScale includeScale) const
     if (paintingDisabled())
         return AffineTransform();
 
+    if (isRecording())
+        return m_displayListRecorder->getCTM();
+
     const QTransform& matrix = (includeScale == DefinitelyIncludeDeviceScale)
         ? platformContext()->combinedTransform()
         : platformContext()->worldTransform();
@@ -404,6 +410,11 @@ void GraphicsContext::drawRect(const IntRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawRect(rect);
+        return;
+    }
+
     ASSERT(!rect.isEmpty());
 
     QPainter* p = m_data->p();
@@ -422,6 +433,11 @@ void GraphicsContext::drawLine(const IntPoint& point1, const IntPoint& point2)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawLine(point1, point2);
+        return;
+    }
+
     StrokeStyle style = strokeStyle();
     Color color = strokeColor();
     if (style == NoStroke)
@@ -603,6 +619,11 @@ void GraphicsContext::drawEllipse(const IntRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawEllipse(rect);
+        return;
+    }
+
     m_data->p()->drawEllipse(rect);
 }
 
@@ -611,6 +632,11 @@ void GraphicsContext::drawConvexPolygon(size_t npoints, const FloatPoint* points
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawConvexPolygon(npoints, points, shouldAntialias);
+        return;
+    }
+
     if (npoints <= 1)
         return;
 
@@ -634,6 +660,11 @@ void GraphicsContext::clipConvexPolygon(size_t numPoints, const FloatPoint* poin
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipConvexPolygon(numPoints, points, antialiased);
+        return;
+    }
+
     if (numPoints <= 1)
         return;
 
@@ -660,6 +691,11 @@ void GraphicsContext::fillPath(const Path& path)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillPath(path);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPainterPath platformPath = path.platformPath();
     platformPath.setFillRule(toQtFillRule(fillRule()));
@@ -723,6 +759,12 @@ void GraphicsContext::strokePath(const Path& path)
 {
     if (paintingDisabled())
         return;
+
+    if (isRecording()) {
+        m_displayListRecorder->strokePath(path);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPen pen(p->pen());
     QPainterPath platformPath = path.platformPath();
@@ -824,6 +866,11 @@ void GraphicsContext::fillRect(const FloatRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillRect(rect);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QRectF normalizedRect = rect.normalized();
 
@@ -885,6 +932,11 @@ void GraphicsContext::fillRect(const FloatRect& rect, const Color& color, ColorS
     if (paintingDisabled() || !color.isValid())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillRect(rect, color, colorSpace);
+        return;
+    }
+
     QRectF platformRect(rect);
     QPainter* p = m_data->p();
     if (hasShadow()) {
@@ -905,6 +957,11 @@ void GraphicsContext::fillRoundedRect(const IntRect& rect, const IntSize& topLef
     if (paintingDisabled() || !color.isValid())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillRoundedRect(rect, topLeft, topRight, bottomLeft, bottomRight, color, colorSpace);
+        return;
+    }
+
     Path path;
     path.addRoundedRect(rect, topLeft, topRight, bottomLeft, bottomRight);
     QPainter* p = m_data->p();
@@ -927,6 +984,11 @@ void GraphicsContext::fillRectWithRoundedHole(const IntRect& rect, const Rounded
     if (paintingDisabled() || !color.isValid())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->fillRectWithRoundedHole(rect, roundedHoleRect, color, colorSpace);
+        return;
+    }
+
     Path path;
     path.addRect(rect);
     if (!roundedHoleRect.radii().isZero())
@@ -955,6 +1017,9 @@ void GraphicsContext::fillRectWithRoundedHole(const IntRect& rect, const Rounded
 
 bool GraphicsContext::isInTransparencyLayer() const
 {
+    if (isRecording())
+        return m_transparencyCount;
+
     return m_data->layerCount;
 }
 
@@ -963,6 +1028,11 @@ void GraphicsContext::clip(const IntRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clip(rect);
+        return;
+    }
+
     m_data->p()->setClipRect(rect, Qt::IntersectClip);
 }
 
@@ -971,10 +1041,18 @@ void GraphicsContext::clip(const FloatRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clip(rect);
+        return;
+    }
+
     m_data->p()->setClipRect(rect, Qt::IntersectClip);
 }
 IntRect GraphicsContext::clipBounds() const
 {
+    if (isRecording())
+        return m_displayListRecorder->clipBounds();
+
     QPainter* p = m_data->p();
     QRectF clipRect;
 
@@ -991,6 +1069,11 @@ void GraphicsContext::clipPath(const Path& path, WindRule clipRule)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipPath(path, clipRule);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPainterPath platformPath = path.platformPath();
     platformPath.setFillRule(clipRule == RULE_EVENODD ? Qt::OddEvenFill : Qt::WindingFill);
@@ -1017,13 +1100,18 @@ void drawFocusRingForPath(QPainter* p, const QPainterPath& path, const Color& co
     p->setRenderHint(QPainter::Antialiasing, antiAlias);
 }
 
-void GraphicsContext::drawFocusRing(const Path& path, int /* width */, int offset, const Color& color)
+void GraphicsContext::drawFocusRing(const Path& path, int width, int offset, const Color& color)
 {
     // FIXME: Use 'offset' for something? http://webkit.org/b/49909
 
     if (paintingDisabled() || !color.isValid())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawFocusRing(path, width, offset, color);
+        return;
+    }
+
     drawFocusRingForPath(m_data->p(), path.platformPath(), color, m_data->antiAliasingForRectsAndLines);
 }
 
@@ -1037,6 +1125,11 @@ void GraphicsContext::drawFocusRing(const Vector<IntRect>& rects, int width, int
     if (paintingDisabled() || !color.isValid())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawFocusRing(rects, width, offset, color);
+        return;
+    }
+
     unsigned rectCount = rects.size();
 
     if (!rects.size())
@@ -1055,11 +1148,16 @@ void GraphicsContext::drawFocusRing(const Vector<IntRect>& rects, int width, int
     drawFocusRingForPath(m_data->p(), path, color, m_data->antiAliasingForRectsAndLines);
 }
 
-void GraphicsContext::drawLineForText(const FloatPoint& origin, float width, bool)
+void GraphicsContext::drawLineForText(const FloatPoint& origin, float width, bool printing)
 {
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawLineForText(origin, width, printing);
+        return;
+    }
+
     FloatPoint startPoint = origin;
     FloatPoint endPoint = origin + FloatSize(width, 0);
 
@@ -1168,6 +1266,11 @@ void GraphicsContext::drawLineForDocumentMarker(const FloatPoint& origin, float
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawLineForDocumentMarker(origin, width, style);
+        return;
+    }
+
     QPainter* painter = platformContext();
     const QPen originalPen = painter->pen();
 
@@ -1188,6 +1291,9 @@ void GraphicsContext::drawLineForDocumentMarker(const FloatPoint& origin, float
 
 FloatRect GraphicsContext::roundToDevicePixels(const FloatRect& frect, RoundingMode)
 {
+    if (isRecording())
+        return m_displayListRecorder->roundToDevicePixels(frect);
+
     // It is not enough just to round to pixels in device space. The rotation part of the
     // affine transform matrix to device space can mess with this conversion if we have a
     // rotating image like the hands of the world clock widget. We just need the scale, so
@@ -1322,6 +1428,11 @@ void GraphicsContext::clearRect(const FloatRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clearRect(rect);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPainter::CompositionMode currentCompositionMode = p->compositionMode();
     p->setCompositionMode(QPainter::CompositionMode_Source);
@@ -1334,6 +1445,11 @@ void GraphicsContext::strokeRect(const FloatRect& rect, float lineWidth)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->strokeRect(rect, lineWidth);
+        return;
+    }
+
     Path path;
     path.addRect(rect);
 
@@ -1353,6 +1469,11 @@ void GraphicsContext::setLineCap(LineCap lc)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->setLineCap(lc);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPen nPen = p->pen();
     nPen.setCapStyle(toQtLineCap(lc));
@@ -1361,6 +1482,11 @@ void GraphicsContext::setLineCap(LineCap lc)
 
 void GraphicsContext::setLineDash(const DashArray& dashes, float dashOffset)
 {
+    if (isRecording()) {
+        m_displayListRecorder->setLineDash(dashes, dashOffset);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPen pen = p->pen();
     unsigned dashLength = dashes.size();
@@ -1389,6 +1515,11 @@ void GraphicsContext::setLineJoin(LineJoin lj)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->setLineJoin(lj);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPen nPen = p->pen();
     nPen.setJoinStyle(toQtLineJoin(lj));
@@ -1400,6 +1531,11 @@ void GraphicsContext::setMiterLimit(float limit)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->setMiterLimit(limit);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPen nPen = p->pen();
     nPen.setMiterLimit(limit);
@@ -1410,6 +1546,12 @@ void GraphicsContext::setAlpha(float opacity)
 {
     if (paintingDisabled())
         return;
+
+    if (isRecording()) {
+        m_displayListRecorder->setAlpha(opacity);
+        return;
+    }
+
     QPainter* p = m_data->p();
     p->setOpacity(opacity);
 }
@@ -1432,6 +1574,11 @@ void GraphicsContext::clip(const Path& path, WindRule windRule)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipPath(path, windRule);
+        return;
+    }
+
     QPainterPath clipPath = path.platformPath();
     clipPath.setFillRule(toQtFillRule(windRule));
     m_data->p()->setClipPath(clipPath, Qt::IntersectClip);
@@ -1439,6 +1586,11 @@ void GraphicsContext::clip(const Path& path, WindRule windRule)
 
 void GraphicsContext::canvasClip(const Path& path, WindRule windRule)
 {
+    if (isRecording()) {
+        m_displayListRecorder->canvasClip(path, windRule);
+        return;
+    }
+
     clip(path, windRule);
 }
 
@@ -1447,6 +1599,11 @@ void GraphicsContext::clipOut(const Path& path)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipOut(path);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPainterPath clippedOut = path.platformPath();
     QPainterPath newClip;
@@ -1468,6 +1625,11 @@ void GraphicsContext::translate(float x, float y)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->translate(x, y);
+        return;
+    }
+
     m_data->p()->translate(x, y);
 }
 
@@ -1476,6 +1638,11 @@ void GraphicsContext::rotate(float radians)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->rotate(radians);
+        return;
+    }
+
     QTransform rotation = QTransform().rotateRadians(radians);
     m_data->p()->setTransform(rotation, true);
 }
@@ -1485,6 +1652,11 @@ void GraphicsContext::scale(const FloatSize& s)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->scale(s);
+        return;
+    }
+
     m_data->p()->scale(s.width(), s.height());
 }
 
@@ -1493,6 +1665,11 @@ void GraphicsContext::clipOut(const IntRect& rect)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->clipOut(rect);
+        return;
+    }
+
     QPainter* p = m_data->p();
     QPainterPath newClip;
     newClip.setFillRule(Qt::OddEvenFill);
@@ -1515,6 +1692,11 @@ void GraphicsContext::concatCTM(const AffineTransform& transform)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->concatCTM(transform);
+        return;
+    }
+
     m_data->p()->setWorldTransform(transform, true);
 }
 
@@ -1523,6 +1705,11 @@ void GraphicsContext::setCTM(const AffineTransform& transform)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->setCTM(transform);
+        return;
+    }
+
     m_data->p()->setWorldTransform(transform);
 }
 
@@ -1532,6 +1719,9 @@ TransformationMatrix GraphicsContext::get3DTransform() const
     if (paintingDisabled())
         return TransformationMatrix();
 
+    if (isRecording())
+        return m_displayListRecorder->getCTM();
+
     return platformContext()->worldTransform();
 }
 
@@ -1540,6 +1730,14 @@ void GraphicsContext::concat3DTransform(const TransformationMatrix& transform)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        if (transform.isAffine())
+            m_displayListRecorder->concatCTM(transform.toAffineTransform());
+        else
+            m_displayListRecorder->markIncomplete();
+        return;
+    }
+
     m_data->p()->setWorldTransform(transform, true);
 }
 
@@ -1548,6 +1746,14 @@ void GraphicsContext::set3DTransform(const TransformationMatrix& transform)
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        if (transform.isAffine())
+            m_displayListRecorder->setCTM(transform.toAffineTransform());
+        else
+            m_displayListRecorder->markIncomplete();
+        return;
+    }
+
     m_data->p()->setWorldTransform(transform, false);
 }
 #endif
@@ -1693,6 +1899,11 @@ void GraphicsContext::releaseWindowsContext(HDC hdc, const IntRect& dstRect, boo
 
 void GraphicsContext::setImageInterpolationQuality(InterpolationQuality quality)
 {
+    if (isRecording()) {
+        m_displayListRecorder->setImageInterpolationQuality(quality);
+        return;
+    }
+
     m_data->imageInterpolationQuality = quality;
 
     switch (quality) {
@@ -1717,6 +1928,9 @@ void GraphicsContext::setImageInterpolationQuality(InterpolationQuality quality)
 
 InterpolationQuality GraphicsContext::imageInterpolationQuality() const
 {
+    if (isRecording())
+        return m_displayListRecorder->imageInterpolationQuality();
+
     return m_data->imageInterpolationQuality;
 }
 
@@ -1727,6 +1941,9 @@ void GraphicsContext::takeOwnershipOfPlatformContext()
 
 bool GraphicsContext::isAcceleratedContext() const
 {
+    if (isRecording())
+        return false;
+
     return (platformContext()->paintEngine()->type() == QPaintEngine::OpenGL2);
 }
 
@@ -0,0 +1,463 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "PaintRecording.h"
+
+#include "GraphicsContext.h"
+#include "IntPoint.h"
+#include <QGlyphRun>
+#include <QPaintDevice>
+#include <QPainter>
+#include <QRawFont>
+#include <private/qpaintengineex_p.h>
+#include <private/qrawfont_p.h>
+#include <private/qstatictext_p.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+extern Q_GUI_EXPORT int qt_defaultDpi();
+
+namespace WebCore {
+
+// QPicture can't be used: it keeps the pixmaps drawn into it, which must not be touched outside
+// the GUI thread, and it turns glyph runs into paths. The commands below hold images and glyph
+// runs instead, and replay them through a QPainter on any thread.
+class RecordedPaintCommand {
+    WTF_MAKE_NONCOPYABLE(RecordedPaintCommand); WTF_MAKE_FAST_ALLOCATED;
+public:
+    RecordedPaintCommand() { }
+    virtual ~RecordedPaintCommand() { }
+    virtual void replay(QPainter*) const = 0;
+};
+
+// Textured brushes may wrap a QPixmap; keep their QImage instead.
+static QBrush brushForRecording(const QBrush& brush)
+{
+    if (brush.style() != Qt::TexturePattern)
+        return brush;
+    QBrush imageBrush(brush.textureImage());
+    imageBrush.setTransform(brush.transform());
+    return imageBrush;
+}
+
+static QPen penForRecording(const QPen& pen)
+{
+    if (pen.brush().style() != Qt::TexturePattern)
+        return pen;
+    QPen imagePen(pen);
+    imagePen.setBrush(brushForRecording(pen.brush()));
+    return imagePen;
+}
+
+// Saving and restoring hand the engine a whole new state, so restoring one replays all of it.
+class SetStateCommand : public RecordedPaintCommand {
+public:
+    explicit SetStateCommand(const QPainterState& state)
+        : m_transform(state.matrix)
+        , m_pen(penForRecording(state.pen))
+        , m_brush(brushForRecording(state.brush))
+        , m_brushOrigin(state.brushOrigin)
+        , m_opacity(state.opacity)
+        , m_compositionMode(state.composition_mode)
+        , m_renderHints(state.renderHints)
+        , m_clipEnabled(state.clipEnabled)
+        , m_clipInfo(state.clipInfo)
+    {
+    }
+
+    virtual void replay(QPainter* painter) const OVERRIDE
+    {
+        painter->setClipping(false);
+        for (int i = 0; i < m_clipInfo.size(); ++i) {
+            const QPainterClipInfo& info = m_clipInfo.at(i);
+            painter->setTransform(info.matrix);
+            switch (info.clipType) {
+            case QPainterClipInfo::RegionClip:
+                painter->setClipRegion(info.region, info.operation);
+                break;
+            case QPainterClipInfo::PathClip:
+                painter->setClipPath(info.path, info.operation);
+                break;
+            case QPainterClipInfo::RectClip:
+                painter->setClipRect(info.rect, info.operation);
+                break;
+            case QPainterClipInfo::RectFClip:
+                painter->setClipRect(info.rectf, info.operation);
+                break;
+            }
+        }
+        painter->setClipping(m_clipEnabled);
+
+        painter->setTransform(m_transform);
+        painter->setPen(m_pen);
+        painter->setBrush(m_brush);
+        painter->setBrushOrigin(m_brushOrigin);
+        painter->setOpacity(m_opacity);
+        painter->setCompositionMode(m_compositionMode);
+        painter->setRenderHints(m_renderHints, true);
+        painter->setRenderHints(~m_renderHints, false);
+    }
+
+private:
+    QTransform m_transform;
+    QPen m_pen;
+    QBrush m_brush;
+    QPointF m_brushOrigin;
+    qreal m_opacity;
+    QPainter::CompositionMode m_compositionMode;
+    QPainter::RenderHints m_renderHints;
+    bool m_clipEnabled;
+    QList<QPainterClipInfo> m_clipInfo;
+};
+
+class SetTransformCommand : public RecordedPaintCommand {
+public:
+    explicit SetTransformCommand(const QTransform& transform) : m_transform(transform) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->setTransform(m_transform); }
+private:
+    QTransform m_transform;
+};
+
+class SetPenCommand : public RecordedPaintCommand {
+public:
+    explicit SetPenCommand(const QPen& pen) : m_pen(penForRecording(pen)) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->setPen(m_pen); }
+private:
+    QPen m_pen;
+};
+
+class SetBrushCommand : public RecordedPaintCommand {
+public:
+    explicit SetBrushCommand(const QBrush& brush) : m_brush(brushForRecording(brush)) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->setBrush(m_brush); }
+private:
+    QBrush m_brush;
+};
+
+class SetBrushOriginCommand : public RecordedPaintCommand {
+public:
+    explicit SetBrushOriginCommand(const QPointF& origin) : m_origin(origin) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->setBrushOrigin(m_origin); }
+private:
+    QPointF m_origin;
+};
+
+class SetOpacityCommand : public RecordedPaintCommand {
+public:
+    explicit SetOpacityCommand(qreal opacity) : m_opacity(opacity) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->setOpacity(m_opacity); }
+private:
+    qreal m_opacity;
+};
+
+class SetCompositionModeCommand : public RecordedPaintCommand {
+public:
+    explicit SetCompositionModeCommand(QPainter::CompositionMode mode) : m_mode(mode) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->setCompositionMode(m_mode); }
+private:
+    QPainter::CompositionMode m_mode;
+};
+
+class SetRenderHintsCommand : public RecordedPaintCommand {
+public:
+    explicit SetRenderHintsCommand(QPainter::RenderHints hints) : m_hints(hints) { }
+    virtual void replay(QPainter* painter) const OVERRIDE
+    {
+        painter->setRenderHints(m_hints, true);
+        painter->setRenderHints(~m_hints, false);
+    }
+private:
+    QPainter::RenderHints m_hints;
+};
+
+class SetClipEnabledCommand : public RecordedPaintCommand {
+public:
+    explicit SetClipEnabledCommand(bool enabled) : m_enabled(enabled) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->setClipping(m_enabled); }
+private:
+    bool m_enabled;
+};
+
+class ClipCommand : public RecordedPaintCommand {
+public:
+    ClipCommand(const QPainterPath& path, Qt::ClipOperation operation) : m_path(path), m_operation(operation) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->setClipPath(m_path, m_operation); }
+private:
+    QPainterPath m_path;
+    Qt::ClipOperation m_operation;
+};
+
+class FillPathCommand : public RecordedPaintCommand {
+public:
+    FillPathCommand(const QPainterPath& path, const QBrush& brush) : m_path(path), m_brush(brushForRecording(brush)) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->fillPath(m_path, m_brush); }
+private:
+    QPainterPath m_path;
+    QBrush m_brush;
+};
+
+class StrokePathCommand : public RecordedPaintCommand {
+public:
+    StrokePathCommand(const QPainterPath& path, const QPen& pen) : m_path(path), m_pen(penForRecording(pen)) { }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->strokePath(m_path, m_pen); }
+private:
+    QPainterPath m_path;
+    QPen m_pen;
+};
+
+class DrawImageCommand : public RecordedPaintCommand {
+public:
+    DrawImageCommand(const QRectF& rect, const QImage& image, const QRectF& sourceRect, Qt::ImageConversionFlags flags)
+        : m_rect(rect)
+        , m_image(image)
+        , m_sourceRect(sourceRect)
+        , m_flags(flags)
+    {
+    }
+    virtual void replay(QPainter* painter) const OVERRIDE { painter->drawImage(m_rect, m_image, m_sourceRect, m_flags); }
+private:
+    QRectF m_rect;
+    QImage m_image;
+    QRectF m_sourceRect;
+    Qt::ImageConversionFlags m_flags;
+};
+
+class DrawTiledImageCommand : public RecordedPaintCommand {
+public:
+    DrawTiledImageCommand(const QRectF& rect, const QImage& image, const QPointF& offset)
+        : m_rect(rect)
+        , m_image(image)
+        , m_offset(offset)
+    {
+    }
+
+    virtual void replay(QPainter* painter) const OVERRIDE
+    {
+        // QPainter can only tile pixmaps; an image brush anchored the same way tiles identically.
+        QBrush brush(m_image);
+        brush.setTransform(QTransform::fromTranslate(m_rect.x() - m_offset.x(), m_rect.y() - m_offset.y()));
+        painter->fillRect(m_rect, brush);
+    }
+
+private:
+    QRectF m_rect;
+    QImage m_image;
+    QPointF m_offset;
+};
+
+class DrawGlyphsCommand : public RecordedPaintCommand {
+public:
+    explicit DrawGlyphsCommand(QStaticTextItem* item)
+        : m_glyphs(item->numGlyphs)
+        , m_positions(item->numGlyphs)
+    {
+        // Keeps the font engine alive until the recording goes away.
+        QRawFontPrivate::get(m_fontEngineOwner)->setFontEngine(item->fontEngine());
+        for (int i = 0; i < item->numGlyphs; ++i) {
+            m_glyphs[i] = item->glyphs[i];
+            m_positions[i] = item->glyphPositions[i].toPointF();
+        }
+    }
+
+    virtual void replay(QPainter* painter) const OVERRIDE
+    {
+        // Font engines cache glyphs without any locking, so the workers take turns drawing text.
+        AtomicallyInitializedStatic(Mutex&, glyphDrawingMutex = *new Mutex);
+        MutexLocker locker(glyphDrawingMutex);
+
+        // A QRawFont belongs to the thread that set it up.
+        QRawFont rawFont;
+        QRawFontPrivate::get(rawFont)->setFontEngine(QRawFontPrivate::get(m_fontEngineOwner)->fontEngine);
+        QGlyphRun glyphRun;
+        glyphRun.setRawFont(rawFont);
+        glyphRun.setGlyphIndexes(m_glyphs);
+        glyphRun.setPositions(m_positions);
+        painter->drawGlyphRun(QPointF(), glyphRun);
+    }
+
+private:
+    QRawFont m_fontEngineOwner;
+    QVector<quint32> m_glyphs;
+    QVector<QPointF> m_positions;
+};
+
+typedef Vector<OwnPtr<RecordedPaintCommand> > RecordedPaintCommandList;
+
+// Everything QPainter draws reaches a QPaintEngineEx as paths, images and glyph runs, together with
+// notifications of the state changes in between, which is exactly what needs to be recorded.
+class RecordingPaintEngine : public QPaintEngineEx {
+public:
+    explicit RecordingPaintEngine(RecordedPaintCommandList& commands)
+        : m_commands(commands)
+    {
+    }
+
+    virtual bool begin(QPaintDevice*) OVERRIDE { return true; }
+    virtual bool end() OVERRIDE { return true; }
+    virtual Type type() const OVERRIDE { return User; }
+
+    virtual void setState(QPainterState* state) OVERRIDE
+    {
+        QPaintEngineEx::setState(state);
+        append(new SetStateCommand(*state));
+    }
+
+    virtual void clipEnabledChanged() OVERRIDE { append(new SetClipEnabledCommand(state()->clipEnabled)); }
+    virtual void penChanged() OVERRIDE { append(new SetPenCommand(state()->pen)); }
+    virtual void brushChanged() OVERRIDE { append(new SetBrushCommand(state()->brush)); }
+    virtual void brushOriginChanged() OVERRIDE { append(new SetBrushOriginCommand(state()->brushOrigin)); }
+    virtual void opacityChanged() OVERRIDE { append(new SetOpacityCommand(state()->opacity)); }
+    virtual void compositionModeChanged() OVERRIDE { append(new SetCompositionModeCommand(state()->composition_mode)); }
+    virtual void renderHintsChanged() OVERRIDE { append(new SetRenderHintsCommand(state()->renderHints)); }
+    virtual void transformChanged() OVERRIDE { append(new SetTransformCommand(state()->matrix)); }
+
+    virtual void clip(const QVectorPath& path, Qt::ClipOperation operation) OVERRIDE { append(new ClipCommand(path.convertToPainterPath(), operation)); }
+    virtual void fill(const QVectorPath& path, const QBrush& brush) OVERRIDE { append(new FillPathCommand(path.convertToPainterPath(), brush)); }
+    virtual void stroke(const QVectorPath& path, const QPen& pen) OVERRIDE { append(new StrokePathCommand(path.convertToPainterPath(), pen)); }
+
+    virtual void drawPixmap(const QRectF& rect, const QPixmap& pixmap, const QRectF& sourceRect) OVERRIDE
+    {
+        append(new DrawImageCommand(rect, pixmap.toImage(), sourceRect, Qt::AutoColor));
+    }
+
+    virtual void drawImage(const QRectF& rect, const QImage& image, const QRectF& sourceRect, Qt::ImageConversionFlags flags) OVERRIDE
+    {
+        append(new DrawImageCommand(rect, image, sourceRect, flags));
+    }
+
+    virtual void drawTiledPixmap(const QRectF& rect, const QPixmap& pixmap, const QPointF& offset) OVERRIDE
+    {
+        append(new DrawTiledImageCommand(rect, pixmap.toImage(), offset));
+    }
+
+    virtual void drawStaticTextItem(QStaticTextItem* item) OVERRIDE { append(new DrawGlyphsCommand(item)); }
+
+private:
+    void append(RecordedPaintCommand* command) { m_commands.append(adoptPtr(command)); }
+
+    RecordedPaintCommandList& m_commands;
+};
+
+class PaintRecordingDevice : public QPaintDevice {
+public:
+    explicit PaintRecordingDevice(const IntSize& size)
+        : m_size(size)
+        , m_engine(m_commands)
+    {
+    }
+
+    virtual QPaintEngine* paintEngine() const OVERRIDE { return &m_engine; }
+
+    void replay(QPainter* painter) const
+    {
+        for (size_t i = 0; i < m_commands.size(); ++i)
+            m_commands[i]->replay(painter);
+    }
+
+protected:
+    virtual int metric(PaintDeviceMetric metric) const OVERRIDE
+    {
+        switch (metric) {
+        case PdmWidth:
+            return m_size.width();
+        case PdmHeight:
+            return m_size.height();
+        case PdmDepth:
+            return 32;
+        case PdmDpiX:
+        case PdmDpiY:
+        case PdmPhysicalDpiX:
+        case PdmPhysicalDpiY:
+            return qt_defaultDpi();
+        default:
+            return QPaintDevice::metric(metric);
+        }
+    }
+
+private:
+    IntSize m_size;
+    RecordedPaintCommandList m_commands;
+    mutable RecordingPaintEngine m_engine;
+};
+
+PassOwnPtr<PaintRecording> PaintRecording::create(const IntSize& size)
+{
+    OwnPtr<PaintRecording> recording = adoptPtr(new PaintRecording(size));
+    if (!recording->m_context)
+        return nullptr;
+    return recording.release();
+}
+
+PaintRecording::PaintRecording(const IntSize& size)
+    : m_size(size)
+    , m_device(adoptPtr(new PaintRecordingDevice(size)))
+    , m_painter(adoptPtr(new QPainter))
+{
+    if (!m_painter->begin(m_device.get()))
+        return;
+
+    // Match the defaults of the painters that ImageBuffer hands out.
+    m_painter->setRenderHints(QPainter::Antialiasing | QPainter::HighQualityAntialiasing);
+    m_context = adoptPtr(new GraphicsContext(m_painter.get()));
+}
+
+PaintRecording::~PaintRecording()
+{
+}
+
+void PaintRecording::endRecording()
+{
+    m_context.clear();
+    if (m_painter->isActive())
+        m_painter->end();
+}
+
+void PaintRecording::rasterize()
+{
+    ASSERT(!m_context);
+    m_image = QImage(m_size, QImage::Format_ARGB32_Premultiplied);
+    m_image.fill(Qt::transparent);
+
+    QPainter painter(&m_image);
+    m_device->replay(&painter);
+    painter.end();
+
+    // The commands are not needed anymore, and the images they reference can go away.
+    m_device.clear();
+}
+
+bool PaintRecording::isRasterized() const
+{
+    return !m_image.isNull();
+}
+
+void PaintRecording::drawRasterizedImage(GraphicsContext* context, const IntPoint& location) const
+{
+    ASSERT(isRasterized());
+    context->platformContext()->drawImage(QPoint(location), m_image);
+}
+
+} // namespace WebCore
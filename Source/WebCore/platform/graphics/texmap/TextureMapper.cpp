@@ -62,10 +62,12 @@ private:
 
     static const double s_releaseUnusedSecondsTolerance;
     static const double s_releaseUnusedTexturesTimerInterval;
+    static const size_t s_maximumUnusedBytes;
 };
 
 const double BitmapTexturePool::s_releaseUnusedSecondsTolerance = 3;
 const double BitmapTexturePool::s_releaseUnusedTexturesTimerInterval = 0.5;
+const size_t BitmapTexturePool::s_maximumUnusedBytes = 32 * 1024 * 1024;
 
 BitmapTexturePool::BitmapTexturePool()
     : m_releaseUnusedTexturesTimer(this, &BitmapTexturePool::releaseUnusedTexturesTimerFired)
@@ -84,6 +86,12 @@ void BitmapTexturePool::releaseUnusedTexturesTimerFired(Timer<BitmapTexturePool>
     if (m_textures.isEmpty())
         return;
 
+    // Textures that are still held are in use, so they must not expire before they are given back.
+    for (size_t i = 0; i < m_textures.size(); ++i) {
+        if (m_textures[i].m_texture->refCount() > 1)
+            m_textures[i].markUsed();
+    }
+
     // Delete entries, which have been unused in s_releaseUnusedSecondsTolerance.
     nonCopyingSort(m_textures.begin(), m_textures.end(), BitmapTexturePoolEntry::compareTimeLastUsed);
 
@@ -94,6 +102,33 @@ void BitmapTexturePool::releaseUnusedTexturesTimerFired(Timer<BitmapTexturePool>
             break;
         }
     }
+
+    // Of the textures nobody else holds, keep only the most recently used ones up to the byte budget.
+    size_t unusedBytes = 0;
+    bool hasUnusedTextures = false;
+    for (size_t i = 0; i < m_textures.size(); ) {
+        if (m_textures[i].m_texture->refCount() > 1) {
+            ++i;
+            continue;
+        }
+
+        unusedBytes += m_textures[i].m_texture->numberOfBytes();
+        if (unusedBytes > s_maximumUnusedBytes) {
+            unusedBytes -= m_textures[i].m_texture->numberOfBytes();
+            m_textures.remove(i);
+            continue;
+        }
+        hasUnusedTextures = true;
+        ++i;
+    }
+
+    // Check again while unused textures are left, so that they expire once nothing has been acquired for a while.
+    // Held textures are given back by simply dropping the reference, so while the pool holds only those keep
+    // checking at a slower pace until they become unused.
+    if (hasUnusedTextures)
+        scheduleReleaseUnusedTextures();
+    else if (!m_textures.isEmpty())
+        m_releaseUnusedTexturesTimer.startOneShot(s_releaseUnusedSecondsTolerance);
 }
 
 PassRefPtr<BitmapTexture> BitmapTexturePool::acquireTexture(const IntSize& size, TextureMapper* textureMapper)
@@ -172,6 +172,18 @@ public:
     void setPatternTransform(const TransformationMatrix& p) { m_patternTransform = p; }
     void setWrapMode(WrapMode m) { m_wrapMode = m; }
 
+    // What occlusion culling skipped while painting the last frame, shown by TextureMapperFPSCounter.
+    struct CullingStatistics {
+        CullingStatistics()
+            : culledLayers(0)
+            , culledTiles(0)
+        { }
+
+        unsigned culledLayers;
+        unsigned culledTiles;
+    };
+    CullingStatistics& cullingStatistics() { return m_cullingStatistics; }
+
 protected:
     explicit TextureMapper(AccelerationMode);
 
@@ -197,6 +209,7 @@ private:
     bool m_isMaskMode;
     TransformationMatrix m_patternTransform;
     WrapMode m_wrapMode;
+    CullingStatistics m_cullingStatistics;
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include "GraphicsLayer.h"
 #include "ImageBuffer.h"
+#include "Region.h"
 #include "TextureMapper.h"
 
 #if USE(GRAPHICS_SURFACE)
@@ -47,5 +48,17 @@ unsigned TextureMapperBackingStore::calculateExposedTileEdges(const FloatRect& t
     return exposedEdges;
 }
 
+bool TextureMapperBackingStore::isTileOccluded(TextureMapper* textureMapper, const FloatRect& tileRect, const TransformationMatrix& transform, const Region& occlusion)
+{
+    if (occlusion.isEmpty() || !transform.isAffine())
+        return false;
+
+    if (!occlusion.contains(enclosingIntRect(transform.mapRect(tileRect))))
+        return false;
+
+    ++textureMapper->cullingStatistics().culledTiles;
+    return true;
+}
+
 }
 #endif
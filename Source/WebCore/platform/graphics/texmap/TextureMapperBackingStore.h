@@ -35,16 +35,28 @@
 namespace WebCore {
 
 class GraphicsLayer;
+class Region;
 
 class TextureMapperBackingStore : public TextureMapperPlatformLayer, public RefCounted<TextureMapperBackingStore> {
 public:
     virtual PassRefPtr<BitmapTexture> texture() const = 0;
     virtual void paintToTextureMapper(TextureMapper*, const FloatRect&, const TransformationMatrix&, float) = 0;
     virtual void drawRepaintCounter(TextureMapper*, int /* repaintCount */, const Color&, const FloatRect&, const TransformationMatrix&) { }
+
+    // Like paintToTextureMapper(), but skips the tiles that the transform maps entirely inside the occluded region.
+    virtual void paintUnoccludedTilesToTextureMapper(TextureMapper* textureMapper, const FloatRect& targetRect, const TransformationMatrix& transform, float opacity, const Region&)
+    {
+        paintToTextureMapper(textureMapper, targetRect, transform, opacity);
+    }
+
+    // Whether every part of the contents has a texture to paint, so that opaque contents really hide what is below them.
+    virtual bool hasTexturesForEntireContents() const { return false; }
+
     virtual ~TextureMapperBackingStore() { }
 
 protected:
     static unsigned calculateExposedTileEdges(const FloatRect& totalRect, const FloatRect& tileRect);
+    static bool isTileOccluded(TextureMapper*, const FloatRect& tileRect, const TransformationMatrix&, const Region& occlusion);
 };
 
 }
@@ -32,6 +32,7 @@ namespace WebCore {
 
 TextureMapperFPSCounter::TextureMapperFPSCounter()
     : m_isShowingFPS(false)
+    , m_isShowingCullingStatistics(getenv("WEBKIT_SHOW_CULLING_STATISTICS"))
     , m_fpsInterval(0)
     , m_fpsTimestamp(0)
     , m_lastFPS(0)
@@ -48,6 +49,14 @@ TextureMapperFPSCounter::TextureMapperFPSCounter()
 
 void TextureMapperFPSCounter::updateFPSAndDisplay(TextureMapper* textureMapper, const FloatPoint& location, const TransformationMatrix& matrix)
 {
+    if (m_isShowingCullingStatistics) {
+        // Below the FPS number: layers and then tiles that occlusion culling skipped in the last frame.
+        static const float lineHeight = 16;
+        const TextureMapper::CullingStatistics& statistics = textureMapper->cullingStatistics();
+        textureMapper->drawNumber(statistics.culledLayers, Color::darkGray, FloatPoint(location.x(), location.y() + lineHeight), matrix);
+        textureMapper->drawNumber(statistics.culledTiles, Color::darkGray, FloatPoint(location.x(), location.y() + 2 * lineHeight), matrix);
+    }
+
     if (!m_isShowingFPS)
         return;
 
@@ -39,6 +39,7 @@ public:
 
 private:
     bool m_isShowingFPS;
+    bool m_isShowingCullingStatistics;
     double m_fpsInterval;
     double m_fpsTimestamp;
     int m_lastFPS;
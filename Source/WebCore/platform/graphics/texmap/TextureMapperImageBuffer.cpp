@@ -23,8 +23,14 @@
 #include "GraphicsLayer.h"
 #if PLATFORM(QT)
 #include "NativeImageQt.h"
+#include <QPainter>
+#include <qpa/qplatformpixmap.h>
+#elif USE(CAIRO)
+#include "PlatformContextCairo.h"
+#include <cairo.h>
 #endif
 #include "NotImplemented.h"
+#include "TextureMapperSoftwareCompositor.h"
 
 
 #if USE(TEXTURE_MAPPER)
@@ -32,8 +38,129 @@ namespace WebCore {
 
 static const int s_maximumAllowedImageBufferDimension = 4096;
 
+// Gives the software compositor direct access to the pixels a context draws into, when they are in memory in the
+// layout it expects. Also returns the context's transform to device pixels and its clip in device pixels, failing
+// if either can't be handled as an axis-aligned rectangle.
+#if PLATFORM(QT)
+static bool beginAccessingPixels(GraphicsContext* context, SoftwarePixelBuffer& buffer, AffineTransform& deviceTransform, IntRect& deviceClip)
+{
+    QPainter* painter = context->platformContext();
+    QPaintDevice* device = painter ? painter->device() : 0;
+    if (!device)
+        return false;
+
+    QImage* image = 0;
+    if (device->devType() == QInternal::Image)
+        image = static_cast<QImage*>(device);
+    else if (device->devType() == QInternal::Pixmap) {
+        QPlatformPixmap* pixmapData = static_cast<QPixmap*>(device)->handle();
+        if (pixmapData && pixmapData->classId() == QPlatformPixmap::RasterClass)
+            image = pixmapData->buffer();
+    }
+
+    // Writing to an image shared with a copy would detach it from the painter.
+    if (!image || !image->isDetached())
+        return false;
+    if (image->format() != QImage::Format_ARGB32_Premultiplied && image->format() != QImage::Format_RGB32)
+        return false;
+
+    const QTransform& transform = painter->deviceTransform();
+    if (transform.type() > QTransform::TxScale)
+        return false;
+    deviceTransform = AffineTransform(transform.m11(), transform.m12(), transform.m21(), transform.m22(), transform.dx(), transform.dy());
+
+    buffer.pixels = reinterpret_cast<uint32_t*>(image->bits());
+    buffer.stride = image->bytesPerLine() / sizeof(uint32_t);
+    buffer.size = IntSize(image->width(), image->height());
+
+    deviceClip = IntRect(IntPoint(), buffer.size);
+    if (painter->hasClipping()) {
+        if (painter->clipRegion().rectCount() != 1)
+            return false;
+        deviceClip.intersect(enclosingIntRect(deviceTransform.mapRect(FloatRect(painter->clipBoundingRect()))));
+    }
+    return true;
+}
+
+static void endAccessingPixels(GraphicsContext*)
+{
+}
+#elif USE(CAIRO)
+static bool beginAccessingPixels(GraphicsContext* context, SoftwarePixelBuffer& buffer, AffineTransform& deviceTransform, IntRect& deviceClip)
+{
+    cairo_t* cr = context->platformContext()->cr();
+    cairo_surface_t* surface = cairo_get_target(cr);
+    if (cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE)
+        return false;
+    cairo_format_t format = cairo_image_surface_get_format(surface);
+    if (format != CAIRO_FORMAT_ARGB32 && format != CAIRO_FORMAT_RGB24)
+        return false;
+
+    double deviceOffsetX, deviceOffsetY;
+    cairo_surface_get_device_offset(surface, &deviceOffsetX, &deviceOffsetY);
+    if (deviceOffsetX || deviceOffsetY)
+        return false;
+
+    cairo_matrix_t matrix;
+    cairo_get_matrix(cr, &matrix);
+    if (matrix.yx || matrix.xy || matrix.xx <= 0 || matrix.yy <= 0)
+        return false;
+    deviceTransform = AffineTransform(matrix.xx, matrix.yx, matrix.xy, matrix.yy, matrix.x0, matrix.y0);
+
+    buffer.size = IntSize(cairo_image_surface_get_width(surface), cairo_image_surface_get_height(surface));
+    deviceClip = IntRect(IntPoint(), buffer.size);
+
+    cairo_rectangle_list_t* clipRectangles = cairo_copy_clip_rectangle_list(cr);
+    bool clipIsRectangle = clipRectangles->status == CAIRO_STATUS_SUCCESS && clipRectangles->num_rectangles <= 1;
+    if (clipIsRectangle) {
+        if (clipRectangles->num_rectangles) {
+            const cairo_rectangle_t& rect = clipRectangles->rectangles[0];
+            deviceClip.intersect(enclosingIntRect(deviceTransform.mapRect(FloatRect(rect.x, rect.y, rect.width, rect.height))));
+        } else
+            deviceClip = IntRect();
+    }
+    cairo_rectangle_list_destroy(clipRectangles);
+    if (!clipIsRectangle)
+        return false;
+
+    cairo_surface_flush(surface);
+    buffer.pixels = reinterpret_cast<uint32_t*>(cairo_image_surface_get_data(surface));
+    buffer.stride = cairo_image_surface_get_stride(surface) / sizeof(uint32_t);
+    return buffer.pixels;
+}
+
+static void endAccessingPixels(GraphicsContext* context)
+{
+    cairo_surface_mark_dirty(cairo_get_target(context->platformContext()->cr()));
+}
+#else
+static bool beginAccessingPixels(GraphicsContext*, SoftwarePixelBuffer&, AffineTransform&, IntRect&)
+{
+    return false;
+}
+
+static void endAccessingPixels(GraphicsContext*)
+{
+}
+#endif
+
+static bool isAxisAlignedScaleAndTranslation(const AffineTransform& transform)
+{
+    return !transform.b() && !transform.c() && transform.a() > 0 && transform.d() > 0;
+}
+
 void BitmapTextureImageBuffer::updateContents(const void* data, const IntRect& targetRect, const IntPoint& sourceOffset, int bytesPerLine, UpdateContentsFlag)
 {
+    SoftwarePixelBuffer buffer;
+    AffineTransform deviceTransform;
+    IntRect deviceClip;
+    if (beginAccessingPixels(m_image->context(), buffer, deviceTransform, deviceClip)) {
+        const uint8_t* sourceData = static_cast<const uint8_t*>(data) + sourceOffset.y() * bytesPerLine + sourceOffset.x() * sizeof(uint32_t);
+        TextureMapperSoftwareCompositor::copyPixels(buffer, targetRect, sourceData, bytesPerLine);
+        endAccessingPixels(m_image->context());
+        return;
+    }
+
 #if PLATFORM(QT)
     QImage image(reinterpret_cast<const uchar*>(data), targetRect.width(), targetRect.height(), bytesPerLine, NativeImageQt::defaultFormatForAlphaEnabledImages());
 
@@ -123,6 +250,40 @@ void TextureMapperImageBuffer::endClip()
     context->restore();
 }
 
+bool TextureMapperImageBuffer::drawTextureInSoftware(const BitmapTextureImageBuffer& texture, const FloatRect& targetRect, const TransformationMatrix& matrix, float opacity)
+{
+    if (!matrix.isAffine())
+        return false;
+
+    GraphicsContext* context = currentContext();
+    SoftwarePixelBuffer destination;
+    AffineTransform transform;
+    IntRect clip;
+    if (!beginAccessingPixels(context, destination, transform, clip))
+        return false;
+
+    transform.multiply(matrix.toAffineTransform());
+    if (!isAxisAlignedScaleAndTranslation(transform))
+        return false;
+
+    SoftwarePixelBuffer source;
+    AffineTransform sourceTransform;
+    IntRect sourceClip;
+    if (!beginAccessingPixels(texture.m_image->context(), source, sourceTransform, sourceClip))
+        return false;
+
+    // Scaled draws sample the nearest pixel, so leave them to the platform unless it would do the same.
+    FloatRect destinationRect = transform.mapRect(targetRect);
+    InterpolationQuality quality = context->imageInterpolationQuality();
+    if (destinationRect.size() != FloatSize(source.size) && quality != InterpolationNone && quality != InterpolationLow)
+        return false;
+
+    TextureMapperSoftwareCompositor::drawPixels(destination, clip, source, destinationRect, opacity,
+        isInMaskMode() ? TextureMapperSoftwareCompositor::DestinationIn : TextureMapperSoftwareCompositor::SourceOver);
+    endAccessingPixels(context);
+    return true;
+}
+
 void TextureMapperImageBuffer::drawTexture(const BitmapTexture& texture, const FloatRect& targetRect, const TransformationMatrix& matrix, float opacity, unsigned /* exposedEdges */, int /* flags */)
 {
     GraphicsContext* context = currentContext();
@@ -130,6 +291,9 @@ void TextureMapperImageBuffer::drawTexture(const BitmapTexture& texture, const F
         return;
 
     const BitmapTextureImageBuffer& textureImageBuffer = static_cast<const BitmapTextureImageBuffer&>(texture);
+    if (drawTextureInSoftware(textureImageBuffer, targetRect, matrix, opacity))
+        return;
+
     ImageBuffer* image = textureImageBuffer.m_image.get();
     context->save();
     context->setCompositeOperation(isInMaskMode() ? CompositeDestinationIn : CompositeSourceOver);
@@ -149,6 +313,19 @@ void TextureMapperImageBuffer::drawSolidColor(const FloatRect& rect, const Trans
     if (!context)
         return;
 
+    SoftwarePixelBuffer destination;
+    AffineTransform transform;
+    IntRect clip;
+    if (matrix.isAffine() && beginAccessingPixels(context, destination, transform, clip)) {
+        transform.multiply(matrix.toAffineTransform());
+        if (isAxisAlignedScaleAndTranslation(transform)) {
+            TextureMapperSoftwareCompositor::fillRect(destination, clip, transform.mapRect(rect), color.alpha() ? premultipliedARGBFromColor(color) : 0,
+                isInMaskMode() ? TextureMapperSoftwareCompositor::DestinationIn : TextureMapperSoftwareCompositor::SourceOver);
+            endAccessingPixels(context);
+            return;
+        }
+    }
+
     context->save();
     context->setCompositeOperation(isInMaskMode() ? CompositeDestinationIn : CompositeSourceOver);
 #if ENABLE(3D_RENDERING)
@@ -73,6 +73,8 @@ private:
     TextureMapperImageBuffer()
         : TextureMapper(SoftwareMode)
     { }
+
+    bool drawTextureInSoftware(const BitmapTextureImageBuffer&, const FloatRect& targetRect, const TransformationMatrix&, float opacity);
     RefPtr<BitmapTexture> m_currentSurface;
 };
 
@@ -89,9 +89,142 @@ void TextureMapperLayer::paint()
     TextureMapperPaintOptions options;
     options.textureMapper = m_textureMapper;
     options.textureMapper->bindSurface(0);
+
+    m_occlusions.clear();
+    computeOcclusionRecursive(m_occlusions, options.textureMapper->clipBounds(), true, 1);
+    options.textureMapper->cullingStatistics() = TextureMapper::CullingStatistics();
+
     paintRecursive(options);
 }
 
+static bool mapRectIfRectilinear(const TransformationMatrix& transform, const FloatRect& rect, FloatRect& mappedRect)
+{
+    if (!transform.isAffine())
+        return false;
+
+    FloatQuad quad = transform.mapQuad(rect);
+    if (!quad.isRectilinear())
+        return false;
+
+    mappedRect = quad.boundingBox();
+    return true;
+}
+
+bool TextureMapperLayer::computeOpaqueRect(FloatRect& opaqueRect) const
+{
+    if (!m_state.visible || !m_state.contentsVisible)
+        return false;
+
+    // Mirrors paintSelf(): a solid color replaces the rest of the layer's contents.
+    if (m_state.solidColor.isValid() && !m_state.contentsRect.isEmpty() && m_state.solidColor.alpha()) {
+        if (m_state.solidColor.hasAlpha())
+            return false;
+        opaqueRect = m_state.contentsRect;
+        return true;
+    }
+
+    if (m_state.contentsOpaque && m_backingStore && m_backingStore->hasTexturesForEntireContents()) {
+        opaqueRect = layerRect();
+        return true;
+    }
+
+    // Video, WebGL and canvas contents are painted over the backing store and fill the whole contents rect.
+    if (m_contentsLayer && !m_state.contentsRect.isEmpty() && m_contentsLayer->isOpaque()) {
+        opaqueRect = m_state.contentsRect;
+        return true;
+    }
+
+    return false;
+}
+
+// Walks the tree in the reverse of paint order. Every occluder appends the accumulated opaque region to
+// occlusions, and each layer records the index of the entry covering everything painted on top of it.
+// Subtrees that paint through an intermediate surface or more than once (replicas) are neither culled nor
+// used as occluders.
+void TextureMapperLayer::computeOcclusionRecursive(Vector<Region>& occlusions, const FloatRect& clipRect, bool clipIsRectilinear, float opacity)
+{
+    m_occlusionIndex = notFound;
+    if (!isVisible())
+        return;
+
+    if (shouldBlend() || m_state.replicaLayer) {
+        clearOcclusionRecursive();
+        return;
+    }
+
+    opacity *= m_currentOpacity;
+    TransformationMatrix transform = m_currentTransform.combined();
+
+    FloatRect childClipRect = clipRect;
+    bool childClipIsRectilinear = clipIsRectilinear;
+    if (m_state.masksToBounds && !m_state.preserves3D) {
+        FloatRect mappedLayerRect;
+        if (mapRectIfRectilinear(transform, layerRect(), mappedLayerRect))
+            childClipRect.intersect(mappedLayerRect);
+        else
+            childClipIsRectilinear = false;
+    }
+
+    for (size_t i = m_children.size(); i; --i)
+        m_children[i - 1]->computeOcclusionRecursive(occlusions, childClipRect, childClipIsRectilinear, opacity);
+
+    if (!occlusions.isEmpty() && (m_backingStore || m_contentsLayer || m_state.solidColor.isValid()))
+        m_occlusionIndex = occlusions.size() - 1;
+
+    // An unknown clip might cut into the opaque area, so only a rectilinear one lets this layer occlude.
+    FloatRect opaqueRect;
+    if (!clipIsRectilinear || opacity < 1 || !computeOpaqueRect(opaqueRect) || !mapRectIfRectilinear(transform, opaqueRect, opaqueRect))
+        return;
+
+    opaqueRect.intersect(clipRect);
+    IntRect occluderRect = enclosedIntRect(opaqueRect);
+    if (occluderRect.isEmpty())
+        return;
+
+    Region occlusion = occlusions.isEmpty() ? Region() : occlusions.last();
+    occlusion.unite(occluderRect);
+    occlusions.append(occlusion);
+}
+
+void TextureMapperLayer::clearOcclusionRecursive()
+{
+    m_occlusionIndex = notFound;
+    for (size_t i = 0; i < m_children.size(); ++i)
+        m_children[i]->clearOcclusionRecursive();
+}
+
+// Occlusion is in root layer coordinates, which only match when painting straight into the root surface.
+static bool isPaintingInRootCoordinates(const TextureMapperPaintOptions& options)
+{
+    return !options.surface && options.offset.isZero() && options.transform.isIdentity();
+}
+
+const Region* TextureMapperLayer::occlusion(const TextureMapperPaintOptions& options) const
+{
+    if (m_occlusionIndex == notFound || !isPaintingInRootCoordinates(options))
+        return 0;
+    return &rootLayer()->m_occlusions[m_occlusionIndex];
+}
+
+bool TextureMapperLayer::isOccluded(const TextureMapperPaintOptions& options)
+{
+    const Region* occlusion = this->occlusion(options);
+    if (!occlusion)
+        return false;
+
+    TransformationMatrix transform = m_currentTransform.combined();
+    if (!transform.isAffine())
+        return false;
+
+    FloatRect boundingRect = layerRect();
+    boundingRect.unite(m_state.contentsRect);
+    if (!occlusion->contains(enclosingIntRect(transform.mapRect(boundingRect))))
+        return false;
+
+    ++options.textureMapper->cullingStatistics().culledLayers;
+    return true;
+}
+
 static Color blendWithOpacity(const Color& color, float opacity)
 {
     RGBA32 rgba = color.rgb();
@@ -117,6 +250,9 @@ void TextureMapperLayer::paintSelf(const TextureMapperPaintOptions& options)
     if (!m_state.visible || !m_state.contentsVisible)
         return;
 
+    if (isOccluded(options))
+        return;
+
     // We apply the following transform to compensate for painting into a surface, and then apply the offset so that the painting fits in the target rect.
     TransformationMatrix transform;
     transform.translate(options.offset.width(), options.offset.height());
@@ -136,7 +272,8 @@ void TextureMapperLayer::paintSelf(const TextureMapperPaintOptions& options)
     if (m_backingStore) {
         FloatRect targetRect = layerRect();
         ASSERT(!targetRect.isEmpty());
-        m_backingStore->paintToTextureMapper(options.textureMapper, targetRect, transform, options.opacity);
+        const Region* occlusion = this->occlusion(options);
+        m_backingStore->paintUnoccludedTilesToTextureMapper(options.textureMapper, targetRect, transform, options.opacity, occlusion ? *occlusion : Region());
         if (m_state.showDebugBorders)
             m_backingStore->drawBorder(options.textureMapper, m_state.debugBorderColor, m_state.debugBorderWidth, targetRect, transform);
         // Only draw repaint count for the main backing store.
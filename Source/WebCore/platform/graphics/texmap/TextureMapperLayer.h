@@ -26,12 +26,12 @@
 #include "FloatRect.h"
 #include "GraphicsLayerAnimation.h"
 #include "GraphicsLayerTransform.h"
+#include "Region.h"
 #include "TextureMapper.h"
 #include "TextureMapperBackingStore.h"
 
 namespace WebCore {
 
-class Region;
 class TextureMapperPaintOptions;
 class TextureMapperPlatformLayer;
 
@@ -57,6 +57,7 @@ public:
         , m_scrollClient(0)
         , m_isScrollable(false)
         , m_patternTransformDirty(false)
+        , m_occlusionIndex(notFound)
     { }
 
     virtual ~TextureMapperLayer();
@@ -153,6 +154,12 @@ private:
     };
     void computeOverlapRegions(Region& overlapRegion, Region& nonOverlapRegion, ResolveSelfOverlapMode);
 
+    void computeOcclusionRecursive(Vector<Region>& occlusions, const FloatRect& clipRect, bool clipIsRectilinear, float opacity);
+    void clearOcclusionRecursive();
+    bool computeOpaqueRect(FloatRect&) const;
+    const Region* occlusion(const TextureMapperPaintOptions&) const;
+    bool isOccluded(const TextureMapperPaintOptions&);
+
     void paintRecursive(const TextureMapperPaintOptions&);
     void paintUsingOverlapRegions(const TextureMapperPaintOptions&);
     PassRefPtr<BitmapTexture> paintIntoSurface(const TextureMapperPaintOptions&, const IntSize&);
@@ -263,6 +270,13 @@ private:
     FloatSize m_accumulatedScrollOffsetFractionalPart;
     TransformationMatrix m_patternTransform;
     bool m_patternTransformDirty;
+
+    // Index into the root layer's m_occlusions of the opaque area of the layers painted after this one, or
+    // notFound. Only computed for layers that paint straight into the root surface.
+    size_t m_occlusionIndex;
+
+    // Accumulated opaque areas in root layer coordinates, one entry per occluder. Only filled in on the root layer.
+    Vector<Region> m_occlusions;
 };
 
 }
@@ -41,6 +41,8 @@ public:
     virtual ~TextureMapperPlatformLayer() { }
     virtual void paintToTextureMapper(TextureMapper*, const FloatRect&, const TransformationMatrix& modelViewMatrix = TransformationMatrix(), float opacity = 1.0) = 0;
     virtual void swapBuffers() { }
+    // True if paintToTextureMapper() fills the whole target rect with opaque pixels.
+    virtual bool isOpaque() const { return false; }
     virtual void drawBorder(TextureMapper* textureMapper, const Color& color, float borderWidth, const FloatRect& targetRect, const TransformationMatrix& transform)
     {
         textureMapper->drawBorder(color, borderWidth, targetRect, transform);
@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TextureMapperSoftwareCompositor.h"
+
+#if USE(TEXTURE_MAPPER)
+
+#include <wtf/MathExtras.h>
+#include <wtf/ParallelJobs.h>
+#include <wtf/Vector.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if HAVE(ARM_NEON_INTRINSICS) && !CPU(BIG_ENDIAN)
+#include <arm_neon.h>
+#define USE_NEON_COMPOSITING 1
+#endif
+
+namespace WebCore {
+
+// Below this many pixels a draw isn't worth handing to other threads.
+static const int s_minimumPixelsPerBand = 128 * 1024;
+
+// x * alpha / 255 for each of the four channels, rounded the same way by every kernel below.
+static inline uint32_t multiplyByAlpha(uint32_t pixel, unsigned alpha)
+{
+    uint32_t redBlue = (pixel & 0xff00ff) * alpha;
+    redBlue = (redBlue + ((redBlue >> 8) & 0xff00ff) + 0x800080) >> 8;
+    uint32_t alphaGreen = ((pixel >> 8) & 0xff00ff) * alpha;
+    alphaGreen = alphaGreen + ((alphaGreen >> 8) & 0xff00ff) + 0x800080;
+    return (redBlue & 0xff00ff) | (alphaGreen & 0xff00ff00);
+}
+
+// Adds each of the four channels, clamping at 255 like _mm_adds_epu8 and vqadd_u8. Valid premultiplied pixels
+// never overflow, but the vector kernels must give the same result as this one for any input.
+static inline uint32_t addSaturated(uint32_t a, uint32_t b)
+{
+    uint32_t redBlue = (a & 0xff00ff) + (b & 0xff00ff);
+    redBlue |= ((redBlue >> 8) & 0x10001) * 0xff;
+    uint32_t alphaGreen = ((a >> 8) & 0xff00ff) + ((b >> 8) & 0xff00ff);
+    alphaGreen |= ((alphaGreen >> 8) & 0x10001) * 0xff;
+    return (redBlue & 0xff00ff) | ((alphaGreen & 0xff00ff) << 8);
+}
+
+static inline void sourceOver(uint32_t& destination, uint32_t source, unsigned opacity)
+{
+    if (opacity != 255)
+        source = multiplyByAlpha(source, opacity);
+    if (!source)
+        return;
+    unsigned alpha = source >> 24;
+    if (alpha == 255)
+        destination = source;
+    else
+        destination = addSaturated(source, multiplyByAlpha(destination, 255 - alpha));
+}
+
+static inline void destinationIn(uint32_t& destination, uint32_t source, unsigned opacity)
+{
+    unsigned alpha = source >> 24;
+    if (opacity != 255)
+        alpha = multiplyByAlpha(alpha, opacity);
+    if (alpha != 255)
+        destination = multiplyByAlpha(destination, alpha);
+}
+
+#ifdef __SSE2__
+static inline __m128i multiplyByAlphaSSE2(__m128i pixels, __m128i alphaLow, __m128i alphaHigh)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(0x80);
+    __m128i low = _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), alphaLow);
+    __m128i high = _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), alphaHigh);
+    low = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), half), 8);
+    high = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), half), 8);
+    return _mm_packus_epi16(low, high);
+}
+
+// Spreads the alpha of each of the four pixels over the four 16-bit lanes of its channels.
+static inline void alphaLanesSSE2(__m128i pixels, __m128i& alphaLow, __m128i& alphaHigh)
+{
+    __m128i alpha = _mm_srli_epi32(pixels, 24);
+    alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+    alphaLow = _mm_unpacklo_epi32(alpha, alpha);
+    alphaHigh = _mm_unpackhi_epi32(alpha, alpha);
+}
+#endif
+
+#if USE(NEON_COMPOSITING)
+static inline uint8x8_t multiplyByAlphaNEON(uint8x8_t channel, uint8x8_t alpha)
+{
+    uint16x8_t product = vmull_u8(channel, alpha);
+    return vraddhn_u16(product, vshrq_n_u16(product, 8));
+}
+#endif
+
+static void sourceOverRow(uint32_t* destination, const uint32_t* source, int count, unsigned opacity, bool allowSIMD)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opacityLanes = _mm_set1_epi16(opacity);
+    const __m128i lanes255 = _mm_set1_epi16(255);
+    for (; allowSIMD && i + 4 <= count; i += 4) {
+        __m128i sourcePixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        if (opacity != 255)
+            sourcePixels = multiplyByAlphaSSE2(sourcePixels, opacityLanes, opacityLanes);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(sourcePixels, zero)) == 0xffff)
+            continue;
+        __m128i sourceAlpha = _mm_and_si128(sourcePixels, alphaMask);
+        __m128i* destinationPixels = reinterpret_cast<__m128i*>(destination + i);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(sourceAlpha, alphaMask)) == 0xffff) {
+            _mm_storeu_si128(destinationPixels, sourcePixels);
+            continue;
+        }
+        __m128i alphaLow, alphaHigh;
+        alphaLanesSSE2(sourcePixels, alphaLow, alphaHigh);
+        __m128i blended = multiplyByAlphaSSE2(_mm_loadu_si128(destinationPixels), _mm_sub_epi16(lanes255, alphaLow), _mm_sub_epi16(lanes255, alphaHigh));
+        _mm_storeu_si128(destinationPixels, _mm_adds_epu8(sourcePixels, blended));
+    }
+#elif USE(NEON_COMPOSITING)
+    const uint8x8_t opacityLanes = vdup_n_u8(opacity);
+    for (; allowSIMD && i + 8 <= count; i += 8) {
+        uint8x8x4_t sourcePixels = vld4_u8(reinterpret_cast<const uint8_t*>(source + i));
+        if (opacity != 255) {
+            for (int channel = 0; channel < 4; ++channel)
+                sourcePixels.val[channel] = multiplyByAlphaNEON(sourcePixels.val[channel], opacityLanes);
+        }
+        uint8x8_t inverseAlpha = vmvn_u8(sourcePixels.val[3]);
+        uint8x8x4_t destinationPixels = vld4_u8(reinterpret_cast<uint8_t*>(destination + i));
+        for (int channel = 0; channel < 4; ++channel)
+            destinationPixels.val[channel] = vqadd_u8(sourcePixels.val[channel], multiplyByAlphaNEON(destinationPixels.val[channel], inverseAlpha));
+        vst4_u8(reinterpret_cast<uint8_t*>(destination + i), destinationPixels);
+    }
+#endif
+    for (; i < count; ++i)
+        sourceOver(destination[i], source[i], opacity);
+}
+
+static void destinationInRow(uint32_t* destination, const uint32_t* source, int count, unsigned opacity, bool allowSIMD)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i opacityLanes = _mm_set1_epi16(opacity);
+    for (; allowSIMD && i + 4 <= count; i += 4) {
+        __m128i sourcePixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        if (opacity != 255)
+            sourcePixels = multiplyByAlphaSSE2(sourcePixels, opacityLanes, opacityLanes);
+        __m128i alphaLow, alphaHigh;
+        alphaLanesSSE2(sourcePixels, alphaLow, alphaHigh);
+        __m128i* destinationPixels = reinterpret_cast<__m128i*>(destination + i);
+        _mm_storeu_si128(destinationPixels, multiplyByAlphaSSE2(_mm_loadu_si128(destinationPixels), alphaLow, alphaHigh));
+    }
+#elif USE(NEON_COMPOSITING)
+    const uint8x8_t opacityLanes = vdup_n_u8(opacity);
+    for (; allowSIMD && i + 8 <= count; i += 8) {
+        uint8x8x4_t sourcePixels = vld4_u8(reinterpret_cast<const uint8_t*>(source + i));
+        uint8x8_t alpha = opacity != 255 ? multiplyByAlphaNEON(sourcePixels.val[3], opacityLanes) : sourcePixels.val[3];
+        uint8x8x4_t destinationPixels = vld4_u8(reinterpret_cast<uint8_t*>(destination + i));
+        for (int channel = 0; channel < 4; ++channel)
+            destinationPixels.val[channel] = multiplyByAlphaNEON(destinationPixels.val[channel], alpha);
+        vst4_u8(reinterpret_cast<uint8_t*>(destination + i), destinationPixels);
+    }
+#endif
+    for (; i < count; ++i)
+        destinationIn(destination[i], source[i], opacity);
+}
+
+void TextureMapperSoftwareCompositor::compositeRow(uint32_t* destination, const uint32_t* source, int count, unsigned opacity, CompositeMode mode, bool allowSIMD)
+{
+    if (mode == SourceOver)
+        sourceOverRow(destination, source, count, opacity, allowSIMD);
+    else
+        destinationInRow(destination, source, count, opacity, allowSIMD);
+}
+
+namespace {
+
+struct CompositeJob {
+    SoftwarePixelBuffer destination;
+    SoftwarePixelBuffer source; // No pixels when filling with |color|.
+    uint32_t color;
+    IntRect rect; // The destination pixels to composite.
+    FloatRect destinationRect;
+    bool isScaled;
+    unsigned opacity;
+    TextureMapperSoftwareCompositor::CompositeMode mode;
+};
+
+struct CompositeBand {
+    const CompositeJob* job;
+    int startY;
+    int endY;
+};
+
+} // namespace
+
+// Maps the center of destination pixel |position| back to the source pixel it samples.
+static inline int sourcePosition(int position, float destinationOrigin, float scale, int sourceSize)
+{
+    int result = static_cast<int>(floorf((position + 0.5f - destinationOrigin) * scale));
+    return std::min(std::max(result, 0), sourceSize - 1);
+}
+
+static void compositeRows(const CompositeJob& job, int startY, int endY)
+{
+    const IntRect& rect = job.rect;
+
+    Vector<uint32_t> sourceRow;
+    Vector<int> sourceColumns;
+    float scaleX = 1;
+    float scaleY = 1;
+    if (!job.source.pixels)
+        sourceRow.fill(job.color, rect.width());
+    else if (job.isScaled) {
+        scaleX = job.source.size.width() / job.destinationRect.width();
+        scaleY = job.source.size.height() / job.destinationRect.height();
+        sourceRow.resize(rect.width());
+        sourceColumns.resize(rect.width());
+        for (int x = 0; x < rect.width(); ++x)
+            sourceColumns[x] = sourcePosition(rect.x() + x, job.destinationRect.x(), scaleX, job.source.size.width());
+    }
+
+    int sourceOffsetX = 0;
+    int sourceOffsetY = 0;
+    if (job.source.pixels && !job.isScaled) {
+        sourceOffsetX = rect.x() - static_cast<int>(roundf(job.destinationRect.x()));
+        sourceOffsetY = -static_cast<int>(roundf(job.destinationRect.y()));
+    }
+
+    for (int y = startY; y < endY; ++y) {
+        uint32_t* destinationRow = job.destination.pixels + y * job.destination.stride + rect.x();
+        const uint32_t* source = sourceRow.data();
+        if (job.source.pixels) {
+            if (job.isScaled) {
+                const uint32_t* row = job.source.pixels + sourcePosition(y, job.destinationRect.y(), scaleY, job.source.size.height()) * job.source.stride;
+                for (int x = 0; x < rect.width(); ++x)
+                    sourceRow[x] = row[sourceColumns[x]];
+            } else
+                source = job.source.pixels + (y + sourceOffsetY) * job.source.stride + sourceOffsetX;
+        }
+        TextureMapperSoftwareCompositor::compositeRow(destinationRow, source, rect.width(), job.opacity, job.mode);
+    }
+}
+
+static void compositeBandWorker(CompositeBand* band)
+{
+    compositeRows(*band->job, band->startY, band->endY);
+}
+
+static void runCompositeJob(const CompositeJob& job)
+{
+    int bandCount = job.rect.width() * job.rect.height() / s_minimumPixelsPerBand;
+    if (bandCount > 1) {
+        ParallelJobs<CompositeBand> parallelJobs(&compositeBandWorker, std::min(bandCount, job.rect.height()));
+        size_t numberOfJobs = parallelJobs.numberOfJobs();
+        if (numberOfJobs > 1) {
+            int rowsPerBand = job.rect.height() / numberOfJobs;
+            int extraRows = job.rect.height() % numberOfJobs;
+            int startY = job.rect.y();
+            for (size_t i = 0; i < numberOfJobs; ++i) {
+                CompositeBand& band = parallelJobs.parameter(i);
+                band.job = &job;
+                band.startY = startY;
+                band.endY = startY + rowsPerBand + (static_cast<int>(i) < extraRows ? 1 : 0);
+                startY = band.endY;
+            }
+            parallelJobs.execute();
+            return;
+        }
+    }
+
+    compositeRows(job, job.rect.y(), job.rect.maxY());
+}
+
+// The pixels of |clipRect| whose centers lie inside |rect|.
+static IntRect coveredPixels(const FloatRect& rect, const IntRect& clipRect, const IntSize& bufferSize)
+{
+    int x = static_cast<int>(ceilf(rect.x() - 0.5f));
+    int y = static_cast<int>(ceilf(rect.y() - 0.5f));
+    int maxX = static_cast<int>(ceilf(rect.maxX() - 0.5f));
+    int maxY = static_cast<int>(ceilf(rect.maxY() - 0.5f));
+    IntRect pixels(x, y, maxX - x, maxY - y);
+    pixels.intersect(clipRect);
+    pixels.intersect(IntRect(IntPoint(), bufferSize));
+    return pixels;
+}
+
+void TextureMapperSoftwareCompositor::drawPixels(const SoftwarePixelBuffer& destination, const IntRect& clipRect, const SoftwarePixelBuffer& source,
+    const FloatRect& destinationRect, float opacity, CompositeMode mode)
+{
+    CompositeJob job;
+    job.rect = coveredPixels(destinationRect, clipRect, destination.size);
+    if (job.rect.isEmpty() || source.size.isEmpty())
+        return;
+
+    job.opacity = static_cast<unsigned>(clampTo<int>(lroundf(opacity * 255), 0, 255));
+    if (!job.opacity && mode == SourceOver)
+        return;
+
+    job.destination = destination;
+    job.source = source;
+    job.color = 0;
+    job.destinationRect = destinationRect;
+    job.isScaled = destinationRect.size() != FloatSize(source.size);
+    job.mode = mode;
+
+    if (!job.isScaled) {
+        // The source rect may be offset by a fraction of a pixel; snap it like the pixel coverage above.
+        IntRect sourceRect(roundedIntPoint(destinationRect.location()), source.size);
+        job.rect.intersect(sourceRect);
+        if (job.rect.isEmpty())
+            return;
+    }
+
+    runCompositeJob(job);
+}
+
+void TextureMapperSoftwareCompositor::fillRect(const SoftwarePixelBuffer& destination, const IntRect& clipRect, const FloatRect& rect, uint32_t premultipliedARGB, CompositeMode mode)
+{
+    CompositeJob job;
+    job.rect = coveredPixels(rect, clipRect, destination.size);
+    if (job.rect.isEmpty() || (!premultipliedARGB && mode == SourceOver))
+        return;
+
+    job.destination = destination;
+    job.color = premultipliedARGB;
+    job.destinationRect = rect;
+    job.isScaled = false;
+    job.opacity = 255;
+    job.mode = mode;
+    runCompositeJob(job);
+}
+
+void TextureMapperSoftwareCompositor::copyPixels(const SoftwarePixelBuffer& destination, const IntRect& targetRect, const uint8_t* data, int bytesPerLine)
+{
+    IntRect rect = intersection(targetRect, IntRect(IntPoint(), destination.size));
+    if (rect.isEmpty())
+        return;
+
+    const uint8_t* sourceRow = data + (rect.y() - targetRect.y()) * bytesPerLine + (rect.x() - targetRect.x()) * sizeof(uint32_t);
+    for (int y = rect.y(); y < rect.maxY(); ++y, sourceRow += bytesPerLine)
+        memcpy(destination.pixels + y * destination.stride + rect.x(), sourceRow, rect.width() * sizeof(uint32_t));
+}
+
+} // namespace WebCore
+
+#endif // USE(TEXTURE_MAPPER)
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TextureMapperSoftwareCompositor_h
+#define TextureMapperSoftwareCompositor_h
+
+#if USE(TEXTURE_MAPPER)
+
+#include "FloatRect.h"
+#include "IntRect.h"
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+
+// Premultiplied 32-bit ARGB pixels in native byte order, the layout of both QImage::Format_ARGB32_Premultiplied
+// and CAIRO_FORMAT_ARGB32.
+struct SoftwarePixelBuffer {
+    SoftwarePixelBuffer()
+        : pixels(0)
+        , stride(0)
+    {
+    }
+
+    uint32_t* pixels;
+    int stride; // In pixels.
+    IntSize size;
+};
+
+// CPU kernels used by TextureMapperImageBuffer when the destination and source pixels are directly accessible and
+// the layer transform is a plain scale and translation. Blending uses SSE2 or NEON when available, and large
+// draws are split into bands of rows that are composited on separate threads.
+class TextureMapperSoftwareCompositor {
+    WTF_MAKE_NONCOPYABLE(TextureMapperSoftwareCompositor);
+public:
+    enum CompositeMode {
+        SourceOver,
+        DestinationIn // Used for masks: multiplies the destination by the source alpha.
+    };
+
+    // Draws all of |source| into |destinationRect|, in destination pixels, sampling the nearest source pixel when
+    // scaled. Only the pixels inside |clipRect| whose centers are inside |destinationRect| are touched.
+    static void drawPixels(const SoftwarePixelBuffer& destination, const IntRect& clipRect, const SoftwarePixelBuffer& source,
+        const FloatRect& destinationRect, float opacity, CompositeMode);
+
+    static void fillRect(const SoftwarePixelBuffer& destination, const IntRect& clipRect, const FloatRect&, uint32_t premultipliedARGB, CompositeMode);
+
+    // Replaces the pixels of |targetRect| with rows of premultiplied ARGB data.
+    static void copyPixels(const SoftwarePixelBuffer& destination, const IntRect& targetRect, const uint8_t* data, int bytesPerLine);
+
+    // Composites |count| source pixels onto the destination row. Passing false for |allowSIMD| forces the scalar
+    // kernel, so that tests can check the SSE2 and NEON kernels against it.
+    static void compositeRow(uint32_t* destination, const uint32_t* source, int count, unsigned opacity, CompositeMode, bool allowSIMD = true);
+};
+
+} // namespace WebCore
+
+#endif // USE(TEXTURE_MAPPER)
+
+#endif // TextureMapperSoftwareCompositor_h
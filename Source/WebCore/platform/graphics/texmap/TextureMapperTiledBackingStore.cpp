@@ -23,6 +23,7 @@
 #include "TextureMapperTiledBackingStore.h"
 
 #include "ImageBuffer.h"
+#include "Region.h"
 #include "TextureMapper.h"
 
 namespace WebCore {
@@ -48,11 +49,51 @@ TransformationMatrix TextureMapperTiledBackingStore::adjustedTransformForRect(co
 }
 
 void TextureMapperTiledBackingStore::paintToTextureMapper(TextureMapper* textureMapper, const FloatRect& targetRect, const TransformationMatrix& transform, float opacity)
+{
+    paintUnoccludedTilesToTextureMapper(textureMapper, targetRect, transform, opacity, Region());
+}
+
+void TextureMapperTiledBackingStore::paintUnoccludedTilesToTextureMapper(TextureMapper* textureMapper, const FloatRect& targetRect, const TransformationMatrix& transform, float opacity, const Region& occlusion)
 {
     updateContentsFromImageIfNeeded(textureMapper);
     TransformationMatrix adjustedTransform = transform * adjustedTransformForRect(targetRect);
-    for (size_t i = 0; i < m_tiles.size(); ++i)
+    for (size_t i = 0; i < m_tiles.size(); ++i) {
+        if (isTileOccluded(textureMapper, m_tiles[i].rect(), adjustedTransform, occlusion))
+            continue;
         m_tiles[i].paint(textureMapper, adjustedTransform, opacity, calculateExposedTileEdges(rect(), m_tiles[i].rect()));
+    }
+}
+
+bool TextureMapperTiledBackingStore::hasTexturesForEntireContents() const
+{
+    // A pending image is uploaded to every tile before painting.
+    if (m_image)
+        return true;
+
+    if (m_tiles.isEmpty())
+        return false;
+
+    for (size_t i = 0; i < m_tiles.size(); ++i) {
+        if (!m_tiles[i].texture())
+            return false;
+    }
+    return true;
+}
+
+bool TextureMapperTiledBackingStore::isOpaque() const
+{
+    // Tiles are created with an alpha channel unless the uploaded image is known to be opaque.
+    if (m_image)
+        return m_image->currentFrameKnownToBeOpaque();
+
+    if (!hasTexturesForEntireContents())
+        return false;
+
+    for (size_t i = 0; i < m_tiles.size(); ++i) {
+        if (!m_tiles[i].texture()->isOpaque())
+            return false;
+    }
+    return true;
 }
 
 void TextureMapperTiledBackingStore::drawBorder(TextureMapper* textureMapper, const Color& borderColor, float borderWidth, const FloatRect& targetRect, const TransformationMatrix& transform)
@@ -39,6 +39,9 @@ public:
 
     virtual PassRefPtr<BitmapTexture> texture() const OVERRIDE;
     virtual void paintToTextureMapper(TextureMapper*, const FloatRect&, const TransformationMatrix&, float) OVERRIDE;
+    virtual void paintUnoccludedTilesToTextureMapper(TextureMapper*, const FloatRect&, const TransformationMatrix&, float, const Region&) OVERRIDE;
+    virtual bool hasTexturesForEntireContents() const OVERRIDE;
+    virtual bool isOpaque() const OVERRIDE;
     virtual void drawBorder(TextureMapper*, const Color&, float borderWidth, const FloatRect&, const TransformationMatrix&) OVERRIDE;
     virtual void drawRepaintCounter(TextureMapper*, int repaintCount, const Color&, const FloatRect&, const TransformationMatrix&) OVERRIDE;
     void updateContents(TextureMapper*, Image*, const FloatSize&, const IntRect&, BitmapTexture::UpdateContentsFlag);
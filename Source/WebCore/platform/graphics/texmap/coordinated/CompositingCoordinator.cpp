@@ -29,11 +29,13 @@
 #if USE(COORDINATED_GRAPHICS)
 #include "CompositingCoordinator.h"
 
+#include "CoordinatedSurfacePool.h"
 #include "Frame.h"
 #include "FrameView.h"
 #include "GraphicsContext.h"
 #include "InspectorController.h"
 #include "Page.h"
+#include "PaintRecording.h"
 #include "Settings.h"
 #include <wtf/CurrentTime.h>
 #include <wtf/TemporaryChange.h>
@@ -102,6 +104,7 @@ bool CompositingCoordinator::flushPendingLayerChanges()
     bool didSync = m_page->mainFrame()->view()->flushCompositingStateIncludingSubframes();
 
     toCoordinatedGraphicsLayer(m_rootLayer.get())->updateContentBuffersIncludingSubLayers();
+    m_tileRasterizer.rasterizePendingTiles();
     toCoordinatedGraphicsLayer(m_rootLayer.get())->syncPendingStateChangesIncludingSubLayers();
 
     flushPendingImageBackingChanges();
@@ -197,6 +200,11 @@ void CompositingCoordinator::syncLayerState(CoordinatedLayerID id, CoordinatedGr
     m_state.layersToUpdate.append(std::make_pair(id, state));
 }
 
+bool CompositingCoordinator::layerDisplayListCachingEnabled() const
+{
+    return m_page->settings()->layerDisplayListCachingEnabled();
+}
+
 PassRefPtr<CoordinatedImageBacking> CompositingCoordinator::createImageBackingIfNeeded(Image* image)
 {
     CoordinatedImageBackingID imageID = CoordinatedImageBacking::getCoordinatedImageBackingID(image);
@@ -380,24 +388,52 @@ void CompositingCoordinator::purgeBackingStores()
         it->value->purgeBackingStores();
 
     m_imageBackings.clear();
+    m_tileRasterizer.discardPendingTiles();
     m_updateAtlases.clear();
+
+    // The web page is going away or into the background; don't hold on to idle shared memory for it.
+    CoordinatedSurfacePool::sharedPool()->drain();
 }
 
 bool CompositingCoordinator::paintToSurface(const IntSize& size, CoordinatedSurface::Flags flags, uint32_t& atlasID, IntPoint& offset, CoordinatedSurface::Client* client)
+{
+    IntRect area;
+    UpdateAtlas* atlas = reserveUpdateAtlasArea(size, flags, atlasID, area);
+    if (!atlas)
+        return false;
+    offset = area.location();
+
+    if (m_page->settings()->parallelTileRasterizationEnabled()) {
+        // Only record here; flushPendingLayerChanges() has the recordings rasterized on worker threads.
+        OwnPtr<PaintRecording> recording = PaintRecording::create(size);
+        if (recording) {
+            client->paintToSurfaceContext(recording->context());
+            recording->endRecording();
+            m_tileRasterizer.appendTile(atlas, area, recording.release());
+            return true;
+        }
+    }
+
+    atlas->paintToArea(area, client);
+    return true;
+}
+
+UpdateAtlas* CompositingCoordinator::reserveUpdateAtlasArea(const IntSize& size, CoordinatedSurface::Flags flags, uint32_t& atlasID, IntRect& area)
 {
     for (unsigned i = 0; i < m_updateAtlases.size(); ++i) {
         UpdateAtlas* atlas = m_updateAtlases[i].get();
         if (atlas->supportsAlpha() == (flags & CoordinatedSurface::SupportsAlpha)) {
             // This will be false if there is no available buffer space.
-            if (atlas->paintOnAvailableBuffer(size, atlasID, offset, client))
-                return true;
+            if (atlas->reserveArea(size, atlasID, area))
+                return atlas;
         }
     }
 
     static const int ScratchBufferDimension = 1024; // Should be a power of two.
     m_updateAtlases.append(adoptPtr(new UpdateAtlas(this, ScratchBufferDimension, flags)));
     scheduleReleaseInactiveAtlases();
-    return m_updateAtlases.last()->paintOnAvailableBuffer(size, atlasID, offset, client);
+    UpdateAtlas* atlas = m_updateAtlases.last().get();
+    return atlas->reserveArea(size, atlasID, area) ? atlas : 0;
 }
 
 const double ReleaseInactiveAtlasesTimerInterval = 0.5;
@@ -36,6 +36,7 @@
 #include "GraphicsLayerClient.h"
 #include "GraphicsLayerFactory.h"
 #include "IntRect.h"
+#include "TileRasterizer.h"
 #include "Timer.h"
 #include "UpdateAtlas.h"
 #include <wtf/OwnPtr.h>
@@ -116,6 +117,7 @@ private:
     virtual void detachLayer(CoordinatedGraphicsLayer*) OVERRIDE;
     virtual bool paintToSurface(const WebCore::IntSize&, WebCore::CoordinatedSurface::Flags, uint32_t& /* atlasID */, WebCore::IntPoint&, WebCore::CoordinatedSurface::Client*) OVERRIDE;
     virtual void syncLayerState(CoordinatedLayerID, CoordinatedGraphicsLayerState&) OVERRIDE;
+    virtual bool layerDisplayListCachingEnabled() const OVERRIDE;
 
     // UpdateAtlas::Client
     virtual void createUpdateAtlas(uint32_t atlasID, PassRefPtr<CoordinatedSurface>) OVERRIDE;
@@ -128,6 +130,7 @@ private:
     void flushPendingImageBackingChanges();
     void clearPendingStateChanges();
 
+    UpdateAtlas* reserveUpdateAtlasArea(const IntSize&, CoordinatedSurface::Flags, uint32_t& atlasID, IntRect& area);
     void scheduleReleaseInactiveAtlases();
 
     void releaseInactiveAtlasesTimerFired(Timer<CompositingCoordinator>*);
@@ -145,6 +148,7 @@ private:
     typedef HashMap<CoordinatedImageBackingID, RefPtr<CoordinatedImageBacking> > ImageBackingMap;
     ImageBackingMap m_imageBackings;
     Vector<OwnPtr<UpdateAtlas> > m_updateAtlases;
+    TileRasterizer m_tileRasterizer;
 
     // We don't send the messages related to releasing resources to renderer during purging, because renderer already had removed all resources.
     bool m_isPurging;
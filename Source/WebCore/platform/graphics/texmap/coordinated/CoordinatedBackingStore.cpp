@@ -23,6 +23,7 @@
 #if USE(COORDINATED_GRAPHICS)
 #include "CoordinatedSurface.h"
 #include "GraphicsLayer.h"
+#include "Region.h"
 #include "TextureMapper.h"
 #include "TextureMapperGL.h"
 
@@ -42,7 +43,8 @@ void CoordinatedBackingStoreTile::swapBuffers(TextureMapper* textureMapper)
     }
     RefPtr<BitmapTexture> texture = this->texture();
     if (!texture) {
-        texture = textureMapper->createTexture();
+        // Tiles come and go while scrolling, so recycle their textures through the pool.
+        texture = textureMapper->acquireTextureFromPool(m_tileRect.size());
         setTexture(texture.get());
         shouldReset = true;
     }
@@ -107,10 +109,13 @@ void CoordinatedBackingStore::setSize(const FloatSize& size)
     m_pendingSize = size;
 }
 
-void CoordinatedBackingStore::paintTilesToTextureMapper(Vector<TextureMapperTile*>& tiles, TextureMapper* textureMapper, const TransformationMatrix& transform, float opacity, const FloatRect& rect)
+void CoordinatedBackingStore::paintTilesToTextureMapper(Vector<TextureMapperTile*>& tiles, TextureMapper* textureMapper, const TransformationMatrix& transform, float opacity, const FloatRect& rect, const Region& occlusion)
 {
-    for (size_t i = 0; i < tiles.size(); ++i)
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (isTileOccluded(textureMapper, tiles[i]->rect(), transform, occlusion))
+            continue;
         tiles[i]->paint(textureMapper, transform, opacity, calculateExposedTileEdges(rect, tiles[i]->rect()));
+    }
 }
 
 TransformationMatrix CoordinatedBackingStore::adjustedTransformForRect(const FloatRect& targetRect)
@@ -119,6 +124,11 @@ TransformationMatrix CoordinatedBackingStore::adjustedTransformForRect(const Flo
 }
 
 void CoordinatedBackingStore::paintToTextureMapper(TextureMapper* textureMapper, const FloatRect& targetRect, const TransformationMatrix& transform, float opacity)
+{
+    paintUnoccludedTilesToTextureMapper(textureMapper, targetRect, transform, opacity, Region());
+}
+
+void CoordinatedBackingStore::paintUnoccludedTilesToTextureMapper(TextureMapper* textureMapper, const FloatRect& targetRect, const TransformationMatrix& transform, float opacity, const Region& occlusion)
 {
     if (m_tiles.isEmpty())
         return;
@@ -153,8 +163,30 @@ void CoordinatedBackingStore::paintToTextureMapper(TextureMapper* textureMapper,
     // See TiledBackingStore.
     TransformationMatrix adjustedTransform = transform * adjustedTransformForRect(targetRect);
 
-    paintTilesToTextureMapper(previousTilesToPaint, textureMapper, adjustedTransform, opacity, rect());
-    paintTilesToTextureMapper(tilesToPaint, textureMapper, adjustedTransform, opacity, rect());
+    paintTilesToTextureMapper(previousTilesToPaint, textureMapper, adjustedTransform, opacity, rect(), occlusion);
+    paintTilesToTextureMapper(tilesToPaint, textureMapper, adjustedTransform, opacity, rect(), occlusion);
+}
+
+bool CoordinatedBackingStore::hasTexturesForEntireContents() const
+{
+    if (m_tiles.isEmpty() || m_size.isEmpty())
+        return false;
+
+    // Tiles are laid out on integer boundaries at the current scale, so compare coverage there.
+    Region coveredRegion;
+    CoordinatedBackingStoreTileMap::const_iterator end = m_tiles.end();
+    for (CoordinatedBackingStoreTileMap::const_iterator it = m_tiles.begin(); it != end; ++it) {
+        const CoordinatedBackingStoreTile& tile = it->value;
+        if (!tile.texture() || tile.scale() != m_scale)
+            continue;
+        FloatRect scaledTileRect = tile.rect();
+        scaledTileRect.scale(m_scale);
+        coveredRegion.unite(roundedIntRect(scaledTileRect));
+    }
+
+    FloatRect scaledRect = rect();
+    scaledRect.scale(m_scale);
+    return coveredRegion.contains(enclosedIntRect(scaledRect));
 }
 
 void CoordinatedBackingStore::drawBorder(TextureMapper* textureMapper, const Color& borderColor, float borderWidth, const FloatRect& targetRect, const TransformationMatrix& transform)
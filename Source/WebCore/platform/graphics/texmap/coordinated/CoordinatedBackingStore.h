@@ -63,6 +63,8 @@ public:
     PassRefPtr<BitmapTexture> texture() const;
     void setSize(const FloatSize&);
     virtual void paintToTextureMapper(TextureMapper*, const FloatRect&, const TransformationMatrix&, float);
+    virtual void paintUnoccludedTilesToTextureMapper(TextureMapper*, const FloatRect&, const TransformationMatrix&, float, const Region&) OVERRIDE;
+    virtual bool hasTexturesForEntireContents() const OVERRIDE;
     virtual void drawBorder(TextureMapper*, const Color&, float borderWidth, const FloatRect&, const TransformationMatrix&) OVERRIDE;
     virtual void drawRepaintCounter(TextureMapper*, int repaintCount, const Color&, const FloatRect&, const TransformationMatrix&) OVERRIDE;
 
@@ -70,7 +72,7 @@ private:
     CoordinatedBackingStore()
         : m_scale(1.)
     { }
-    void paintTilesToTextureMapper(Vector<TextureMapperTile*>&, TextureMapper*, const TransformationMatrix&, float, const FloatRect&);
+    void paintTilesToTextureMapper(Vector<TextureMapperTile*>&, TextureMapper*, const TransformationMatrix&, float, const FloatRect&, const Region& occlusion);
     TransformationMatrix adjustedTransformForRect(const FloatRect&);
     FloatRect rect() const { return FloatRect(FloatPoint::zero(), m_size); }
 
@@ -26,11 +26,13 @@
 #include "CoordinatedGraphicsLayer.h"
 
 #include "CoordinatedTile.h"
+#include "DisplayList.h"
 #include "FloatQuad.h"
 #include "Frame.h"
 #include "FrameView.h"
 #include "GraphicsContext.h"
 #include "GraphicsLayer.h"
+#include "Logging.h"
 #include "Page.h"
 #include "ScrollableArea.h"
 #include "TextureMapperPlatformLayer.h"
@@ -121,6 +123,7 @@ CoordinatedGraphicsLayer::CoordinatedGraphicsLayer(GraphicsLayerClient* client)
 #endif
     , m_coordinator(0)
     , m_compositedNativeImagePtr(0)
+    , m_displayListRecordingFailed(false)
     , m_canvasPlatformLayer(0)
     , m_animationStartedTimer(this, &CoordinatedGraphicsLayer::animationStartedTimerFired)
     , m_scrollableArea(0)
@@ -553,6 +556,8 @@ void CoordinatedGraphicsLayer::setNeedsDisplayInRect(const FloatRect& rect)
     if (m_mainBackingStore)
         m_mainBackingStore->invalidate(IntRect(rect));
 
+    invalidateDisplayList(enclosingIntRect(rect));
+
     didChangeLayerState();
 
     addRepaintRect(rect);
@@ -909,13 +914,78 @@ void CoordinatedGraphicsLayer::createBackingStore()
     m_mainBackingStore = adoptPtr(new TiledBackingStore(this, CoordinatedTileBackend::create(this)));
     m_mainBackingStore->setSupportsAlpha(!contentsOpaque());
     m_mainBackingStore->setContentsScale(effectiveContentsScale());
+
+    // The recording snaps to device pixels using the scale of the backing store it was made for.
+    m_displayList.clear();
+}
+
+void CoordinatedGraphicsLayer::invalidateDisplayList(const IntRect& rect)
+{
+    m_displayListRecordingFailed = false;
+    if (!m_displayList || !m_displayList->bounds().intersects(rect))
+        return;
+
+    // Only what was invalidated is stale; a bounding rect of scattered repaints would soon cover
+    // most of the layer.
+    IntRect recordedRect = enclosingIntRect(m_displayList->bounds());
+    m_staleDisplayListRegion.unite(intersection(rect, recordedRect));
+
+    // Small repaints keep the recording for the rest of the layer; once a good part of it is
+    // out of date it is cheaper to record it again on the next paint.
+    if (2 * static_cast<uint64_t>(m_staleDisplayListRegion.totalArea()) > static_cast<uint64_t>(recordedRect.width()) * recordedRect.height()) {
+        m_displayList.clear();
+        m_staleDisplayListRegion = Region();
+    }
+}
+
+void CoordinatedGraphicsLayer::recordDisplayListIfNeeded(const IntRect& rect)
+{
+    if (m_displayListRecordingFailed || !m_coordinator || !m_coordinator->layerDisplayListCachingEnabled()) {
+        m_displayList.clear();
+        return;
+    }
+
+    if (m_displayList && m_displayList->bounds().contains(rect))
+        return;
+
+    IntRect recordRect = m_mainBackingStore->mapToContents(m_mainBackingStore->coverRect());
+    recordRect.unite(rect);
+    recordRect.intersect(tiledBackingStoreContentsRect());
+    if (recordRect.isEmpty())
+        return;
+
+    AffineTransform baseCTM;
+    baseCTM.scale(m_mainBackingStore->contentsScale());
+    DisplayListRecorder recorder(recordRect, baseCTM);
+    paintGraphicsLayerContents(*recorder.context(), recordRect);
+
+    m_displayList = recorder.finishRecording();
+    m_staleDisplayListRegion = Region();
+    if (!m_displayList) {
+        // Something painted straight into the platform context; keep painting directly until
+        // the layer is invalidated again.
+        m_displayListRecordingFailed = true;
+        return;
+    }
+
+    LOG(Compositing, "CoordinatedGraphicsLayer %p recorded %zu items (%zu bytes) for %dx%d", this,
+        m_displayList->itemCount(), m_displayList->sizeInBytes(), recordRect.width(), recordRect.height());
 }
 
 void CoordinatedGraphicsLayer::tiledBackingStorePaint(GraphicsContext* context, const IntRect& rect)
 {
     if (rect.isEmpty())
         return;
-    paintGraphicsLayerContents(*context, rect);
+
+    recordDisplayListIfNeeded(rect);
+    if (!m_displayList || m_staleDisplayListRegion.intersects(rect)) {
+        paintGraphicsLayerContents(*context, rect);
+        return;
+    }
+
+    GraphicsContextStateSaver stateSaver(*context);
+    context->clip(rect);
+    m_displayList->replay(*context, rect);
 }
 
 void CoordinatedGraphicsLayer::tiledBackingStorePaintEnd(const Vector<IntRect>& updatedRects)
@@ -1030,6 +1100,7 @@ void CoordinatedGraphicsLayer::updateContentBuffers()
     if (!shouldHaveBackingStore()) {
         m_mainBackingStore.clear();
         m_previousBackingStore.clear();
+        m_displayList.clear();
         return;
     }
 
@@ -1064,6 +1135,7 @@ void CoordinatedGraphicsLayer::purgeBackingStores()
 #endif
     m_mainBackingStore.clear();
     m_previousBackingStore.clear();
+    m_displayList.clear();
 
     releaseImageBackingIfNeeded();
 
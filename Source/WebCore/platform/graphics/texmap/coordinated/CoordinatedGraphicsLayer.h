@@ -30,6 +30,7 @@
 #include "GraphicsLayerTransform.h"
 #include "Image.h"
 #include "IntSize.h"
+#include "Region.h"
 #include "RunLoop.h"
 #include "TextureMapperPlatformLayer.h"
 #include "TiledBackingStore.h"
@@ -44,6 +45,7 @@
 
 namespace WebCore {
 class CoordinatedGraphicsLayer;
+class DisplayList;
 class GraphicsLayerAnimations;
 class ScrollableArea;
 
@@ -56,6 +58,7 @@ public:
     virtual bool paintToSurface(const IntSize&, CoordinatedSurface::Flags, uint32_t& atlasID, IntPoint&, CoordinatedSurface::Client*) = 0;
 
     virtual void syncLayerState(CoordinatedLayerID, CoordinatedGraphicsLayerState&) = 0;
+    virtual bool layerDisplayListCachingEnabled() const = 0;
 };
 
 class CoordinatedGraphicsLayer : public GraphicsLayer
@@ -204,6 +207,9 @@ private:
     void createBackingStore();
     void releaseImageBackingIfNeeded();
 
+    void invalidateDisplayList(const IntRect&);
+    void recordDisplayListIfNeeded(const IntRect&);
+
     // CoordinatedImageBacking::Host
     virtual bool imageBackingVisible() OVERRIDE;
     bool shouldHaveBackingStore() const;
@@ -247,6 +253,13 @@ private:
     OwnPtr<TiledBackingStore> m_mainBackingStore;
     OwnPtr<TiledBackingStore> m_previousBackingStore;
 
+    // Recording of the layer contents over (at least) the cover rect of the main backing store.
+    // Tiles intersecting m_staleDisplayListRegion are painted directly since the recording is
+    // out of date there.
+    OwnPtr<DisplayList> m_displayList;
+    Region m_staleDisplayListRegion;
+    bool m_displayListRecordingFailed;
+
     RefPtr<Image> m_compositedImage;
     NativeImagePtr m_compositedNativeImagePtr;
     RefPtr<CoordinatedImageBacking> m_coordinatedImageBacking;
@@ -29,6 +29,7 @@
 #include "CoordinatedImageBacking.h"
 
 #include "CoordinatedGraphicsState.h"
+#include "CoordinatedSurfacePool.h"
 #include "GraphicsContext.h"
 
 namespace WebCore {
@@ -122,7 +123,7 @@ void CoordinatedImageBacking::update()
         }
     }
 
-    m_surface = CoordinatedSurface::create(m_image->size(), !m_image->currentFrameKnownToBeOpaque() ? CoordinatedSurface::SupportsAlpha : CoordinatedSurface::NoFlags);
+    m_surface = CoordinatedSurfacePool::sharedPool()->takeSurface(m_image->size(), !m_image->currentFrameKnownToBeOpaque() ? CoordinatedSurface::SupportsAlpha : CoordinatedSurface::NoFlags);
     if (!m_surface) {
         m_isDirty = false;
         return;
@@ -143,7 +144,7 @@ void CoordinatedImageBacking::releaseSurfaceIfNeeded()
 {
     // We must keep m_surface until UI Process reads m_surface.
     // If m_surface exists, it was created in the previous update.
-    m_surface.clear();
+    CoordinatedSurfacePool::sharedPool()->addSurface(m_surface.release());
 }
 
 static const double clearContentsTimerInterval = 3;
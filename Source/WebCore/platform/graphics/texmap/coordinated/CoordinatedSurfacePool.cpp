@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "CoordinatedSurfacePool.h"
+
+#if USE(COORDINATED_GRAPHICS)
+
+namespace WebCore {
+
+static const size_t defaultCapacity = 32 * 1024 * 1024;
+
+CoordinatedSurfacePool::CoordinatedSurfacePool()
+    : m_capacity(defaultCapacity)
+{
+}
+
+CoordinatedSurfacePool* CoordinatedSurfacePool::sharedPool()
+{
+    static CoordinatedSurfacePool* sharedPool = new CoordinatedSurfacePool;
+    return sharedPool;
+}
+
+size_t CoordinatedSurfacePool::bytesForSize(const IntSize& size)
+{
+    return static_cast<size_t>(size.width()) * size.height() * 4;
+}
+
+CoordinatedSurfacePool::SurfaceList& CoordinatedSurfacePool::listOfSurfacesWithSize(const IntSize& size, AccessType accessType)
+{
+    HashMap<IntSize, SurfaceList>::iterator it = m_reuseLists.find(size);
+    if (it == m_reuseLists.end()) {
+        it = m_reuseLists.add(size, SurfaceList()).iterator;
+        m_sizesInPruneOrder.append(size);
+    } else if (accessType == MarkAsUsed) {
+        m_sizesInPruneOrder.remove(m_sizesInPruneOrder.reverseFind(size));
+        m_sizesInPruneOrder.append(size);
+    }
+    return it->value;
+}
+
+PassRefPtr<CoordinatedSurface> CoordinatedSurfacePool::takeSurface(const IntSize& size, CoordinatedSurface::Flags flags)
+{
+    if (!size.isEmpty() && m_reuseLists.contains(size)) {
+        SurfaceList& reuseList = listOfSurfacesWithSize(size, MarkAsUsed);
+        bool supportsAlpha = flags & CoordinatedSurface::SupportsAlpha;
+        for (SurfaceList::iterator it = reuseList.begin(); it != reuseList.end(); ++it) {
+            if ((*it)->supportsAlpha() != supportsAlpha)
+                continue;
+
+            RefPtr<CoordinatedSurface> surface = it->release();
+            reuseList.remove(it);
+            if (reuseList.isEmpty()) {
+                m_reuseLists.remove(size);
+                m_sizesInPruneOrder.removeLast();
+            }
+
+            m_statistics.idleBytes -= bytesForSize(size);
+            --m_statistics.idleSurfaces;
+            ++m_statistics.reusedSurfaces;
+            return surface.release();
+        }
+    }
+
+    RefPtr<CoordinatedSurface> surface = CoordinatedSurface::create(size, flags);
+    if (surface)
+        ++m_statistics.createdSurfaces;
+    return surface.release();
+}
+
+void CoordinatedSurfacePool::addSurface(PassRefPtr<CoordinatedSurface> prpSurface)
+{
+    RefPtr<CoordinatedSurface> surface = prpSurface;
+    if (!surface || !surface->hasOneRef())
+        return;
+
+    IntSize size = surface->size();
+    if (size.isEmpty() || bytesForSize(size) > m_capacity)
+        return;
+
+    listOfSurfacesWithSize(size, MarkAsUsed).prepend(surface.release());
+    m_statistics.idleBytes += bytesForSize(size);
+    ++m_statistics.idleSurfaces;
+
+    pruneToCapacity();
+}
+
+void CoordinatedSurfacePool::pruneToCapacity()
+{
+    while (m_statistics.idleBytes > m_capacity) {
+        ASSERT(!m_sizesInPruneOrder.isEmpty());
+        IntSize sizeToDrop = m_sizesInPruneOrder.first();
+        SurfaceList& oldestReuseList = m_reuseLists.find(sizeToDrop)->value;
+        if (oldestReuseList.isEmpty()) {
+            m_reuseLists.remove(sizeToDrop);
+            m_sizesInPruneOrder.remove(0);
+            continue;
+        }
+
+        // The last surface in the list is the one that has been idle longest.
+        oldestReuseList.removeLast();
+        m_statistics.idleBytes -= bytesForSize(sizeToDrop);
+        --m_statistics.idleSurfaces;
+        ++m_statistics.evictedSurfaces;
+    }
+}
+
+void CoordinatedSurfacePool::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    pruneToCapacity();
+}
+
+void CoordinatedSurfacePool::drain()
+{
+    m_statistics.evictedSurfaces += m_statistics.idleSurfaces;
+    m_statistics.idleSurfaces = 0;
+    m_statistics.idleBytes = 0;
+    m_reuseLists.clear();
+    m_sizesInPruneOrder.clear();
+}
+
+} // namespace WebCore
+
+#endif // USE(COORDINATED_GRAPHICS)
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CoordinatedSurfacePool_h
+#define CoordinatedSurfacePool_h
+
+#if USE(COORDINATED_GRAPHICS)
+
+#include "CoordinatedSurface.h"
+#include "IntSizeHash.h"
+#include <wtf/Deque.h>
+#include <wtf/HashMap.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// Keeps CoordinatedSurfaces that are no longer used so that new atlases and image backings of the same
+// size can reuse them instead of allocating new shared memory. Idle surfaces are bucketed by size and the
+// least recently used sizes are evicted first once the pool grows past its capacity.
+class CoordinatedSurfacePool {
+    WTF_MAKE_NONCOPYABLE(CoordinatedSurfacePool);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static CoordinatedSurfacePool* sharedPool();
+
+    // Returns an idle surface of the given size and flags if there is one, otherwise creates a new one.
+    PassRefPtr<CoordinatedSurface> takeSurface(const IntSize&, CoordinatedSurface::Flags);
+
+    // Surfaces still referenced elsewhere, e.g. by a pending state update, are not kept.
+    void addSurface(PassRefPtr<CoordinatedSurface>);
+
+    void drain();
+
+    // The maximum size of all idle surfaces in bytes.
+    size_t capacity() const { return m_capacity; }
+    void setCapacity(size_t);
+
+    struct Statistics {
+        Statistics()
+            : idleBytes(0)
+            , idleSurfaces(0)
+            , reusedSurfaces(0)
+            , createdSurfaces(0)
+            , evictedSurfaces(0)
+        { }
+
+        size_t idleBytes;
+        unsigned idleSurfaces;
+        unsigned reusedSurfaces;
+        unsigned createdSurfaces;
+        unsigned evictedSurfaces;
+    };
+    const Statistics& statistics() const { return m_statistics; }
+
+private:
+    CoordinatedSurfacePool();
+
+    typedef Deque<RefPtr<CoordinatedSurface> > SurfaceList;
+
+    enum AccessType { LeaveUnchanged, MarkAsUsed };
+    SurfaceList& listOfSurfacesWithSize(const IntSize&, AccessType = LeaveUnchanged);
+    void pruneToCapacity();
+
+    static size_t bytesForSize(const IntSize&);
+
+    HashMap<IntSize, SurfaceList> m_reuseLists;
+    // Ordered by recent use. The last size is the most recently used.
+    Vector<IntSize> m_sizesInPruneOrder;
+    size_t m_capacity;
+    Statistics m_statistics;
+};
+
+} // namespace WebCore
+
+#endif // USE(COORDINATED_GRAPHICS)
+
+#endif // CoordinatedSurfacePool_h
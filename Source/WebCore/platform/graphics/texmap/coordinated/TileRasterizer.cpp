@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TileRasterizer.h"
+
+#if USE(COORDINATED_GRAPHICS)
+
+#include "GraphicsContext.h"
+#include "PaintRecording.h"
+#include "UpdateAtlas.h"
+#include <wtf/Atomics.h>
+#include <wtf/ParallelJobs.h>
+
+namespace WebCore {
+
+class RasterizedTileSurfaceClient : public CoordinatedSurface::Client {
+public:
+    explicit RasterizedTileSurfaceClient(const PaintRecording* recording)
+        : m_recording(recording)
+    {
+    }
+
+    virtual void paintToSurfaceContext(GraphicsContext* context) OVERRIDE
+    {
+        m_recording->drawRasterizedImage(context, IntPoint());
+    }
+
+private:
+    const PaintRecording* m_recording;
+};
+
+TileRasterizer::TileRasterizer()
+{
+}
+
+TileRasterizer::~TileRasterizer()
+{
+}
+
+void TileRasterizer::appendTile(UpdateAtlas* atlas, const IntRect& area, PassOwnPtr<PaintRecording> recording)
+{
+    ASSERT(!recording->context());
+    OwnPtr<PendingTile> tile = adoptPtr(new PendingTile);
+    tile->atlas = atlas;
+    tile->area = area;
+    tile->recording = recording;
+    m_pendingTiles.append(tile.release());
+}
+
+void TileRasterizer::rasterizeWorker(RasterizeParameters* parameters)
+{
+    // Tiles differ a lot in cost, so instead of splitting them up front every worker keeps taking the next one.
+    int tileCount = parameters->tiles->size();
+    for (int index = atomicIncrement(parameters->nextTileIndex) - 1; index < tileCount; index = atomicIncrement(parameters->nextTileIndex) - 1)
+        parameters->tiles->at(index)->recording->rasterize();
+}
+
+void TileRasterizer::rasterizePendingTiles()
+{
+    if (m_pendingTiles.isEmpty())
+        return;
+
+    int nextTileIndex = 0;
+    ParallelJobs<RasterizeParameters> parallelJobs(&rasterizeWorker, static_cast<int>(m_pendingTiles.size()));
+    for (size_t i = 0; i < parallelJobs.numberOfJobs(); ++i) {
+        RasterizeParameters& parameters = parallelJobs.parameter(i);
+        parameters.tiles = &m_pendingTiles;
+        parameters.nextTileIndex = &nextTileIndex;
+    }
+    parallelJobs.execute();
+
+    // Surfaces are not thread safe, so the copies into the atlases happen back on the main thread. Going
+    // through the atlas clears the area first exactly when painting directly would.
+    for (size_t i = 0; i < m_pendingTiles.size(); ++i) {
+        PendingTile* tile = m_pendingTiles[i].get();
+        ASSERT(tile->recording->isRasterized());
+        RasterizedTileSurfaceClient client(tile->recording.get());
+        tile->atlas->paintToArea(tile->area, &client);
+    }
+    m_pendingTiles.clear();
+}
+
+} // namespace WebCore
+
+#endif // USE(COORDINATED_GRAPHICS)
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TileRasterizer_h
+#define TileRasterizer_h
+
+#if USE(COORDINATED_GRAPHICS)
+
+#include "IntRect.h"
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class PaintRecording;
+class UpdateAtlas;
+
+// Rasterizes the tiles painted during a layer flush on worker threads. CompositingCoordinator records
+// the painting of each tile on the main thread and queues the recording together with the update
+// atlas area it belongs to. rasterizePendingTiles() rasterizes all of them in parallel and copies each
+// result into its atlas, so the tiles are ready by the time the scene state is committed.
+class TileRasterizer {
+    WTF_MAKE_NONCOPYABLE(TileRasterizer); WTF_MAKE_FAST_ALLOCATED;
+public:
+    TileRasterizer();
+    ~TileRasterizer();
+
+    void appendTile(UpdateAtlas*, const IntRect& area, PassOwnPtr<PaintRecording>);
+    bool hasPendingTiles() const { return !m_pendingTiles.isEmpty(); }
+    void rasterizePendingTiles();
+
+    // Must be called before any atlas with pending tiles goes away.
+    void discardPendingTiles() { m_pendingTiles.clear(); }
+
+private:
+    struct PendingTile {
+        UpdateAtlas* atlas;
+        IntRect area;
+        OwnPtr<PaintRecording> recording;
+    };
+
+    struct RasterizeParameters {
+        Vector<OwnPtr<PendingTile> >* tiles;
+        int* nextTileIndex;
+    };
+
+    static void rasterizeWorker(RasterizeParameters*);
+
+    Vector<OwnPtr<PendingTile> > m_pendingTiles;
+};
+
+} // namespace WebCore
+
+#endif // USE(COORDINATED_GRAPHICS)
+
+#endif // TileRasterizer_h
@@ -24,6 +24,7 @@
 #if USE(COORDINATED_GRAPHICS)
 
 #include "CoordinatedGraphicsState.h"
+#include "CoordinatedSurfacePool.h"
 #include "GraphicsContext.h"
 #include "IntRect.h"
 #include <wtf/MathExtras.h>
@@ -63,7 +64,7 @@ UpdateAtlas::UpdateAtlas(Client* client, int dimension, CoordinatedSurface::Flag
     static uint32_t nextID = 0;
     m_ID = ++nextID;
     IntSize size = nextPowerOfTwo(IntSize(dimension, dimension));
-    m_surface = CoordinatedSurface::create(size, flags);
+    m_surface = CoordinatedSurfacePool::sharedPool()->takeSurface(size, flags);
 
     m_client->createUpdateAtlas(m_ID, m_surface);
 }
@@ -72,6 +73,7 @@ UpdateAtlas::~UpdateAtlas()
 {
     if (m_surface)
         m_client->removeUpdateAtlas(m_ID);
+    CoordinatedSurfacePool::sharedPool()->addSurface(m_surface.release());
 }
 
 void UpdateAtlas::buildLayoutIfNeeded()
@@ -88,7 +90,7 @@ void UpdateAtlas::didSwapBuffers()
 }
 
 
-bool UpdateAtlas::paintOnAvailableBuffer(const IntSize& size, uint32_t& atlasID, IntPoint& offset, CoordinatedSurface::Client* client)
+bool UpdateAtlas::reserveArea(const IntSize& size, uint32_t& atlasID, IntRect& area)
 {
     m_inactivityInSeconds = 0;
     buildLayoutIfNeeded();
@@ -104,13 +106,15 @@ bool UpdateAtlas::paintOnAvailableBuffer(const IntSize& size, uint32_t& atlasID,
     atlasID = m_ID;
 
     // FIXME: Use tri-state buffers, to allow faster updates.
-    offset = rect.location();
-
-    UpdateAtlasSurfaceClient surfaceClient(client, size, supportsAlpha());
-    m_surface->paintToSurface(rect, &surfaceClient);
-
+    area = rect;
     return true;
 }
 
+void UpdateAtlas::paintToArea(const IntRect& area, CoordinatedSurface::Client* client)
+{
+    UpdateAtlasSurfaceClient surfaceClient(client, area.size(), supportsAlpha());
+    m_surface->paintToSurface(area, &surfaceClient);
+}
+
 } // namespace WebCore
 #endif // USE(COORDINATED_GRAPHICS)
@@ -29,7 +29,7 @@
 
 namespace WebCore {
 class GraphicsContext;
-class IntPoint;
+class IntRect;
 
 class UpdateAtlas {
     WTF_MAKE_NONCOPYABLE(UpdateAtlas);
@@ -46,7 +46,9 @@ public:
     inline IntSize size() const { return m_surface->size(); }
 
     // Returns false if there is no available buffer.
-    bool paintOnAvailableBuffer(const IntSize&, uint32_t& atlasID, IntPoint& offset, CoordinatedSurface::Client*);
+    bool reserveArea(const IntSize&, uint32_t& atlasID, IntRect& area);
+    void paintToArea(const IntRect& area, CoordinatedSurface::Client*);
+
     void didSwapBuffers();
     bool supportsAlpha() const { return m_surface->supportsAlpha(); }
 
@@ -286,6 +286,34 @@ public:
         advanceAndUpdateLineNumberSlowCase();
     }
 
+    // Direct access to the characters following the current one, for tokenizers that want to scan
+    // runs of characters needing no individual attention in bulk. Only the rest of the current
+    // substring is exposed, and never its last character, so moving on to the next substring still
+    // goes through the regular advance functions.
+    bool canScanAhead() const { return !m_pushedChar1 && m_currentString.m_length > 1; }
+    bool currentSubstringIs8Bit() { return m_currentString.is8Bit(); }
+    unsigned scanAheadLength() const { return m_currentString.m_length - 1; }
+    const LChar* scanAheadCharacters8() const { return m_currentString.m_data.string8Ptr + 1; }
+    const UChar* scanAheadCharacters16() const { return m_currentString.m_data.string16Ptr + 1; }
+
+    // Skips |count| characters, none of which may be a newline, within the current substring.
+    void advancePastNonNewlines(unsigned count)
+    {
+        ASSERT(canScanAhead());
+        ASSERT(count <= scanAheadLength());
+        ASSERT(currentChar() != '\n');
+        if (!count)
+            return;
+        if (m_currentString.is8Bit())
+            m_currentString.m_data.string8Ptr += count;
+        else
+            m_currentString.m_data.string16Ptr += count;
+        m_currentString.m_length -= count;
+        m_currentChar = m_currentString.getCurrentChar();
+        if (m_currentString.m_length == 1)
+            updateSlowCaseFunctionPointers();
+    }
+
     // Writes the consumed characters into consumedCharacters, which must
     // have space for at least |count| characters.
     void advance(unsigned count, UChar* consumedCharacters);
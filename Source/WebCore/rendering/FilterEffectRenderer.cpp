@@ -199,6 +199,8 @@ bool FilterEffectRenderer::build(RenderObject* renderer, const FilterOperations&
     // New FECustomFilters can reuse cached resources from old FECustomFilters.
     FilterEffectList oldEffects;
     m_effects.swap(oldEffects);
+    m_effectOperationTypes.clear();
+    bool hasReferenceFilter = false;
 
     RefPtr<FilterEffect> previousEffect = m_sourceGraphic;
     for (size_t i = 0; i < operations.operations().size(); ++i) {
@@ -209,6 +211,7 @@ bool FilterEffectRenderer::build(RenderObject* renderer, const FilterOperations&
             ReferenceFilterOperation* referenceOperation = static_cast<ReferenceFilterOperation*>(filterOperation);
             effect = buildReferenceFilter(renderer, previousEffect, referenceOperation);
             referenceOperation->setFilterEffect(effect);
+            hasReferenceFilter = true;
             break;
         }
         case FilterOperation::GRAYSCALE: {
@@ -369,6 +372,7 @@ bool FilterEffectRenderer::build(RenderObject* renderer, const FilterOperations&
             if (filterOperation->getOperationType() != FilterOperation::REFERENCE) {
                 effect->inputEffects().append(previousEffect);
                 m_effects.append(effect);
+                m_effectOperationTypes.append(filterOperation->getOperationType());
             }
             previousEffect = effect.release();
         }
@@ -378,6 +382,10 @@ bool FilterEffectRenderer::build(RenderObject* renderer, const FilterOperations&
     if (!m_effects.size())
         return false;
 
+    // The effects of reference filters are mixed into m_effects, so the types no longer line up with them.
+    if (hasReferenceFilter)
+        m_effectOperationTypes.clear();
+
     setMaxEffectRects(m_sourceDrawingRegion);
     
     return true;
@@ -418,7 +426,7 @@ void FilterEffectRenderer::clearIntermediateResults()
 void FilterEffectRenderer::apply()
 {
     RefPtr<FilterEffect> effect = lastEffect();
-    effect->apply();
+    effect->applyAll();
     effect->transformResultColorSpace(ColorSpaceDeviceRGB);
 }
 
@@ -443,6 +451,56 @@ LayoutRect FilterEffectRenderer::computeSourceImageRectForDirtyRect(const Layout
     return rectForRepaint;
 }
 
+bool FilterEffectRenderer::restrictEffectsToResultRect(const FloatRect& resultRect)
+{
+    // Whether this is possible only depends on the operations, so effects are never left restricted from an earlier call.
+#if ENABLE(CSS_SHADERS)
+    if (hasCustomShaderFilter())
+        return false;
+#endif
+    if (m_effectOperationTypes.size() != m_effects.size())
+        return false;
+
+    // Walk back from the output: each effect only needs to produce what the next one reads.
+    FloatRect neededRect = resultRect;
+    for (size_t i = m_effects.size(); i > 0; --i) {
+        FilterEffect* effect = m_effects[i - 1].get();
+        FloatRect effectRect = neededRect;
+        switch (m_effectOperationTypes[i - 1]) {
+        case FilterOperation::BLUR: {
+            FEGaussianBlur* blur = static_cast<FEGaussianBlur*>(effect);
+            unsigned kernelSizeX = 0;
+            unsigned kernelSizeY = 0;
+            FEGaussianBlur::calculateKernelSize(this, kernelSizeX, kernelSizeY, blur->stdDeviationX(), blur->stdDeviationY());
+            // The blur runs in place on its result, which therefore has to hold every input pixel that reaches the needed area.
+            effectRect.inflateX(3 * kernelSizeX * 0.5f);
+            effectRect.inflateY(3 * kernelSizeY * 0.5f);
+            neededRect = effectRect;
+            break;
+        }
+        case FilterOperation::DROP_SHADOW: {
+            FEDropShadow* dropShadow = static_cast<FEDropShadow*>(effect);
+            unsigned kernelSizeX = 0;
+            unsigned kernelSizeY = 0;
+            FEGaussianBlur::calculateKernelSize(this, kernelSizeX, kernelSizeY, dropShadow->stdDeviationX(), dropShadow->stdDeviationY());
+            effectRect.inflateX(3 * kernelSizeX * 0.5f);
+            effectRect.inflateY(3 * kernelSizeY * 0.5f);
+            // The shadow is blurred in place from the offset input, and the input itself is drawn on top.
+            FloatRect shadowSourceRect = effectRect;
+            shadowSourceRect.move(-applyHorizontalScale(dropShadow->dx()), -applyVerticalScale(dropShadow->dy()));
+            neededRect.unite(shadowSourceRect);
+            break;
+        }
+        default:
+            // The remaining operations map each pixel on its own and keep transparent pixels transparent.
+            break;
+        }
+        effect->setMaxEffectRect(effectRect);
+        effect->setClipsToBounds(true);
+    }
+    return true;
+}
+
 bool FilterEffectRendererHelper::prepareFilterEffect(RenderLayer* renderLayer, const LayoutRect& filterBoxRect, const LayoutRect& dirtyRect, const LayoutRect& layerRepaintRect)
 {
     ASSERT(m_haveFilterEffect && renderLayer->filterRenderer());
@@ -460,6 +518,7 @@ bool FilterEffectRendererHelper::prepareFilterEffect(RenderLayer* renderLayer, c
     }
     
     bool hasUpdatedBackingStore = filter->updateBackingStoreRect(filterSourceRect);
+    m_outputClipRect = filter->restrictEffectsToResultRect(dirtyRect) ? dirtyRect : LayoutRect();
     if (filter->hasFilterThatMovesPixels()) {
         if (hasUpdatedBackingStore)
             m_repaintRect = filterSourceRect;
@@ -516,7 +575,13 @@ void FilterEffectRendererHelper::applyFilterEffect(GraphicsContext* destinationC
     LayoutRect destRect = filter->outputRect();
     destRect.move(m_paintOffset.x(), m_paintOffset.y());
     
+    if (!m_outputClipRect.isEmpty()) {
+        destinationContext->save();
+        destinationContext->clip(m_outputClipRect);
+    }
     destinationContext->drawImageBuffer(filter->output(), m_renderLayer->renderer()->style()->colorSpace(), pixelSnappedIntRect(destRect), CompositeSourceOver);
+    if (!m_outputClipRect.isEmpty())
+        destinationContext->restore();
     
     filter->clearIntermediateResults();
 }
@@ -76,6 +76,8 @@ private:
     RenderLayer* m_renderLayer; // FIXME: this is mainly used to get the FilterEffectRenderer. FilterEffectRendererHelper should be weaned off it.
     LayoutPoint m_paintOffset;
     LayoutRect m_repaintRect;
+    // Only this part of the output is computed correctly when the effects were restricted to it.
+    LayoutRect m_outputClipRect;
     bool m_haveFilterEffect;
     bool m_startedFilterEffect;
 };
@@ -116,6 +118,11 @@ public:
     bool hasFilterThatMovesPixels() const { return m_hasFilterThatMovesPixels; }
     LayoutRect computeSourceImageRectForDirtyRect(const LayoutRect& filterBoxRect, const LayoutRect& dirtyRect);
 
+    // Limits the area every effect computes, through its maxEffectRect(), to what is needed for the
+    // output within resultRect. Returns false, and lets the effects cover the whole source image,
+    // if the filter contains effects whose reach is not known here.
+    bool restrictEffectsToResultRect(const FloatRect& resultRect);
+
 #if ENABLE(CSS_SHADERS)
     bool hasCustomShaderFilter() const { return m_hasCustomShaderFilter; }
 #endif
@@ -141,6 +148,8 @@ private:
     FloatRect m_filterRegion;
     
     FilterEffectList m_effects;
+    // The operation each entry of m_effects was built for, if the filter has no reference filters.
+    Vector<FilterOperation::OperationType> m_effectOperationTypes;
     RefPtr<SourceGraphic> m_sourceGraphic;
     
     IntRectExtent m_outsets;
@@ -1000,6 +1000,7 @@ void RenderBlock::deleteLineBoxTree()
         }
     }
     m_lineBoxes.deleteLineBoxTree(renderArena());
+    clearSimpleLineLayout();
 
     if (AXObjectCache* cache = document()->existingAXObjectCache())
         cache->recomputeIsIgnored(this);
@@ -3173,9 +3174,12 @@ void RenderBlock::paintContents(PaintInfo& paintInfo, const LayoutPoint& paintOf
     if (document()->didLayoutWithPendingStylesheets() && !isRenderView())
         return;
 
-    if (childrenInline())
-        m_lineBoxes.paint(this, paintInfo, paintOffset);
-    else {
+    if (childrenInline()) {
+        if (SimpleLineLayout::Layout* layout = simpleLineLayout())
+            SimpleLineLayout::paint(this, *layout, paintInfo, paintOffset);
+        else
+            m_lineBoxes.paint(this, paintInfo, paintOffset);
+    } else {
         PaintPhase newPhase = (paintInfo.phase == PaintPhaseChildOutlines) ? PaintPhaseOutline : paintInfo.phase;
         newPhase = (newPhase == PaintPhaseChildBlockBackgrounds) ? PaintPhaseChildBlockBackground : newPhase;
 
@@ -5249,6 +5253,8 @@ void RenderBlock::adjustForColumnRect(LayoutSize& offset, const LayoutPoint& loc
 bool RenderBlock::hitTestContents(const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, HitTestAction hitTestAction)
 {
     if (childrenInline() && !isTable()) {
+        if (SimpleLineLayout::Layout* layout = simpleLineLayout())
+            return SimpleLineLayout::hitTest(this, *layout, request, result, locationInContainer, accumulatedOffset, hitTestAction);
         // We have to hit-test our line boxes.
         if (m_lineBoxes.hitTest(this, request, result, locationInContainer, accumulatedOffset, hitTestAction))
             return true;
@@ -5329,6 +5335,8 @@ VisiblePosition RenderBlock::positionForPointWithInlineChildren(const LayoutPoin
 {
     ASSERT(childrenInline());
 
+    ensureLineBoxes();
+
     if (!firstRootBox())
         return createVisiblePosition(0, DOWNSTREAM);
 
@@ -6583,6 +6591,8 @@ int RenderBlock::firstLineBoxBaseline() const
         return -1;
 
     if (childrenInline()) {
+        if (SimpleLineLayout::Layout* layout = simpleLineLayout())
+            return layout->lineCount() ? (layout->lineTop(0) + layout->baseline()).toInt() : -1;
         if (firstLineBox())
             return firstLineBox()->logicalTop() + style(true)->fontMetrics().ascent(firstRootBox()->baselineType());
         else
@@ -6612,6 +6622,10 @@ int RenderBlock::lastLineBoxBaseline(LineDirectionMode lineDirection) const
         return -1;
 
     if (childrenInline()) {
+        if (SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+            if (layout->lineCount())
+                return (layout->lineTop(layout->lineCount() - 1) + layout->baseline()).toInt();
+        }
         if (!firstLineBox() && hasLineIfEmpty()) {
             const FontMetrics& fontMetrics = firstLineStyle()->fontMetrics();
             return fontMetrics.ascent()
@@ -6953,6 +6967,8 @@ RootInlineBox* RenderBlock::lineAtIndex(int i) const
         return 0;
 
     if (childrenInline()) {
+        if (simpleLineLayout())
+            const_cast<RenderBlock*>(this)->ensureLineBoxes();
         for (RootInlineBox* box = firstRootBox(); box; box = box->nextRootBox())
             if (!i--)
                 return box;
@@ -6972,6 +6988,11 @@ int RenderBlock::lineCount(const RootInlineBox* stopRootInlineBox, bool* found)
 {
     int count = 0;
 
+    if (childrenInline()) {
+        if (SimpleLineLayout::Layout* layout = simpleLineLayout())
+            return style()->visibility() == VISIBLE ? layout->lineCount() : 0;
+    }
+
     if (style()->visibility() == VISIBLE) {
         if (childrenInline())
             for (RootInlineBox* box = firstRootBox(); box; box = box->nextRootBox()) {
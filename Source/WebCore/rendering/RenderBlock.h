@@ -29,6 +29,7 @@
 #include "RenderBox.h"
 #include "RenderLineBoxList.h"
 #include "RootInlineBox.h"
+#include "SimpleLineLayout.h"
 #include "TextBreakIterator.h"
 #include "TextRun.h"
 #include <wtf/OwnPtr.h>
@@ -114,6 +115,11 @@ public:
 
     void deleteLineBoxTree();
 
+    // Lines laid out by the simple line layout path have no line boxes. This switches the block
+    // to the full line layout path and builds them. Not to be called while painting.
+    SimpleLineLayout::Layout* simpleLineLayout() const { return m_rareData ? m_rareData->m_simpleLineLayout.get() : 0; }
+    void ensureLineBoxes();
+
     virtual void addChild(RenderObject* newChild, RenderObject* beforeChild = 0);
     virtual void removeChild(RenderObject*);
 
@@ -643,6 +649,8 @@ private:
 
     void layoutBlockChildren(bool relayoutChildren, LayoutUnit& maxFloatLogicalBottom);
     void layoutInlineChildren(bool relayoutChildren, LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom);
+    bool layoutSimpleLines(LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom);
+    void clearSimpleLineLayout();
     BidiRun* handleTrailingSpaces(BidiRunList<BidiRun>&, BidiContext*);
 
     void insertIntoTrackedRendererMaps(RenderBox* descendant, TrackedDescendantsMap*&, TrackedContainerMap*&);
@@ -1287,6 +1295,7 @@ public:
             , m_shouldBreakAtLineToAvoidWidow(false)
             , m_discardMarginBefore(false)
             , m_discardMarginAfter(false)
+            , m_forceLineBoxes(false)
         { 
         }
 
@@ -1317,9 +1326,11 @@ public:
 #if ENABLE(CSS_SHAPES)
         OwnPtr<ShapeInsideInfo> m_shapeInsideInfo;
 #endif
+        OwnPtr<SimpleLineLayout::Layout> m_simpleLineLayout;
         bool m_shouldBreakAtLineToAvoidWidow : 1;
         bool m_discardMarginBefore : 1;
         bool m_discardMarginAfter : 1;
+        bool m_forceLineBoxes : 1;
      };
 
 protected:
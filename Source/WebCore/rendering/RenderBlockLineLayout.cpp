@@ -24,6 +24,7 @@
 #include "config.h"
 
 #include "BidiResolver.h"
+#include "FrameView.h"
 #include "Hyphenation.h"
 #include "InlineIterator.h"
 #include "InlineTextBox.h"
@@ -2115,6 +2116,12 @@ void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repain
     if (view()->layoutState() && view()->layoutState()->lineGrid() == this)
         layoutLineGridBox();
 
+    if (!(m_rareData && m_rareData->m_forceLineBoxes) && SimpleLineLayout::canUseFor(this)) {
+        if (layoutSimpleLines(repaintLogicalTop, repaintLogicalBottom))
+            return;
+    }
+    clearSimpleLineLayout();
+
     RenderFlowThread* flowThread = flowThreadContainingBlock();
     bool clearLinesForPagination = firstLineBox() && flowThread && !flowThread->hasRegions();
 
@@ -2211,6 +2218,78 @@ void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repain
         checkLinesForTextOverflow();
 }
 
+bool RenderBlock::layoutSimpleLines(LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom)
+{
+    OwnPtr<SimpleLineLayout::Layout> layout = SimpleLineLayout::Layout::create(this);
+    if (!layout) {
+        // The text needs fallback fonts, which only the full path knows how to position.
+        if (!m_rareData)
+            m_rareData = adoptPtr(new RenderBlockRareData(this));
+        m_rareData->m_forceLineBoxes = true;
+        return false;
+    }
+
+    RenderText* textRenderer = toRenderText(firstChild());
+    lineBoxes()->deleteLineBoxes(renderArena());
+    textRenderer->dirtyLineBoxes(true);
+    textRenderer->setNeedsLayout(false);
+    textRenderer->setUsesSimpleLineLayout(true);
+
+    LayoutUnit linesTop = logicalHeight();
+    LayoutUnit linesBottom = linesTop + layout->height();
+    repaintLogicalTop = min(repaintLogicalTop, linesTop);
+    repaintLogicalBottom = max(repaintLogicalBottom, linesBottom);
+    setLogicalHeight(linesBottom);
+
+    if (!layout->lineCount() && hasLineIfEmpty())
+        setLogicalHeight(logicalHeight() + lineHeight(true, HorizontalLine, PositionOfInteriorLineBoxes));
+    setLogicalHeight(logicalHeight() + borderAndPaddingAfter() + scrollbarLogicalHeight());
+
+    if (!m_rareData)
+        m_rareData = adoptPtr(new RenderBlockRareData(this));
+    m_rareData->m_simpleLineLayout = layout.release();
+    return true;
+}
+
+void RenderBlock::clearSimpleLineLayout()
+{
+    if (!simpleLineLayout())
+        return;
+    m_rareData->m_simpleLineLayout.clear();
+    if (firstChild() && firstChild()->isText())
+        toRenderText(firstChild())->setUsesSimpleLineLayout(false);
+}
+
+void RenderBlock::ensureLineBoxes()
+{
+    if (!simpleLineLayout())
+        return;
+    // Painting and hit testing read the simple layout directly; building boxes from under them would re-enter layout.
+    ASSERT(!view()->frameView()->isPainting());
+    m_rareData->m_forceLineBoxes = true;
+    clearSimpleLineLayout();
+
+    // A pending layout builds the line boxes anyway.
+    if (selfNeedsLayout() || normalChildNeedsLayout())
+        return;
+
+    // The line boxes get the geometry the simple path already computed, so only the block's
+    // inline content is laid out again and its own size stays as it is.
+    LayoutUnit oldLogicalHeight = logicalHeight();
+    LayoutUnit repaintLogicalTop = 0;
+    LayoutUnit repaintLogicalBottom = 0;
+    RenderView* renderView = view();
+    if (renderView->layoutState()) {
+        LayoutStateDisabler layoutStateDisabler(renderView);
+        layoutInlineChildren(true, repaintLogicalTop, repaintLogicalBottom);
+    } else {
+        renderView->pushLayoutState(this);
+        layoutInlineChildren(true, repaintLogicalTop, repaintLogicalBottom);
+        renderView->popLayoutState(this);
+    }
+    setLogicalHeight(oldLogicalHeight);
+}
+
 void RenderBlock::checkFloatsInCleanLine(RootInlineBox* line, Vector<FloatWithRect>& floats, size_t& floatIndex, bool& encounteredNewFloat, bool& dirtiedByFloat)
 {
     Vector<RenderBox*>* cleanLineFloats = line->floatsPtr();
@@ -2639,6 +2718,13 @@ static ALWAYS_INLINE float textWidth(RenderText* text, unsigned from, unsigned l
     if (layout)
         return Font::width(*layout, from, len, &fallbackFonts);
 
+    // Words measured with the primary font don't depend on their position unless tabs are
+    // preserved, so their widths can be reused by later layouts of the same text.
+    bool canUseWordWidthCache = collapseWhiteSpace && &font == &text->style()->font();
+    float width;
+    if (canUseWordWidthCache && text->cachedWordWidth(from, len, width))
+        return width;
+
     TextRun run = RenderBlock::constructTextRun(text, font, text, from, len, text->style());
     run.setCharactersLength(text->textLength() - from);
     ASSERT(run.charactersLength() >= run.length());
@@ -2646,7 +2732,20 @@ static ALWAYS_INLINE float textWidth(RenderText* text, unsigned from, unsigned l
     run.setCharacterScanForCodePath(!text->canUseSimpleFontCodePath());
     run.setTabSize(!collapseWhiteSpace, text->style()->tabSize());
     run.setXPos(xPos);
-    return font.width(run, &fallbackFonts, &glyphOverflow);
+    if (!canUseWordWidthCache || !len)
+        return font.width(run, &fallbackFonts, &glyphOverflow);
+
+    // Only widths measured without fallback fonts are cached, since a cache hit can't report them.
+    HashSet<const SimpleFontData*> wordFallbackFonts;
+    width = font.width(run, &wordFallbackFonts, &glyphOverflow);
+    if (wordFallbackFonts.isEmpty())
+        text->cacheWordWidth(from, len, width);
+    else {
+        HashSet<const SimpleFontData*>::const_iterator end = wordFallbackFonts.end();
+        for (HashSet<const SimpleFontData*>::const_iterator it = wordFallbackFonts.begin(); it != end; ++it)
+            fallbackFonts.add(*it);
+    }
+    return width;
 }
 
 static void tryHyphenating(RenderText* text, const Font& font, const AtomicString& localeIdentifier, unsigned consecutiveHyphenatedLines, int consecutiveHyphenatedLinesLimit, int minimumPrefixLimit, int minimumSuffixLimit, unsigned lastSpace, unsigned pos, float xPos, int availableWidth, bool isFixedPitch, bool collapseWhiteSpace, int lastSpaceWordSpacing, InlineIterator& lineBreak, int nextBreakable, bool& hyphenated)
@@ -3548,6 +3647,13 @@ void RenderBlock::addOverflowFromInlineChildren()
     // FIXME: Need to find another way to do this, since scrollbars could show when we don't want them to.
     if (hasOverflowClip() && !endPadding && node() && node()->isRootEditableElement() && style()->isLeftToRightDirection())
         endPadding = 1;
+    if (SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        LayoutRect linesRect = layout->layoutOverflowRect();
+        addLayoutOverflow(linesRect);
+        if (!hasOverflowClip())
+            addVisualOverflow(linesRect);
+        return;
+    }
     for (RootInlineBox* curr = firstRootBox(); curr; curr = curr->nextRootBox()) {
         addLayoutOverflow(curr->paddedLayoutOverflowRect(endPadding));
         if (!hasOverflowClip())
@@ -408,6 +408,8 @@ LayoutPoint RenderLayer::computeOffsetFromRoot(bool& hasLayerOffset) const
 
 void RenderLayer::updateLayerPositionsAfterLayout(const RenderLayer* rootLayer, UpdateLayerPositionsFlags flags)
 {
+    invalidateHitTestBounds();
+
     RenderGeometryMap geometryMap(UseTransforms);
     if (this != rootLayer)
         geometryMap.pushMappingsToAncestor(parent(), 0);
@@ -756,6 +758,9 @@ void RenderLayer::updateLayerPositionsAfterDocumentScroll()
 {
     ASSERT(this == renderer()->view()->layer());
 
+    // Fixed position layers moved relative to the document.
+    invalidateHitTestBounds();
+
     RenderGeometryMap geometryMap(UseTransforms);
     updateLayerPositionsAfterScroll(&geometryMap);
 }
@@ -863,6 +868,8 @@ void RenderLayer::updateTransform()
     bool hasTransform = renderer()->hasTransform() && renderer()->style()->hasTransform();
     bool had3DTransform = has3DTransform();
 
+    invalidateHitTestBounds();
+
     bool hadTransform = m_transform;
     if (hasTransform != hadTransform) {
         if (hasTransform)
@@ -1073,6 +1080,10 @@ void RenderLayer::setHasVisibleContent()
 void RenderLayer::dirtyVisibleContentStatus() 
 { 
     m_visibleContentStatusDirty = true; 
+    // Outside of compositing mode, whether we are in the z-order lists of our stacking container
+    // depends on our visibility; see setHasVisibleContent().
+    if (!isNormalFlowOnly())
+        dirtyStackingContainerZOrderLists();
     if (parent())
         parent()->dirtyAncestorChainVisibleDescendantStatus();
 }
@@ -1750,18 +1761,33 @@ void RenderLayer::addChild(RenderLayer* child, RenderLayer* beforeChild)
         setLastChild(child);
 
     child->setParent(this);
+    invalidateHitTestBounds();
 
-    if (child->isNormalFlowOnly())
-        dirtyNormalFlowList();
+    if (child->isNormalFlowOnly()) {
+        // Appending is by far the most common case, and keeps the list in sibling order.
+        if (!beforeChild && !m_normalFlowListDirty && (!m_reflection || reflectionLayer() != child)) {
+            if (!m_normalFlowList)
+                m_normalFlowList = adoptPtr(new Vector<RenderLayer*>);
+            m_normalFlowList->append(child);
+            didChangeLayerLists();
+        } else
+            dirtyNormalFlowList();
+    }
 
+    bool insertIntoZOrderList = false;
     if (!child->isNormalFlowOnly() || child->firstChild()) {
         // Dirty the z-order list in which we are contained. The stackingContainer() can be null in the
         // case where we're building up generated content layers. This is ok, since the lists will start
         // off dirty in that case anyway.
-        child->dirtyStackingContainerZOrderLists();
+        if (child->canUpdateStackingContainerZOrderListsIncrementally())
+            insertIntoZOrderList = true;
+        else
+            child->dirtyStackingContainerZOrderLists();
     }
 
     child->updateDescendantDependentFlags();
+    if (insertIntoZOrderList)
+        child->insertIntoStackingContainerZOrderList();
     if (child->m_hasVisibleContent || child->m_hasVisibleDescendant)
         setAncestorChainHasVisibleDescendant();
 
@@ -1794,13 +1820,27 @@ RenderLayer* RenderLayer::removeChild(RenderLayer* oldChild)
     if (m_last == oldChild)
         m_last = oldChild->previousSibling();
 
-    if (oldChild->isNormalFlowOnly())
-        dirtyNormalFlowList();
+    invalidateHitTestBounds();
+
+    if (oldChild->isNormalFlowOnly()) {
+        if (!m_normalFlowListDirty) {
+            if (m_normalFlowList) {
+                size_t index = m_normalFlowList->find(oldChild);
+                if (index != notFound)
+                    m_normalFlowList->remove(index);
+            }
+            didChangeLayerLists();
+        } else
+            dirtyNormalFlowList();
+    }
     if (!oldChild->isNormalFlowOnly() || oldChild->firstChild()) { 
         // Dirty the z-order list in which we are contained.  When called via the
         // reattachment process in removeOnlyThisLayer, the layer may already be disconnected
         // from the main layer tree, so we need to null-check the |stackingContainer| value.
-        oldChild->dirtyStackingContainerZOrderLists();
+        if (oldChild->canUpdateStackingContainerZOrderListsIncrementally())
+            oldChild->removeFromStackingContainerZOrderList();
+        else
+            oldChild->dirtyStackingContainerZOrderLists();
     }
 
     if ((oldChild->renderer() && oldChild->renderer()->isOutOfFlowPositioned()) || oldChild->hasOutOfFlowPositionedDescendant())
@@ -2198,6 +2238,7 @@ void RenderLayer::scrollTo(int x, int y)
     if (m_scrollOffset == newScrollOffset)
         return;
     m_scrollOffset = newScrollOffset;
+    invalidateHitTestBounds();
 
     Frame* frame = renderer()->frame();
     InspectorInstrumentation::willScrollLayer(frame);
@@ -4847,6 +4888,9 @@ RenderLayer* RenderLayer::hitTestList(Vector<RenderLayer*>* list, RenderLayer* r
         RenderLayer* childLayer = list->at(i);
         if (childLayer->isOutOfFlowRenderFlowThread())
             continue;
+        // 3D hit testing maps the location through the accumulated transform, so only prune flat hit tests.
+        if (!transformState && !childLayer->hitTestBoundsIntersect(rootLayer, hitTestLocation))
+            continue;
         RenderLayer* hitLayer = 0;
         HitTestResult tempResult(result.hitTestLocation());
         if (childLayer->isPaginated())
@@ -4871,6 +4915,82 @@ RenderLayer* RenderLayer::hitTestList(Vector<RenderLayer*>* list, RenderLayer* r
     return resultLayer;
 }
 
+// Maps the hit test bounds of |layer| into the coordinates of |ancestorLayer|, which must not be separated from it by
+// another transformed layer. Returns false if the bounds can't be mapped in 2D.
+static bool mapHitTestBoundsToAncestor(const RenderLayer* layer, const RenderLayer* ancestorLayer, LayoutRect& bounds)
+{
+    if (bounds == LayoutRect::infiniteRect())
+        return false;
+
+    if (TransformationMatrix* transform = layer->transform()) {
+        if (!transform->isAffine() || (layer->parent() && layer->parent()->renderer()->style()->hasPerspective()))
+            return false;
+        bounds = transform->mapRect(bounds);
+    }
+
+    LayoutPoint offset;
+    layer->convertToLayerCoords(ancestorLayer, offset);
+    bounds.moveBy(offset);
+    return true;
+}
+
+LayoutRect RenderLayer::hitTestBounds()
+{
+    RenderView* view = renderer()->view();
+    RenderView::LayerHitTestBoundsMap::const_iterator it = view->layerHitTestBounds().find(this);
+    if (it != view->layerHitTestBounds().end())
+        return it->value;
+
+    LayoutRect bounds = calculateHitTestBounds();
+    view->layerHitTestBounds().set(this, bounds);
+    return bounds;
+}
+
+LayoutRect RenderLayer::calculateHitTestBounds()
+{
+    // Fragments and 3D rendering contexts move content around in ways the layer tree doesn't describe.
+    if (isPaginated() || enclosingPaginationLayer() || isOutOfFlowRenderFlowThread() || preserves3D())
+        return LayoutRect::infiniteRect();
+
+    // Masks don't affect hit testing.
+    LayoutRect bounds = localBoundingBox(DontConstrainForMask);
+    if (renderer()->isBox())
+        renderBox()->flipForWritingMode(bounds);
+    else
+        renderer()->containingBlock()->flipForWritingMode(bounds);
+
+    updateLayerListsIfNeeded();
+
+    Vector<RenderLayer*>* lists[] = { negZOrderList(), normalFlowList(), posZOrderList() };
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(lists); ++i) {
+        if (!lists[i])
+            continue;
+        for (size_t j = 0; j < lists[i]->size(); ++j) {
+            RenderLayer* childLayer = lists[i]->at(j);
+            LayoutRect childBounds = childLayer->hitTestBounds();
+            if (!mapHitTestBoundsToAncestor(childLayer, this, childBounds))
+                return LayoutRect::infiniteRect();
+            bounds.unite(childBounds);
+        }
+    }
+
+    return bounds;
+}
+
+bool RenderLayer::hitTestBoundsIntersect(const RenderLayer* rootLayer, const HitTestLocation& hitTestLocation)
+{
+    LayoutRect bounds = hitTestBounds();
+    if (!mapHitTestBoundsToAncestor(this, rootLayer, bounds))
+        return true;
+    return hitTestLocation.intersects(bounds);
+}
+
+void RenderLayer::invalidateHitTestBounds()
+{
+    if (RenderView* view = renderer()->view())
+        view->invalidateLayerHitTestBounds();
+}
+
 RenderLayer* RenderLayer::hitTestPaginatedChildLayer(RenderLayer* childLayer, RenderLayer* rootLayer, const HitTestRequest& request, HitTestResult& result,
                                                      const LayoutRect& hitTestRect, const HitTestLocation& hitTestLocation, const HitTestingTransformState* transformState, double* zOffset)
 {
@@ -5701,13 +5821,7 @@ void RenderLayer::dirtyZOrderLists()
         m_negZOrderList->clear();
     m_zOrderListsDirty = true;
 
-#if USE(ACCELERATED_COMPOSITING)
-    if (!renderer()->documentBeingDestroyed()) {
-        compositor()->setCompositingLayersNeedRebuild();
-        if (acceleratedCompositingForOverflowScrollEnabled())
-            compositor()->setShouldReevaluateCompositingAfterLayout();
-    }
-#endif
+    didChangeLayerLists();
 }
 
 void RenderLayer::dirtyStackingContainerZOrderLists()
@@ -5725,6 +5839,13 @@ void RenderLayer::dirtyNormalFlowList()
         m_normalFlowList->clear();
     m_normalFlowListDirty = true;
 
+    didChangeLayerLists();
+}
+
+void RenderLayer::didChangeLayerLists()
+{
+    ASSERT(m_layerListMutationAllowed);
+
 #if USE(ACCELERATED_COMPOSITING)
     if (!renderer()->documentBeingDestroyed()) {
         compositor()->setCompositingLayersNeedRebuild();
@@ -5734,6 +5855,115 @@ void RenderLayer::dirtyNormalFlowList()
 #endif
 }
 
+static inline bool hasLowerZIndex(RenderLayer* layer, int zIndex)
+{
+    return layer->zIndex() < zIndex;
+}
+
+// The layer following |layer| in the order collectLayers() visits the descendants of |stackingContainer|.
+// Hidden layers and reflections are visited too; they are simply not found in the z-order lists.
+static RenderLayer* nextInStackingContainerOrder(RenderLayer* layer, RenderLayer* stackingContainer)
+{
+    if (!layer->isStackingContainer() && layer->firstChild())
+        return layer->firstChild();
+    for (; layer != stackingContainer; layer = layer->parent()) {
+        if (layer->nextSibling())
+            return layer->nextSibling();
+    }
+    return 0;
+}
+
+bool RenderLayer::canUpdateStackingContainerZOrderListsIncrementally() const
+{
+    // Only layers that contribute just themselves to the z-order lists can be moved around on their own.
+    if (isNormalFlowOnly() || (firstChild() && !isStackingContainer()))
+        return false;
+
+#if ENABLE(DIALOG_ELEMENT)
+    if (isInTopLayer())
+        return false;
+#endif
+
+    RenderLayer* sc = stackingContainer();
+    if (!sc || sc->m_zOrderListsDirty)
+        return false;
+
+    // Whether descendants are contiguous in stacking order is only recomputed along with the lists.
+    if (acceleratedCompositingForOverflowScrollEnabled())
+        return false;
+
+#if ENABLE(DIALOG_ELEMENT)
+    // Top layer elements are appended after the sorted part of the root layer's list.
+    if (sc->isRootLayer() && !renderer()->document()->topLayerElements().isEmpty())
+        return false;
+#endif
+
+    return true;
+}
+
+void RenderLayer::insertIntoStackingContainerZOrderList()
+{
+    ASSERT(canUpdateStackingContainerZOrderListsIncrementally());
+    RenderLayer* sc = stackingContainer();
+    ASSERT(sc->m_layerListMutationAllowed);
+
+    // Same inclusion rule as collectLayers().
+#if USE(ACCELERATED_COMPOSITING)
+    bool includeHiddenLayers = compositor()->inCompositingMode();
+#else
+    bool includeHiddenLayers = false;
+#endif
+    updateDescendantDependentFlags();
+    if (!includeHiddenLayers && !m_hasVisibleContent && !(m_hasVisibleDescendant && isStackingContainer()))
+        return;
+
+    ASSERT(!sc->m_posZOrderList || !sc->m_posZOrderList->contains(this));
+    ASSERT(!sc->m_negZOrderList || !sc->m_negZOrderList->contains(this));
+
+    int zIndex = this->zIndex();
+    OwnPtr<Vector<RenderLayer*> >& list = zIndex >= 0 ? sc->m_posZOrderList : sc->m_negZOrderList;
+    if (!list)
+        list = adoptPtr(new Vector<RenderLayer*>);
+
+    // The lists are stable-sorted by z-index, so layers with the same z-index are in collection order.
+    // Skip over the ones that come before us in that order instead of collecting and sorting again.
+    size_t index = std::lower_bound(list->begin(), list->end(), zIndex, hasLowerZIndex) - list->begin();
+    for (RenderLayer* layer = sc->firstChild(); layer && layer != this; layer = nextInStackingContainerOrder(layer, sc)) {
+        if (index == list->size() || list->at(index)->zIndex() != zIndex)
+            break;
+        if (list->at(index) == layer)
+            ++index;
+    }
+    list->insert(index, this);
+
+    sc->didChangeLayerLists();
+}
+
+static bool removeFromLayerList(Vector<RenderLayer*>* list, RenderLayer* layer)
+{
+    if (!list)
+        return false;
+    size_t index = list->find(layer);
+    if (index == notFound)
+        return false;
+    list->remove(index);
+    return true;
+}
+
+void RenderLayer::removeFromStackingContainerZOrderList()
+{
+    ASSERT(canUpdateStackingContainerZOrderListsIncrementally());
+    RenderLayer* sc = stackingContainer();
+    ASSERT(sc->m_layerListMutationAllowed);
+
+    // After a z-index change our style already has the new z-index, so neither the list we are
+    // in nor our position in it can be derived from it. Hidden layers may not be in either list.
+    if (!removeFromLayerList(sc->m_posZOrderList.get(), this))
+        removeFromLayerList(sc->m_negZOrderList.get(), this);
+
+    sc->didChangeLayerLists();
+}
+
 void RenderLayer::rebuildZOrderLists()
 {
     ASSERT(m_layerListMutationAllowed);
@@ -6040,10 +6270,21 @@ void RenderLayer::updateStackingContextsAfterStyleChange(const RenderStyle* oldS
 
     // FIXME: RenderLayer already handles visibility changes through our visiblity dirty bits. This logic could
     // likely be folded along with the rest.
-    if (oldStyle->zIndex() != renderer()->style()->zIndex() || oldStyle->visibility() != renderer()->style()->visibility()) {
+    if (oldStyle->visibility() != renderer()->style()->visibility()) {
         dirtyStackingContainerZOrderLists();
         if (isStackingContext)
             dirtyZOrderLists();
+        return;
+    }
+
+    // A z-index change only moves this layer within the lists of its stacking container, and
+    // doesn't affect our own lists.
+    if (oldStyle->zIndex() != renderer()->style()->zIndex()) {
+        if (canUpdateStackingContainerZOrderListsIncrementally()) {
+            removeFromStackingContainerZOrderList();
+            insertIntoStackingContainerZOrderList();
+        } else
+            dirtyStackingContainerZOrderLists();
     }
 }
 
@@ -6145,6 +6386,8 @@ inline bool RenderLayer::needsCompositingLayersRebuiltForOverflow(const RenderSt
 
 void RenderLayer::styleChanged(StyleDifference, const RenderStyle* oldStyle)
 {
+    invalidateHitTestBounds();
+
     bool isNormalFlowOnly = shouldBeNormalFlowOnly();
     if (isNormalFlowOnly != m_isNormalFlowOnly) {
         m_isNormalFlowOnly = isNormalFlowOnly;
@@ -850,6 +850,14 @@ private:
 
     void updateNormalFlowList();
 
+    void didChangeLayerLists();
+
+    // Keep the z-order lists of our stacking container up to date without rebuilding them when
+    // only this layer is added, removed or changes z-index.
+    bool canUpdateStackingContainerZOrderListsIncrementally() const;
+    void insertIntoStackingContainerZOrderList();
+    void removeFromStackingContainerZOrderList();
+
     // Non-auto z-index always implies stacking context here, because StyleResolver::adjustRenderStyle already adjusts z-index
     // based on positioning and other criteria.
     bool isStackingContext(const RenderStyle* style) const { return !style->hasAutoZIndex() || isRootLayer(); }
@@ -981,6 +989,13 @@ private:
                              const LayoutRect& hitTestRect, const HitTestLocation&,
                              const HitTestingTransformState* transformState, double* zOffsetForDescendants, double* zOffset,
                              const HitTestingTransformState* unflattenedTransformState, bool depthSortDescendants);
+    // Conservative bounds, in our coordinates before our own transform, of everything hitTestLayer() can hit in
+    // this layer and the layers it reaches through its lists. Infinite if that can't be bounded in 2D.
+    LayoutRect hitTestBounds();
+    LayoutRect calculateHitTestBounds();
+    bool hitTestBoundsIntersect(const RenderLayer* rootLayer, const HitTestLocation&);
+    void invalidateHitTestBounds();
+
     RenderLayer* hitTestPaginatedChildLayer(RenderLayer* childLayer, RenderLayer* rootLayer, const HitTestRequest& request, HitTestResult& result,
                                             const LayoutRect& hitTestRect, const HitTestLocation&,
                                             const HitTestingTransformState* transformState, double* zOffset);
@@ -41,6 +41,7 @@
 #include "HTMLNames.h"
 #include "HitTestResult.h"
 #include "InspectorInstrumentation.h"
+#include "IntPointHash.h"
 #include "Logging.h"
 #include "NodeList.h"
 #include "Page.h"
@@ -117,7 +118,7 @@ public:
         return m_layers.contains(layer);
     }
 
-    bool overlapsLayers(const IntRect& bounds) const
+    bool overlapsLayers(const IntRect& bounds)
     {
         return m_overlapStack.last().intersects(bounds);
     }
@@ -141,33 +142,115 @@ public:
     RenderGeometryMap& geometryMap() { return m_geometryMap; }
 
 private:
-    struct RectList {
-        Vector<IntRect> rects;
-        IntRect boundingRect;
-        
+    // The rects of the layers that have already been processed in a compositing container.
+    // Long lists are bucketed into a uniform grid so that an overlap test only looks at the
+    // rects near the tested bounds. The grid is brought up to date lazily on the next query,
+    // so merging a popped container into its parent stays a plain append.
+    class RectList {
+    public:
+        RectList()
+            : m_indexedRectCount(0)
+        {
+        }
+
         void append(const IntRect& rect)
         {
-            rects.append(rect);
-            boundingRect.unite(rect);
+            // Empty rects never intersect anything.
+            if (rect.isEmpty())
+                return;
+            m_rects.append(rect);
+            m_boundingRect.unite(rect);
         }
 
         void append(const RectList& rectList)
         {
-            rects.appendVector(rectList.rects);
-            boundingRect.unite(rectList.boundingRect);
+            m_rects.appendVector(rectList.m_rects);
+            m_boundingRect.unite(rectList.m_boundingRect);
         }
-        
-        bool intersects(const IntRect& rect) const
+
+        bool intersects(const IntRect& rect)
         {
-            if (!rects.size() || !boundingRect.intersects(rect))
+            if (m_rects.isEmpty() || !m_boundingRect.intersects(rect))
                 return false;
 
-            for (unsigned i = 0; i < rects.size(); i++) {
-                if (rects[i].intersects(rect))
+            if (m_rects.size() < minimumRectCountForGrid)
+                return intersectsAny(rect);
+
+            // Only the part of the rect inside the bounding rect can hit anything.
+            IntRect cells = cellsForRect(intersection(rect, m_boundingRect));
+            if (static_cast<size_t>(cells.width()) * cells.height() > m_rects.size())
+                return intersectsAny(rect);
+
+            updateGrid();
+
+            for (size_t i = 0; i < m_largeRects.size(); ++i) {
+                if (m_rects[m_largeRects[i]].intersects(rect))
                     return true;
             }
+
+            for (int y = cells.y(); y < cells.maxY(); ++y) {
+                for (int x = cells.x(); x < cells.maxX(); ++x) {
+                    CellMap::const_iterator it = m_cells.find(IntPoint(x, y));
+                    if (it == m_cells.end())
+                        continue;
+                    const Vector<unsigned>& indices = it->value;
+                    for (size_t i = 0; i < indices.size(); ++i) {
+                        if (m_rects[indices[i]].intersects(rect))
+                            return true;
+                    }
+                }
+            }
             return false;
         }
+
+    private:
+        static const int cellSizeShift = 8;
+        static const size_t minimumRectCountForGrid = 32;
+        static const size_t maximumCellsPerRect = 16;
+
+        // Returns the range of grid cells covered by a non-empty rect, in cell coordinates.
+        static IntRect cellsForRect(const IntRect& rect)
+        {
+            int minX = rect.x() >> cellSizeShift;
+            int minY = rect.y() >> cellSizeShift;
+            int maxX = (rect.maxX() - 1) >> cellSizeShift;
+            int maxY = (rect.maxY() - 1) >> cellSizeShift;
+            return IntRect(minX, minY, maxX - minX + 1, maxY - minY + 1);
+        }
+
+        bool intersectsAny(const IntRect& rect) const
+        {
+            for (size_t i = 0; i < m_rects.size(); ++i) {
+                if (m_rects[i].intersects(rect))
+                    return true;
+            }
+            return false;
+        }
+
+        void updateGrid()
+        {
+            for (; m_indexedRectCount < m_rects.size(); ++m_indexedRectCount) {
+                IntRect cells = cellsForRect(m_rects[m_indexedRectCount]);
+                // Very large layers (page-sized backgrounds, say) would fill hundreds of
+                // buckets; they are few, so test them on every query instead.
+                if (static_cast<size_t>(cells.width()) * cells.height() > maximumCellsPerRect) {
+                    m_largeRects.append(m_indexedRectCount);
+                    continue;
+                }
+                for (int y = cells.y(); y < cells.maxY(); ++y) {
+                    for (int x = cells.x(); x < cells.maxX(); ++x)
+                        m_cells.add(IntPoint(x, y), Vector<unsigned>()).iterator->value.append(m_indexedRectCount);
+                }
+            }
+        }
+
+        typedef HashMap<IntPoint, Vector<unsigned> > CellMap;
+
+        Vector<IntRect> m_rects;
+        IntRect m_boundingRect;
+        CellMap m_cells;
+        Vector<unsigned> m_largeRects;
+        unsigned m_indexedRectCount;
     };
 
     Vector<RectList> m_overlapStack;
@@ -576,6 +659,12 @@ void RenderLayerCompositor::updateCompositingLayers(CompositingUpdateType update
         needHierarchyUpdate |= layersChanged;
     }
 
+#if !LOG_DISABLED
+    double requirementsEndTime = 0;
+    if (compositingLogEnabled())
+        requirementsEndTime = currentTime();
+#endif
+
 #if !LOG_DISABLED
     if (compositingLogEnabled() && isFullUpdate && (needHierarchyUpdate || needGeometryUpdate)) {
         m_obligateCompositedLayerCount = 0;
@@ -617,6 +706,9 @@ void RenderLayerCompositor::updateCompositingLayers(CompositingUpdateType update
         LOG(Compositing, "%8d %11d %9d %20.2f %22.2f %22.2f %18.2f\n",
             m_obligateCompositedLayerCount + m_secondaryCompositedLayerCount, m_obligateCompositedLayerCount,
             m_secondaryCompositedLayerCount, m_obligatoryBackingStoreBytes / 1024, m_secondaryBackingStoreBytes / 1024, (m_obligatoryBackingStoreBytes + m_secondaryBackingStoreBytes) / 1024, 1000.0 * (endTime - startTime));
+
+        LOG(Compositing, "Requirements and overlap (ms)   %s (ms)\n", needHierarchyUpdate ? "hierarchy rebuild" : "geometry update");
+        LOG(Compositing, "%29.2f %20.2f\n", 1000.0 * (requirementsEndTime - startTime), 1000.0 * (endTime - requirementsEndTime));
     }
 #endif
     ASSERT(updateRoot || !m_compositingLayersNeedRebuild);
@@ -794,6 +794,9 @@ public:
     virtual LayoutUnit maxPreferredLogicalWidth() const { return 0; }
 
     RenderStyle* style() const { return m_style.get(); }
+    // Like style(), but first gives this renderer a private copy if its style is shared through interning.
+    // Use this before recording per-element state in the style.
+    RenderStyle* uninternedStyle() const;
     RenderStyle* firstLineStyle() const { return document()->styleSheetCollection()->usesFirstLineRules() ? cachedFirstLineStyle() : style(); }
     RenderStyle* style(bool firstLine) const { return firstLine ? firstLineStyle() : style(); }
 
@@ -66,6 +66,19 @@ class SecureTextTimer;
 typedef HashMap<RenderText*, SecureTextTimer*> SecureTextTimerMap;
 static SecureTextTimerMap* gSecureTextTimers = 0;
 
+// Keys are the word's start offset in the high and its length in the low 32 bits.
+typedef HashMap<uint64_t, float> WordWidthMap;
+typedef HashMap<const RenderText*, OwnPtr<WordWidthMap> > WordWidthCacheMap;
+static WordWidthCacheMap* gWordWidthCaches = 0;
+
+// A 100KB paragraph has about 16K words; cap the cache so pathological texts don't grow it unbounded.
+static const unsigned maximumCachedWordWidthsPerText = 16384;
+
+static inline uint64_t wordWidthKey(unsigned from, unsigned len)
+{
+    return (static_cast<uint64_t>(from) << 32) | len;
+}
+
 class SecureTextTimer : public TimerBase {
 public:
     SecureTextTimer(RenderText* renderText)
@@ -141,6 +154,8 @@ RenderText::RenderText(Node* node, PassRefPtr<StringImpl> str)
     , m_containsReversedText(false)
     , m_knownToHaveNoOverflowAndNoFallbackFonts(false)
     , m_needsTranscoding(false)
+    , m_hasWordWidthCache(false)
+    , m_usesSimpleLineLayout(false)
     , m_minWidth(-1)
     , m_maxWidth(-1)
     , m_beginMinWidth(0)
@@ -214,6 +229,8 @@ void RenderText::styleDidChange(StyleDifference diff, const RenderStyle* oldStyl
         needsResetText = true;
     }
 
+    clearWordWidthCache();
+
     ETextTransform oldTransform = oldStyle ? oldStyle->textTransform() : TTNONE;
     ETextSecurity oldSecurity = oldStyle ? oldStyle->textSecurity() : TSNONE;
     if (needsResetText || oldTransform != newStyle->textTransform() || oldSecurity != newStyle->textSecurity()) 
@@ -223,13 +240,13 @@ void RenderText::styleDidChange(StyleDifference diff, const RenderStyle* oldStyl
 void RenderText::removeAndDestroyTextBoxes()
 {
     if (!documentBeingDestroyed()) {
-        if (firstTextBox()) {
+        if (m_firstTextBox) {
             if (isBR()) {
-                RootInlineBox* next = firstTextBox()->root()->nextRootBox();
+                RootInlineBox* next = m_firstTextBox->root()->nextRootBox();
                 if (next)
                     next->markDirty();
             }
-            for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
+            for (InlineTextBox* box = m_firstTextBox; box; box = box->nextTextBox())
                 box->remove();
         } else if (parent())
             parent()->dirtyLinesFromChangedChild(this);
@@ -242,6 +259,7 @@ void RenderText::willBeDestroyed()
     if (SecureTextTimer* secureTextTimer = gSecureTextTimers ? gSecureTextTimers->take(this) : 0)
         delete secureTextTimer;
 
+    clearWordWidthCache();
     removeAndDestroyTextBoxes();
     RenderObject::willBeDestroyed();
 }
@@ -299,10 +317,10 @@ void RenderText::removeTextBox(InlineTextBox* box)
 
 void RenderText::deleteTextBoxes()
 {
-    if (firstTextBox()) {
+    if (m_firstTextBox) {
         RenderArena* arena = renderArena();
         InlineTextBox* next;
-        for (InlineTextBox* curr = firstTextBox(); curr; curr = next) {
+        for (InlineTextBox* curr = m_firstTextBox; curr; curr = next) {
             next = curr->nextTextBox();
             curr->destroy(arena);
         }
@@ -318,6 +336,14 @@ PassRefPtr<StringImpl> RenderText::originalText() const
 
 void RenderText::absoluteRects(Vector<IntRect>& rects, const LayoutPoint& accumulatedOffset) const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        for (unsigned i = 0; i < layout->lineCount(); ++i) {
+            LayoutRect rect = layout->textRectForLine(i);
+            rect.moveBy(accumulatedOffset);
+            rects.append(enclosingIntRect(rect));
+        }
+        return;
+    }
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
         rects.append(enclosingIntRect(FloatRect(accumulatedOffset + box->topLeft(), box->size())));
 }
@@ -354,7 +380,10 @@ void RenderText::absoluteRectsForRange(Vector<IntRect>& rects, unsigned start, u
     ASSERT(start <= INT_MAX);
     start = min(start, static_cast<unsigned>(INT_MAX));
     end = min(end, static_cast<unsigned>(INT_MAX));
-    
+
+    // Partial lines are measured by the text boxes.
+    ensureLineBoxes();
+
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         // Note: box->end() returns the index of the last character, not the index past it
         if (start <= box->start() && box->end() < end) {
@@ -405,6 +434,12 @@ static IntRect ellipsisRectForBox(InlineTextBox* box, unsigned startPos, unsigne
     
 void RenderText::absoluteQuads(Vector<FloatQuad>& quads, bool* wasFixed, ClippingOption option) const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        // Text on the simple path is never truncated with an ellipsis.
+        for (unsigned i = 0; i < layout->lineCount(); ++i)
+            quads.append(localToAbsoluteQuad(FloatRect(layout->textRectForLine(i)), 0, wasFixed));
+        return;
+    }
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         FloatRect boundaries = box->calculateBoundaries();
 
@@ -437,7 +472,10 @@ void RenderText::absoluteQuadsForRange(Vector<FloatQuad>& quads, unsigned start,
     ASSERT(start <= INT_MAX);
     start = min(start, static_cast<unsigned>(INT_MAX));
     end = min(end, static_cast<unsigned>(INT_MAX));
-    
+
+    // Partial lines are measured by the text boxes.
+    ensureLineBoxes();
+
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         // Note: box->end() returns the index of the last character, not the index past it
         if (start <= box->start() && box->end() < end) {
@@ -472,6 +510,7 @@ InlineTextBox* RenderText::findNextInlineTextBox(int offset, int& pos) const
         return 0;
 
     InlineTextBox* s = m_firstTextBox;
+
     int off = s->len();
     while (offset > off && s->nextTextBox()) {
         s = s->nextTextBox();
@@ -612,6 +651,8 @@ static VisiblePosition createVisiblePositionAfterAdjustingOffsetForBiDi(const In
 
 VisiblePosition RenderText::positionForPoint(const LayoutPoint& point)
 {
+    ensureLineBoxes();
+
     if (!firstTextBox() || textLength() == 0)
         return createVisiblePosition(0, DOWNSTREAM);
 
@@ -1216,16 +1257,24 @@ FloatPoint RenderText::firstRunOrigin() const
 
 float RenderText::firstRunX() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return layout->lineCount() ? layout->textRectForLine(0).x().toFloat() : 0;
     return m_firstTextBox ? m_firstTextBox->x() : 0;
 }
 
 float RenderText::firstRunY() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return layout->lineCount() ? layout->textRectForLine(0).y().toFloat() : 0;
     return m_firstTextBox ? m_firstTextBox->y() : 0;
 }
     
 void RenderText::setSelectionState(SelectionState state)
 {
+    // Selection is painted by the text boxes.
+    if (state != SelectionNone)
+        ensureLineBoxes();
+
     RenderObject::setSelectionState(state);
 
     if (canUpdateSelectionOnRootLineBoxes()) {
@@ -1279,7 +1328,7 @@ void RenderText::setTextWithOffset(PassRefPtr<StringImpl> text, unsigned offset,
     bool dirtiedLines = false;
 
     // Dirty all text boxes that include characters in between offset and offset+len.
-    for (InlineTextBox* curr = firstTextBox(); curr; curr = curr->nextTextBox()) {
+    for (InlineTextBox* curr = m_firstTextBox; curr; curr = curr->nextTextBox()) {
         // FIXME: This shouldn't rely on the end of a dirty line box. See https://bugs.webkit.org/show_bug.cgi?id=97264
         // Text run is entirely before the affected range.
         if (curr->end() < offset)
@@ -1322,9 +1371,9 @@ void RenderText::setTextWithOffset(PassRefPtr<StringImpl> text, unsigned offset,
         RootInlineBox* prev = firstRootBox->prevRootBox();
         if (prev)
             firstRootBox = prev;
-    } else if (lastTextBox()) {
+    } else if (m_lastTextBox) {
         ASSERT(!lastRootBox);
-        firstRootBox = lastTextBox()->root();
+        firstRootBox = m_lastTextBox->root();
         firstRootBox->markDirty();
         dirtiedLines = true;
     }
@@ -1333,14 +1382,80 @@ void RenderText::setTextWithOffset(PassRefPtr<StringImpl> text, unsigned offset,
             curr->setLineBreakPos(curr->lineBreakPos() + delta);
     }
 
+    // Likewise keep the measured widths of the words outside of the edited range. A word touching
+    // the range may be shaped differently now, so it is dropped. Transformed and secured text can
+    // change outside of the edited range, so their cache is simply cleared by setText() below.
+    OwnPtr<WordWidthMap> wordWidths;
+    if (m_hasWordWidthCache && style()->textTransform() == TTNONE && style()->textSecurity() == TSNONE) {
+        OwnPtr<WordWidthMap> oldWordWidths = gWordWidthCaches->take(this);
+        m_hasWordWidthCache = false;
+        wordWidths = adoptPtr(new WordWidthMap);
+        WordWidthMap::const_iterator wordWidthsEnd = oldWordWidths->end();
+        for (WordWidthMap::const_iterator it = oldWordWidths->begin(); it != wordWidthsEnd; ++it) {
+            unsigned wordStart = static_cast<unsigned>(it->key >> 32);
+            unsigned wordLength = static_cast<unsigned>(it->key);
+            if (wordStart + wordLength < offset)
+                wordWidths->add(it->key, it->value);
+            else if (wordStart > end + 1)
+                wordWidths->add(wordWidthKey(wordStart + delta, wordLength), it->value);
+        }
+    }
+
     // If the text node is empty, dirty the line where new text will be inserted.
-    if (!firstTextBox() && parent()) {
+    if (!m_firstTextBox && parent()) {
         parent()->dirtyLinesFromChangedChild(this);
         dirtiedLines = true;
     }
 
     m_linesDirty = dirtiedLines;
     setText(text, force || dirtiedLines);
+
+    if (wordWidths && !wordWidths->isEmpty()) {
+        ASSERT(!m_hasWordWidthCache);
+        gWordWidthCaches->set(this, wordWidths.release());
+        m_hasWordWidthCache = true;
+    }
+}
+
+bool RenderText::cachedWordWidth(unsigned from, unsigned len, float& width) const
+{
+    if (!m_hasWordWidthCache)
+        return false;
+
+    WordWidthMap* wordWidths = gWordWidthCaches->get(this);
+    WordWidthMap::const_iterator it = wordWidths->find(wordWidthKey(from, len));
+    if (it == wordWidths->end())
+        return false;
+    width = it->value;
+    return true;
+}
+
+void RenderText::cacheWordWidth(unsigned from, unsigned len, float width)
+{
+    ASSERT(len);
+    ASSERT(from + len <= textLength());
+
+    if (!gWordWidthCaches)
+        gWordWidthCaches = new WordWidthCacheMap;
+
+    WordWidthCacheMap::AddResult result = gWordWidthCaches->add(this, nullptr);
+    if (result.isNewEntry) {
+        result.iterator->value = adoptPtr(new WordWidthMap);
+        m_hasWordWidthCache = true;
+    }
+
+    WordWidthMap* wordWidths = result.iterator->value.get();
+    if (wordWidths->size() < maximumCachedWordWidthsPerText)
+        wordWidths->set(wordWidthKey(from, len), width);
+}
+
+void RenderText::clearWordWidthCache()
+{
+    if (!m_hasWordWidthCache)
+        return;
+
+    gWordWidthCaches->remove(this);
+    m_hasWordWidthCache = false;
 }
 
 void RenderText::transformText()
@@ -1461,6 +1576,7 @@ void RenderText::setText(PassRefPtr<StringImpl> text, bool force)
         return;
 
     setTextInternal(text);
+    clearWordWidthCache();
     setNeedsLayoutAndPrefWidthsRecalc();
     m_knownToHaveNoOverflowAndNoFallbackFonts = false;
     
@@ -1486,12 +1602,29 @@ void RenderText::dirtyLineBoxes(bool fullLayout)
     if (fullLayout)
         deleteTextBoxes();
     else if (!m_linesDirty) {
-        for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
+        for (InlineTextBox* box = m_firstTextBox; box; box = box->nextTextBox())
             box->dirtyLineBoxes();
     }
     m_linesDirty = false;
 }
 
+const SimpleLineLayout::Layout* RenderText::simpleLineLayout() const
+{
+    if (!m_usesSimpleLineLayout)
+        return 0;
+    ASSERT(parent() && parent()->isRenderBlock());
+    return toRenderBlock(parent())->simpleLineLayout();
+}
+
+void RenderText::ensureLineBoxes()
+{
+    if (!m_usesSimpleLineLayout)
+        return;
+    if (parent() && parent()->isRenderBlock())
+        toRenderBlock(parent())->ensureLineBoxes();
+    m_usesSimpleLineLayout = false;
+}
+
 InlineTextBox* RenderText::createTextBox()
 {
     return new (renderArena()) InlineTextBox(this);
@@ -1583,6 +1716,12 @@ float RenderText::width(unsigned from, unsigned len, const Font& f, float xPos,
 IntRect RenderText::linesBoundingBox() const
 {
     IntRect result;
+
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        for (unsigned i = 0; i < layout->lineCount(); ++i)
+            result.unite(enclosingIntRect(layout->textRectForLine(i)));
+        return result;
+    }
     
     ASSERT(!firstTextBox() == !lastTextBox());  // Either both are null or both exist.
     if (firstTextBox() && lastTextBox()) {
@@ -1610,6 +1749,14 @@ IntRect RenderText::linesBoundingBox() const
 
 LayoutRect RenderText::linesVisualOverflowBoundingBox() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        // The simple path excludes text shadows, strokes and emphasis marks, so nothing paints outside the text rects.
+        LayoutRect rect;
+        for (unsigned i = 0; i < layout->lineCount(); ++i)
+            rect.unite(layout->textRectForLine(i));
+        return rect;
+    }
+
     if (!firstTextBox())
         return LayoutRect();
 
@@ -1695,6 +1842,9 @@ LayoutRect RenderText::selectionRectForRepaint(const RenderLayerModelObject* rep
 
 int RenderText::caretMinOffset() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return layout->lineCount() ? layout->lineAt(0).textOffset : 0;
+
     InlineTextBox* box = firstTextBox();
     if (!box)
         return 0;
@@ -1706,6 +1856,13 @@ int RenderText::caretMinOffset() const
 
 int RenderText::caretMaxOffset() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        if (!layout->lineCount())
+            return textLength();
+        const SimpleLineLayout::Line& lastLine = layout->lineAt(layout->lineCount() - 1);
+        return lastLine.textOffset + lastLine.textLength;
+    }
+
     InlineTextBox* box = lastTextBox();
     if (!lastTextBox())
         return textLength();
@@ -1718,6 +1875,13 @@ int RenderText::caretMaxOffset() const
 
 unsigned RenderText::renderedTextLength() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        unsigned length = 0;
+        for (unsigned i = 0; i < layout->lineCount(); ++i)
+            length += layout->lineAt(i).textLength;
+        return length;
+    }
+
     int l = 0;
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
         l += box->len();
@@ -31,6 +31,10 @@ namespace WebCore {
 
 class InlineTextBox;
 
+namespace SimpleLineLayout {
+class Layout;
+}
+
 class RenderText : public RenderObject {
 public:
     RenderText(Node*, PassRefPtr<StringImpl>);
@@ -110,9 +114,15 @@ public:
 
     virtual LayoutRect clippedOverflowRectForRepaint(const RenderLayerModelObject* repaintContainer) const OVERRIDE;
 
+    // Text laid out by the simple line layout path has no text boxes, see SimpleLineLayout.h.
+    // Code that needs them outside of layout and painting calls ensureLineBoxes() first.
     InlineTextBox* firstTextBox() const { return m_firstTextBox; }
     InlineTextBox* lastTextBox() const { return m_lastTextBox; }
 
+    bool usesSimpleLineLayout() const { return m_usesSimpleLineLayout; }
+    void setUsesSimpleLineLayout(bool usesSimpleLineLayout) { m_usesSimpleLineLayout = usesSimpleLineLayout; }
+    void ensureLineBoxes();
+
     virtual int caretMinOffset() const;
     virtual int caretMaxOffset() const;
     virtual unsigned renderedTextLength() const;
@@ -135,6 +145,12 @@ public:
     bool canUseSimpleFontCodePath() const { return m_canUseSimpleFontCodePath; }
     bool knownToHaveNoOverflowAndNoFallbackFonts() const { return m_knownToHaveNoOverflowAndNoFallbackFonts; }
 
+    // Widths of words measured by line layout with the primary font, keyed by their text range.
+    // The cache survives relayouts; edits through setTextWithOffset() keep the entries outside of
+    // the edited range, and any other text or style change clears it.
+    bool cachedWordWidth(unsigned from, unsigned len, float& width) const;
+    void cacheWordWidth(unsigned from, unsigned len, float width);
+
     void removeAndDestroyTextBoxes();
 
 protected:
@@ -164,6 +180,7 @@ private:
     virtual bool nodeAtPoint(const HitTestRequest&, HitTestResult&, const HitTestLocation&, const LayoutPoint&, HitTestAction) OVERRIDE { ASSERT_NOT_REACHED(); return false; }
 
     void deleteTextBoxes();
+    const SimpleLineLayout::Layout* simpleLineLayout() const;
     bool containsOnlyWhitespace(unsigned from, unsigned len) const;
     float widthFromCache(const Font&, int start, int len, float xPos, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow*) const;
     bool isAllASCII() const { return m_isAllASCII; }
@@ -171,6 +188,8 @@ private:
 
     void secureText(UChar mask);
 
+    void clearWordWidthCache();
+
     // We put the bitfield first to minimize padding on 64-bit.
     bool m_hasBreakableChar : 1; // Whether or not we can be broken into multiple lines.
     bool m_hasBreak : 1; // Whether or not we have a hard break (e.g., <pre> with '\n').
@@ -186,6 +205,8 @@ private:
     bool m_canUseSimpleFontCodePath : 1;
     mutable bool m_knownToHaveNoOverflowAndNoFallbackFonts : 1;
     bool m_needsTranscoding : 1;
+    bool m_hasWordWidthCache : 1;
+    bool m_usesSimpleLineLayout : 1;
     
     float m_minWidth;
     float m_maxWidth;
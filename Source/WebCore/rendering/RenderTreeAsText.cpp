@@ -527,6 +527,21 @@ static void writeTextRun(TextStream& ts, const RenderText& o, const InlineTextBo
     ts << "\n";
 }
 
+static void writeSimpleLine(TextStream& ts, const RenderText& o, const SimpleLineLayout::Layout& layout, unsigned lineIndex)
+{
+    // Written like writeTextRun() so that dumps match between the two line layout paths.
+    const SimpleLineLayout::Line& line = layout.lineAt(lineIndex);
+    LayoutRect rect = layout.textRectForLine(lineIndex);
+    int x = rect.x();
+    int y = rect.y();
+    int logicalWidth = ceilf(line.logicalLeft + line.logicalWidth) - x;
+
+    ts << "text run at (" << x << "," << y << ") width " << logicalWidth;
+    ts << ": "
+        << quoteAndEscapeNonPrintables(String(o.text()).substring(line.textOffset, line.textLength));
+    ts << "\n";
+}
+
 void write(TextStream& ts, const RenderObject& o, int indent, RenderAsTextBehavior behavior)
 {
 #if ENABLE(SVG)
@@ -571,6 +586,13 @@ void write(TextStream& ts, const RenderObject& o, int indent, RenderAsTextBehavi
 
     if (o.isText() && !o.isBR()) {
         const RenderText& text = *toRenderText(&o);
+        if (text.usesSimpleLineLayout()) {
+            const SimpleLineLayout::Layout& layout = *toRenderBlock(text.parent())->simpleLineLayout();
+            for (unsigned i = 0; i < layout.lineCount(); ++i) {
+                writeIndent(ts, indent + 1);
+                writeSimpleLine(ts, text, layout, i);
+            }
+        }
         for (InlineTextBox* box = text.firstTextBox(); box; box = box->nextTextBox()) {
             writeIndent(ts, indent + 1);
             writeTextRun(ts, text, *box);
@@ -26,6 +26,7 @@
 #include "LayoutState.h"
 #include "PODFreeListArena.h"
 #include "RenderBlock.h"
+#include <wtf/HashMap.h>
 #include <wtf/OwnPtr.h>
 
 namespace WebCore {
@@ -230,6 +231,12 @@ public:
 
     IntRect pixelSnappedLayoutOverflowRect() const { return pixelSnappedIntRect(layoutOverflowRect()); }
 
+    // Bounds used by RenderLayer::hitTestList() to skip layer subtrees that can't contain the hit test location.
+    // Anything that moves layers or their contents (layout, scrolling, transform changes) clears them.
+    typedef HashMap<const RenderLayer*, LayoutRect> LayerHitTestBoundsMap;
+    LayerHitTestBoundsMap& layerHitTestBounds() { return m_layerHitTestBounds; }
+    void invalidateLayerHitTestBounds() { m_layerHitTestBounds.clear(); }
+
 protected:
     virtual void mapLocalToContainer(const RenderLayerModelObject* repaintContainer, TransformState&, MapCoordinatesFlags = ApplyContainerFlip, bool* wasFixed = 0) const OVERRIDE;
     virtual const RenderObject* pushMappingToContainer(const RenderLayerModelObject* ancestorToStopAt, RenderGeometryMap&) const OVERRIDE;
@@ -343,6 +350,8 @@ private:
     RenderQuote* m_renderQuoteHead;
     unsigned m_renderCounterCount;
 
+    LayerHitTestBoundsMap m_layerHitTestBounds;
+
     bool m_selectionWasCaret;
 };
 
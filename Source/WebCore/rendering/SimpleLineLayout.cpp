@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SimpleLineLayout.h"
+
+#include "Document.h"
+#include "DocumentStyleSheetCollection.h"
+#include "GraphicsContext.h"
+#include "HitTestLocation.h"
+#include "HitTestRequest.h"
+#include "HitTestResult.h"
+#include "InlineTextBox.h"
+#include "LayoutState.h"
+#include "PaintInfo.h"
+#include "RenderBlock.h"
+#include "RenderText.h"
+#include "RenderView.h"
+#include "Settings.h"
+#include "SimpleFontData.h"
+#include "break_lines.h"
+#include <wtf/unicode/CharacterNames.h>
+
+namespace WebCore {
+namespace SimpleLineLayout {
+
+static bool canUseForText(const RenderText* textRenderer)
+{
+    if (textRenderer->isBR() || textRenderer->isCombineText() || textRenderer->isCounter() || textRenderer->isQuote()
+        || textRenderer->isTextFragment() || textRenderer->isSVGInlineText())
+        return false;
+    if (!textRenderer->canUseSimpleFontCodePath())
+        return false;
+
+    // Collapsible whitespace must already be collapsed, so that each line maps to a contiguous
+    // range of the text and only single spaces separate the words.
+    unsigned length = textRenderer->textLength();
+    UChar previous = 0;
+    for (unsigned i = 0; i < length; ++i) {
+        UChar character = textRenderer->characterAt(i);
+        if (character < ' ' || character == softHyphen)
+            return false;
+        if (character == ' ' && previous == ' ')
+            return false;
+        previous = character;
+    }
+    return true;
+}
+
+static bool canUseForStyle(const RenderStyle* style)
+{
+    switch (style->textAlign()) {
+    case LEFT:
+    case RIGHT:
+    case CENTER:
+    case TASTART:
+    case TAEND:
+        break;
+    default:
+        return false;
+    }
+    if (!style->isLeftToRightDirection() || style->unicodeBidi() != UBNormal)
+        return false;
+    if (!style->isHorizontalWritingMode() || style->isFlippedBlocksWritingMode())
+        return false;
+    if (style->whiteSpace() != NORMAL || style->nbspMode() != NBNORMAL || style->lineBreak() != LineBreakAuto)
+        return false;
+    if (style->wordBreak() != NormalWordBreak || style->overflowWrap() != NormalOverflowWrap || style->hyphens() == HyphensAuto)
+        return false;
+    if (!style->textIndent().isZero() || style->textOverflow())
+        return false;
+    if (style->textDecorationsInEffect() != TextDecorationNone || style->textShadow() || style->textStrokeWidth() > 0)
+        return false;
+    if (style->textEmphasisMark() != TextEmphasisMarkNone || style->hasTextCombine() || style->textSecurity() != TSNONE)
+        return false;
+    if (style->backgroundClip() == TextFillBox || style->visibility() != VISIBLE || style->userModify() != READ_ONLY)
+        return false;
+    if (style->lineBoxContain() != RenderStyle::initialLineBoxContain() || !style->lineGrid().isNull())
+        return false;
+    if (style->hasPseudoStyle(FIRST_LINE) || style->hasPseudoStyle(FIRST_LETTER))
+        return false;
+    if (style->font().primaryFont()->isSVGFont())
+        return false;
+    return true;
+}
+
+bool canUseFor(const RenderBlock* block)
+{
+    Document* document = block->document();
+    Settings* settings = document->settings();
+    if (!settings || !settings->simpleLineLayoutEnabled())
+        return false;
+    if (document->inDesignMode() || document->styleSheetCollection()->usesFirstLineRules() || document->styleSheetCollection()->usesFirstLetterRules())
+        return false;
+
+    if (!block->childrenInline() || !block->firstChild() || block->firstChild() != block->lastChild() || !block->firstChild()->isText())
+        return false;
+    if (block->isTableCell() || (block->isInline() && block->isReplaced()) || block->isListItem() || block->isFlexItemIncludingDeprecated()
+        || block->isRubyBase() || block->isRubyRun() || block->isRubyText())
+        return false;
+    if (block->hasColumns() || block->containsFloats() || block->flowThreadContainingBlock())
+        return false;
+    if (LayoutState* layoutState = block->view()->layoutState()) {
+        if (layoutState->isPaginated() || layoutState->lineGrid())
+            return false;
+    }
+    if (RenderObject* parent = block->parent()) {
+        if (block->isAnonymousBlock() && parent->style()->textOverflow())
+            return false;
+    }
+
+    if (!canUseForStyle(block->style()))
+        return false;
+    return canUseForText(toRenderText(block->firstChild()));
+}
+
+static float measureText(RenderText* textRenderer, const Font& font, unsigned from, unsigned length, bool& usedFallbackFonts)
+{
+    float width;
+    if (textRenderer->cachedWordWidth(from, length, width))
+        return width;
+
+    HashSet<const SimpleFontData*> fallbackFonts;
+    width = textRenderer->width(from, length, font, 0, &fallbackFonts);
+    if (!fallbackFonts.isEmpty())
+        usedFallbackFonts = true;
+    else
+        textRenderer->cacheWordWidth(from, length, width);
+    return width;
+}
+
+static unsigned skipSpaces(const RenderText* textRenderer, unsigned position)
+{
+    unsigned length = textRenderer->textLength();
+    while (position < length && textRenderer->characterAt(position) == ' ')
+        ++position;
+    return position;
+}
+
+static float alignmentOffset(ETextAlign textAlign, float availableWidth, float lineWidth)
+{
+    float remainingWidth = availableWidth - lineWidth;
+    if (remainingWidth <= 0)
+        return 0;
+    switch (textAlign) {
+    case RIGHT:
+    case TAEND:
+        return remainingWidth;
+    case CENTER:
+        return remainingWidth / 2;
+    default:
+        return 0;
+    }
+}
+
+Layout::Layout(LayoutUnit firstLineTop, LayoutUnit lineHeight, LayoutUnit baseline, int ascent, int textHeight)
+    : m_firstLineTop(firstLineTop)
+    , m_lineHeight(lineHeight)
+    , m_baseline(baseline)
+    , m_ascent(ascent)
+    , m_textHeight(textHeight)
+{
+}
+
+PassOwnPtr<Layout> Layout::create(RenderBlock* block)
+{
+    ASSERT(canUseFor(block));
+
+    RenderText* textRenderer = toRenderText(block->firstChild());
+    RenderStyle* style = block->style();
+    const Font& font = style->font();
+    const FontMetrics& fontMetrics = font.fontMetrics();
+
+    LayoutUnit lineHeight = block->lineHeight(false, HorizontalLine, PositionOfInteriorLineBoxes);
+    LayoutUnit baseline = block->baselinePosition(AlphabeticBaseline, false, HorizontalLine, PositionOfInteriorLineBoxes);
+    OwnPtr<Layout> layout = adoptPtr(new Layout(block->borderAndPaddingBefore(), lineHeight, baseline, fontMetrics.ascent(), fontMetrics.height()));
+
+    // Without floats or text-indent every line has the same available width.
+    LayoutUnit lineLogicalLeft = block->logicalLeftOffsetForLine(layout->m_firstLineTop, false);
+    float availableWidth = block->availableLogicalWidthForLine(layout->m_firstLineTop, false);
+
+    // Break opportunities either sit on a space or follow a break-after character such as a
+    // hyphen, or for text the ICU break iterator handles, follow the spaces. Segments between two
+    // of them are measured separately, the same way the full line layout measures words, and the
+    // final line width is measured as a single run. Like in the full path, collapsible spaces at
+    // the end of a line hang and don't count against the available width.
+    LazyLineBreakIterator lineBreakIterator(textRenderer->text(), style->locale());
+    unsigned length = textRenderer->textLength();
+    bool usedFallbackFonts = false;
+    unsigned lineStart = skipSpaces(textRenderer, 0);
+    while (lineStart < length) {
+        unsigned lineEnd = lineStart;
+        float committedWidth = 0;
+        while (lineEnd < length) {
+            unsigned segmentEnd = std::min<unsigned>(nextBreakablePositionIgnoringNBSP(lineBreakIterator, lineEnd + 1), length);
+            float segmentWidth = measureText(textRenderer, font, lineEnd, segmentEnd - lineEnd, usedFallbackFonts);
+            unsigned segmentContentEnd = segmentEnd;
+            while (segmentContentEnd > lineEnd && textRenderer->characterAt(segmentContentEnd - 1) == ' ')
+                --segmentContentEnd;
+            float trailingSpaceWidth = 0;
+            if (segmentContentEnd < segmentEnd)
+                trailingSpaceWidth = measureText(textRenderer, font, segmentContentEnd, segmentEnd - segmentContentEnd, usedFallbackFonts);
+            if (lineEnd > lineStart && committedWidth + segmentWidth - trailingSpaceWidth > availableWidth)
+                break;
+            committedWidth += segmentWidth;
+            lineEnd = segmentEnd;
+        }
+
+        unsigned trimmedEnd = lineEnd;
+        while (trimmedEnd > lineStart && textRenderer->characterAt(trimmedEnd - 1) == ' ')
+            --trimmedEnd;
+
+        HashSet<const SimpleFontData*> fallbackFonts;
+        float lineWidth = textRenderer->width(lineStart, trimmedEnd - lineStart, font, 0, &fallbackFonts);
+        if (usedFallbackFonts || !fallbackFonts.isEmpty())
+            return nullptr;
+
+        Line line;
+        line.textOffset = lineStart;
+        line.textLength = trimmedEnd - lineStart;
+        line.logicalLeft = lineLogicalLeft + alignmentOffset(style->textAlign(), availableWidth, lineWidth);
+        line.logicalWidth = lineWidth;
+        layout->m_lines.append(line);
+
+        lineStart = skipSpaces(textRenderer, lineEnd);
+    }
+
+    layout->m_lines.shrinkToFit();
+    return layout.release();
+}
+
+LayoutRect Layout::textRectForLine(unsigned index) const
+{
+    const Line& line = m_lines[index];
+    LayoutUnit top = lineTop(index) + m_baseline - m_ascent;
+    return LayoutRect(line.logicalLeft, top, line.logicalWidth, m_textHeight);
+}
+
+LayoutRect Layout::layoutOverflowRect() const
+{
+    LayoutRect overflowRect;
+    for (unsigned i = 0; i < m_lines.size(); ++i) {
+        const Line& line = m_lines[i];
+        overflowRect.unite(LayoutRect(line.logicalLeft, lineTop(i), line.logicalWidth, m_lineHeight));
+    }
+    return overflowRect;
+}
+
+void paint(RenderBlock* block, const Layout& layout, PaintInfo& paintInfo, const LayoutPoint& paintOffset)
+{
+    if (paintInfo.phase != PaintPhaseForeground && paintInfo.phase != PaintPhaseTextClip)
+        return;
+
+    RenderText* textRenderer = toRenderText(block->firstChild());
+    if (!paintInfo.shouldPaintWithinRoot(textRenderer))
+        return;
+
+    RenderStyle* style = block->style();
+    GraphicsContext* context = paintInfo.context;
+
+    Color textFillColor;
+    if (paintInfo.forceBlackText())
+        textFillColor = Color::black;
+    else {
+        textFillColor = style->visitedDependentColor(CSSPropertyWebkitTextFillColor);
+
+        Document* document = block->document();
+        if (document->printing() && style->printColorAdjust() == PrintColorAdjustEconomy
+            && !(document->settings() && document->settings()->shouldPrintBackgrounds()))
+            textFillColor = correctedTextColor(textFillColor, Color::white);
+    }
+    updateGraphicsContext(context, textFillColor, textFillColor, 0, style->colorSpace());
+
+    LayoutPoint adjustedPaintOffset = roundedIntPoint(paintOffset);
+    LayoutRect paintRect = paintInfo.rect;
+    for (unsigned i = 0; i < layout.lineCount(); ++i) {
+        LayoutRect visualRect = layout.textRectForLine(i);
+        visualRect.moveBy(adjustedPaintOffset);
+        if (visualRect.y() >= paintRect.maxY())
+            break;
+        if (!visualRect.intersects(paintRect))
+            continue;
+
+        const Line& line = layout.lineAt(i);
+        TextRun textRun = RenderBlock::constructTextRun(textRenderer, style->font(), textRenderer, line.textOffset, line.textLength, style);
+        FloatPoint textOrigin(adjustedPaintOffset.x() + line.logicalLeft, adjustedPaintOffset.y() + layout.lineTop(i) + layout.baseline());
+        context->drawText(style->font(), textRun, textOrigin);
+    }
+}
+
+bool hitTest(RenderBlock* block, const Layout& layout, const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, HitTestAction hitTestAction)
+{
+    if (hitTestAction != HitTestForeground)
+        return false;
+
+    RenderText* textRenderer = toRenderText(block->firstChild());
+    if (!textRenderer->visibleToHitTesting())
+        return false;
+
+    for (unsigned i = layout.lineCount(); i; --i) {
+        LayoutRect rect = layout.textRectForLine(i - 1);
+        rect.moveBy(accumulatedOffset);
+        if (!locationInContainer.intersects(rect))
+            continue;
+        textRenderer->updateHitTestResult(result, locationInContainer.point() - toLayoutSize(accumulatedOffset));
+        if (!result.addNodeToRectBasedTestResult(textRenderer->node(), request, locationInContainer, rect))
+            return true;
+    }
+    return false;
+}
+
+} // namespace SimpleLineLayout
+} // namespace WebCore
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SimpleLineLayout_h
+#define SimpleLineLayout_h
+
+#include "LayoutRect.h"
+#include "RenderObject.h"
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class HitTestLocation;
+class HitTestRequest;
+class HitTestResult;
+class RenderBlock;
+class RenderText;
+struct PaintInfo;
+
+// Line layout for blocks whose only child is a single run of plain text. Instead of building
+// RootInlineBox/InlineTextBox trees, the layout only records where each line starts and ends
+// in the text together with its position. Anything that needs real line boxes (selection,
+// editing, caret positioning) asks the block for them through RenderBlock::ensureLineBoxes().
+namespace SimpleLineLayout {
+
+bool canUseFor(const RenderBlock*);
+
+struct Line {
+    unsigned textOffset;
+    unsigned textLength;
+    float logicalLeft;
+    float logicalWidth;
+};
+
+class Layout {
+    WTF_MAKE_NONCOPYABLE(Layout); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Returns 0 if the text turns out to need something the simple path can't represent.
+    static PassOwnPtr<Layout> create(RenderBlock*);
+
+    unsigned lineCount() const { return m_lines.size(); }
+    const Line& lineAt(unsigned index) const { return m_lines[index]; }
+
+    LayoutUnit lineHeight() const { return m_lineHeight; }
+    LayoutUnit baseline() const { return m_baseline; }
+    LayoutUnit height() const { return m_lineHeight * lineCount(); }
+
+    // Relative to the block's border box.
+    LayoutUnit lineTop(unsigned index) const { return m_firstLineTop + m_lineHeight * index; }
+    LayoutRect textRectForLine(unsigned index) const;
+    LayoutRect layoutOverflowRect() const;
+
+private:
+    Layout(LayoutUnit firstLineTop, LayoutUnit lineHeight, LayoutUnit baseline, int ascent, int textHeight);
+
+    Vector<Line> m_lines;
+    LayoutUnit m_firstLineTop;
+    LayoutUnit m_lineHeight;
+    LayoutUnit m_baseline;
+    int m_ascent;
+    int m_textHeight;
+};
+
+void paint(RenderBlock*, const Layout&, PaintInfo&, const LayoutPoint& paintOffset);
+bool hitTest(RenderBlock*, const Layout&, const HitTestRequest&, HitTestResult&, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, HitTestAction);
+
+} // namespace SimpleLineLayout
+} // namespace WebCore
+
+#endif // SimpleLineLayout_h
@@ -164,6 +164,8 @@ ALWAYS_INLINE RenderStyle::RenderStyle(const RenderStyle& o)
     , inherited_flags(o.inherited_flags)
     , noninherited_flags(o.noninherited_flags)
 {
+    // A copy is private to whoever made it.
+    noninherited_flags.isInterned = false;
 }
 
 void RenderStyle::inheritFrom(const RenderStyle* inheritParent, IsAtShadowBoundary isAtShadowBoundary)
@@ -341,6 +343,66 @@ bool RenderStyle::inheritedDataShared(const RenderStyle* other) const
         && rareInheritedData.get() == other->rareInheritedData.get();
 }
 
+bool RenderStyle::allDataShared(const RenderStyle* other) const
+{
+    // Like inheritedDataShared(), this only checks identity of the data structures, never their contents.
+    return inheritedDataShared(other)
+        && noninherited_flags == other->noninherited_flags
+        && m_box.get() == other->m_box.get()
+        && visual.get() == other->visual.get()
+        && m_background.get() == other->m_background.get()
+        && surround.get() == other->surround.get()
+        && rareNonInheritedData.get() == other->rareNonInheritedData.get();
+}
+
+unsigned RenderStyle::hashForDataSharing() const
+{
+    // Styles with equal allDataShared() have equal hashes. The flags are left out; they are
+    // compared on lookup and rarely differ between styles sharing all of their data groups.
+    const void* dataPointers[] = {
+        m_box.get(),
+        visual.get(),
+        m_background.get(),
+        surround.get(),
+        rareNonInheritedData.get(),
+        rareInheritedData.get(),
+        inherited.get(),
+#if ENABLE(SVG)
+        m_svgStyle.get(),
+#endif
+    };
+    return StringHasher::hashMemory<sizeof(dataPointers)>(dataPointers);
+}
+
+template <typename T>
+static inline size_t dataMemoryUsage(const T* data, HashSet<const void*>& visited)
+{
+    return visited.add(data).isNewEntry ? sizeof(T) : 0;
+}
+
+size_t RenderStyle::memoryUsage(HashSet<const void*>& visited) const
+{
+    if (!visited.add(this).isNewEntry)
+        return 0;
+
+    size_t bytes = sizeof(RenderStyle);
+    bytes += dataMemoryUsage(m_box.get(), visited);
+    bytes += dataMemoryUsage(visual.get(), visited);
+    bytes += dataMemoryUsage(m_background.get(), visited);
+    bytes += dataMemoryUsage(surround.get(), visited);
+    bytes += dataMemoryUsage(rareNonInheritedData.get(), visited);
+    bytes += dataMemoryUsage(rareInheritedData.get(), visited);
+    bytes += dataMemoryUsage(inherited.get(), visited);
+#if ENABLE(SVG)
+    bytes += dataMemoryUsage(m_svgStyle.get(), visited);
+#endif
+    if (m_cachedPseudoStyles) {
+        for (size_t i = 0; i < m_cachedPseudoStyles->size(); ++i)
+            bytes += m_cachedPseudoStyles->at(i)->memoryUsage(visited);
+    }
+    return bytes;
+}
+
 static bool positionChangeIsMovementOnly(const LengthBox& a, const LengthBox& b, const Length& width)
 {
     // If any unit types are different, then we can't guarantee
@@ -747,6 +809,10 @@ StyleDifference RenderStyle::diff(const RenderStyle* other, unsigned& changedCon
 {
     changedContextSensitiveProperties = ContextSensitivePropertyNone;
 
+    // Interned styles and styles built from the matched properties cache often share all of their data.
+    if (this == other || allDataShared(other))
+        return StyleDifferenceEqual;
+
 #if ENABLE(SVG)
     StyleDifference svgChange = StyleDifferenceEqual;
     if (m_svgStyle != other->m_svgStyle) {
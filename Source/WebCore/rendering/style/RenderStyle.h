@@ -69,6 +69,7 @@
 #include "TransformOperations.h"
 #include "UnicodeBidi.h"
 #include <wtf/Forward.h>
+#include <wtf/HashSet.h>
 #include <wtf/OwnPtr.h>
 #include <wtf/RefCounted.h>
 #include <wtf/StdLibExtras.h>
@@ -268,6 +269,7 @@ protected:
         unsigned emptyState : 1;
         unsigned firstChildState : 1;
         unsigned lastChildState : 1;
+        unsigned isInterned : 1; // Shared by unrelated elements through StyleResolver::internStyle(), must not be modified.
 
         bool affectedByHover() const { return _affectedByHover; }
         void setAffectedByHover(bool value) { _affectedByHover = value; }
@@ -283,7 +285,7 @@ protected:
         unsigned _affectedByDrag : 1;
         unsigned _isLink : 1;
         // If you add more style bits here, you will also need to update RenderStyle::copyNonInheritedFrom()
-        // 59 bits
+        // 60 bits
     } noninherited_flags;
 
 // !END SYNC!
@@ -332,6 +334,7 @@ protected:
         noninherited_flags.emptyState = false;
         noninherited_flags.firstChildState = false;
         noninherited_flags.lastChildState = false;
+        noninherited_flags.isInterned = false;
         noninherited_flags.setAffectedByHover(false);
         noninherited_flags.setAffectedByActive(false);
         noninherited_flags.setAffectedByDrag(false);
@@ -828,6 +831,7 @@ public:
         return axis == AutoColumnAxis || isHorizontalWritingMode() == (axis == HorizontalColumnAxis);
     }
     ColumnProgression columnProgression() const { return static_cast<ColumnProgression>(rareNonInheritedData->m_multiCol->m_progression); }
+    ContentVisibility contentVisibility() const { return static_cast<ContentVisibility>(rareNonInheritedData->m_contentVisibility); }
     float columnWidth() const { return rareNonInheritedData->m_multiCol->m_width; }
     bool hasAutoColumnWidth() const { return rareNonInheritedData->m_multiCol->m_autoWidth; }
     unsigned short columnCount() const { return rareNonInheritedData->m_multiCol->m_count; }
@@ -1330,6 +1334,7 @@ public:
     void setResize(EResize r) { SET_VAR(rareInheritedData, resize, r); }
     void setColumnAxis(ColumnAxis axis) { SET_VAR(rareNonInheritedData.access()->m_multiCol, m_axis, axis); }
     void setColumnProgression(ColumnProgression progression) { SET_VAR(rareNonInheritedData.access()->m_multiCol, m_progression, progression); }
+    void setContentVisibility(ContentVisibility contentVisibility) { SET_VAR(rareNonInheritedData, m_contentVisibility, contentVisibility); }
     void setColumnWidth(float f) { SET_VAR(rareNonInheritedData.access()->m_multiCol, m_autoWidth, false); SET_VAR(rareNonInheritedData.access()->m_multiCol, m_width, f); }
     void setHasAutoColumnWidth() { SET_VAR(rareNonInheritedData.access()->m_multiCol, m_autoWidth, true); SET_VAR(rareNonInheritedData.access()->m_multiCol, m_width, 0); }
     void setColumnCount(unsigned short c) { SET_VAR(rareNonInheritedData.access()->m_multiCol, m_autoCount, false); SET_VAR(rareNonInheritedData.access()->m_multiCol, m_count, c); }
@@ -1528,6 +1533,11 @@ public:
 
     bool inheritedNotEqual(const RenderStyle*) const;
     bool inheritedDataShared(const RenderStyle*) const;
+    bool allDataShared(const RenderStyle*) const;
+    unsigned hashForDataSharing() const;
+
+    // Returns the bytes used by this style and its data groups, skipping anything already in |visited|.
+    size_t memoryUsage(HashSet<const void*>& visited) const;
 
     StyleDifference diff(const RenderStyle*, unsigned& changedContextSensitiveProperties) const;
     bool diffRequiresRepaint(const RenderStyle*) const;
@@ -1564,6 +1574,12 @@ public:
 
     Color visitedDependentColor(int colorProperty) const;
 
+    // Interned styles are shared between elements that may have different parents, so state recorded
+    // for one element (cached pseudo styles, structural pseudo-class state, flags set by children)
+    // has to go to a private copy. See RenderObject::uninternedStyle().
+    bool isInterned() const { return noninherited_flags.isInterned; }
+    void setIsInterned() { noninherited_flags.isInterned = true; }
+
     void setHasExplicitlyInheritedProperties() { noninherited_flags.explicitInheritance = true; }
     bool hasExplicitlyInheritedProperties() const { return noninherited_flags.explicitInheritance; }
     
@@ -1578,6 +1594,7 @@ public:
     static ColorSpace initialColorSpace() { return ColorSpaceDeviceRGB; }
     static ColumnAxis initialColumnAxis() { return AutoColumnAxis; }
     static ColumnProgression initialColumnProgression() { return NormalColumnProgression; }
+    static ContentVisibility initialContentVisibility() { return ContentVisibilityVisible; }
     static TextDirection initialDirection() { return LTR; }
     static WritingMode initialWritingMode() { return TopToBottomWritingMode; }
     static TextCombine initialTextCombine() { return TextCombineNone; }
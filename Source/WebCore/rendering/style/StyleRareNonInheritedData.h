@@ -192,6 +192,7 @@ public:
 #endif
 
     unsigned m_hasAspectRatio : 1; // Whether or not an aspect ratio has been specified.
+    unsigned m_contentVisibility : 1; // ContentVisibility
 
 #if ENABLE(CSS_COMPOSITING)
     unsigned m_effectiveBlendMode: 5; // EBlendMode
@@ -618,7 +618,7 @@ void SVGInlineTextBox::paintTextWithShadows(GraphicsContext* context, RenderStyl
         context->save();
         context->scale(FloatSize(1 / scalingFactor, 1 / scalingFactor));
 
-        scaledFont.drawText(context, textRun, textOrigin + extraOffset, startPosition, endPosition);
+        context->drawText(scaledFont, textRun, textOrigin + extraOffset, startPosition, endPosition);
 
         context->restore();
 
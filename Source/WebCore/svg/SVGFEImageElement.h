@@ -39,6 +39,10 @@ class SVGFEImageElement FINAL : public SVGFilterPrimitiveStandardAttributes,
                                 public SVGExternalResourcesRequired,
                                 public CachedImageClient {
 public:
+    // CachedResourceClient is fast allocated too; nodes must go through Node's allocator.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<SVGFEImageElement> create(const QualifiedName&, Document*);
 
     virtual ~SVGFEImageElement();
@@ -31,6 +31,10 @@ class CSSFontFaceSrcValue;
 
 class SVGFontFaceUriElement FINAL : public SVGElement, public CachedFontClient {
 public:
+    // CachedResourceClient is fast allocated too; nodes must go through Node's allocator.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<SVGFontFaceUriElement> create(const QualifiedName&, Document*);
 
     virtual ~SVGFontFaceUriElement();
@@ -37,6 +37,10 @@ class SVGScriptElement FINAL : public SVGElement
                              , public SVGExternalResourcesRequired
                              , public ScriptElement {
 public:
+    // ScriptElement is fast allocated too; nodes must go through Node's allocator.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<SVGScriptElement> create(const QualifiedName&, Document*, bool wasInsertedByParser);
 
     String type() const;
@@ -97,6 +97,7 @@
 #include "TreeScope.h"
 #include "TypeConversions.h"
 #include "ViewportArguments.h"
+#include "WidthCache.h"
 #include "WorkerThread.h"
 #include <wtf/text/CString.h>
 #include <wtf/text/StringBuffer.h>
@@ -1615,6 +1616,26 @@ unsigned Internals::numberOfScrollableAreas(Document* document, ExceptionCode&)
     return count;
 }
     
+unsigned Internals::styleMemoryUsage(Document* document, ExceptionCode& ec)
+{
+    if (!document) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->styleMemoryUsage();
+}
+
+unsigned Internals::widthCacheHitCount() const
+{
+    return WidthCache::shared().statistics().hits;
+}
+
+unsigned Internals::widthCacheMissCount() const
+{
+    return WidthCache::shared().statistics().misses;
+}
+
 bool Internals::isPageBoxVisible(Document* document, int pageNumber, ExceptionCode& ec)
 {
     if (!document) {
@@ -1736,6 +1757,16 @@ void Internals::insertUserCSS(Document* document, const String& css) const
     document->styleSheetCollection()->addUserSheet(parsedSheet);
 }
 
+unsigned Internals::numberOfNodeArenaAllocations() const
+{
+    return NodeArena::arenaAllocationCount();
+}
+
+unsigned Internals::numberOfMallocNodeAllocations() const
+{
+    return NodeArena::mallocAllocationCount();
+}
+
 String Internals::counterValue(Element* element)
 {
     if (!element)
@@ -203,6 +203,9 @@ public:
     void toggleOverwriteModeEnabled(Document*, ExceptionCode&);
 
     unsigned numberOfScrollableAreas(Document*, ExceptionCode&);
+    unsigned styleMemoryUsage(Document*, ExceptionCode&);
+    unsigned widthCacheHitCount() const;
+    unsigned widthCacheMissCount() const;
 
     bool isPageBoxVisible(Document*, int pageNumber, ExceptionCode&);
 
@@ -238,6 +241,9 @@ public:
     void insertAuthorCSS(Document*, const String&) const;
     void insertUserCSS(Document*, const String&) const;
 
+    unsigned numberOfNodeArenaAllocations() const;
+    unsigned numberOfMallocNodeAllocations() const;
+
 #if ENABLE(INSPECTOR)
     unsigned numberOfLiveNodes() const;
     unsigned numberOfLiveDocuments() const;
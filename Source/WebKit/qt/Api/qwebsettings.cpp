@@ -100,6 +100,15 @@ public:
 
 Q_GLOBAL_STATIC(QList<QWebSettingsPrivate*>, allSettings);
 
+#if ENABLE(THREADED_HTML_PARSER)
+static bool threadedHTMLParserDisabledByEnvironment()
+{
+    // Tokenize on the HTML parser thread unless explicitly asked not to, e.g. for comparing against the synchronous parser.
+    static const bool disabled = qgetenv("QTWEBKIT_DISABLE_THREADED_HTML_PARSER") == "1";
+    return disabled;
+}
+#endif
+
 void QWebSettingsPrivate::apply()
 {
     if (settings) {
@@ -603,6 +612,10 @@ QWebSettings::QWebSettings()
 QWebSettings::QWebSettings(WebCore::Settings* settings, WebCore::GroupSettings* groupSettings)
     : d(new QWebSettingsPrivate(settings, groupSettings))
 {
+#if ENABLE(THREADED_HTML_PARSER)
+    // Only a default for the page: apply() runs on every settings change and must not undo a per-page override.
+    settings->setThreadedHTMLParser(!threadedHTMLParserDisabledByEnvironment());
+#endif
     d->apply();
     allSettings()->append(d);
 }
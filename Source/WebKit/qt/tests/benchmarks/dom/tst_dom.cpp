@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <qwebframe.h>
+#include <qwebpage.h>
+
+#include "util.h"
+
+// Builds and tears down large DOM trees from script, so that node allocation and per-element data
+// dominate. Compare runs before and after a change to the DOM's memory layout.
+class tst_Dom : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void init();
+    void cleanup();
+
+private Q_SLOTS:
+    void buildElements_data();
+    void buildElements();
+    void parseAndTearDown();
+
+private:
+    QWebPage* m_page;
+};
+
+void tst_Dom::init()
+{
+    m_page = new QWebPage;
+    m_page->setViewportSize(QSize(1024, 768));
+    m_page->mainFrame()->setHtml(QLatin1String("<!DOCTYPE html><html><body><div id=\"container\"></div></body></html>"));
+    ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+}
+
+void tst_Dom::cleanup()
+{
+    delete m_page;
+}
+
+void tst_Dom::buildElements_data()
+{
+    QTest::addColumn<QString>("script");
+
+    // Every element gets the same attributes, so all of them can share one attribute data.
+    QTest::newRow("setAttribute") << QString::fromLatin1(
+        "var container = document.getElementById('container');"
+        "for (var i = 0; i < 20000; ++i) {"
+        "    var span = document.createElement('span');"
+        "    span.setAttribute('class', 'cell');"
+        "    span.setAttribute('title', 'cell');"
+        "    container.appendChild(span);"
+        "}");
+    QTest::newRow("cloneNode") << QString::fromLatin1(
+        "var container = document.getElementById('container');"
+        "var prototype = document.createElement('span');"
+        "prototype.setAttribute('class', 'cell');"
+        "prototype.setAttribute('title', 'cell');"
+        "for (var i = 0; i < 20000; ++i)"
+        "    container.appendChild(prototype.cloneNode(false));");
+    QTest::newRow("innerHTML") << QString::fromLatin1(
+        "var container = document.getElementById('container');"
+        "container.innerHTML = new Array(20001).join('<span class=\"cell\" title=\"cell\"></span>');");
+}
+
+void tst_Dom::buildElements()
+{
+    QFETCH(QString, script);
+
+    QWebFrame* frame = m_page->mainFrame();
+    QBENCHMARK {
+        frame->evaluateJavaScript(script);
+        frame->evaluateJavaScript(QLatin1String("document.getElementById('container').textContent = '';"));
+    }
+}
+
+// Parser-created nodes come from the document's NodeArena, so this covers both bump allocation
+// during parsing and handing the nodes back when the document goes away.
+void tst_Dom::parseAndTearDown()
+{
+    QString html = QLatin1String("<!DOCTYPE html><html><body><table>");
+    for (int i = 0; i < 5000; ++i)
+        html += QString::fromLatin1("<tr><td class=\"c\">%1</td><td><b>bold</b> text</td><td><a href=\"#%1\">link</a></td></tr>").arg(i);
+    html += QLatin1String("</table></body></html>");
+
+    QWebFrame* frame = m_page->mainFrame();
+    QBENCHMARK {
+        frame->setHtml(html);
+        ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+        frame->setHtml(QString());
+        ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+    }
+}
+
+QTEST_MAIN(tst_Dom)
+#include "tst_dom.moc"
@@ -44,6 +44,7 @@ private Q_SLOTS:
     void paint_data();
     void paint();
     void textAreas();
+    void zIndexChurn();
 
 private:
 #ifndef QT_NO_BEARERMANAGEMENT
@@ -123,5 +124,39 @@ void tst_Painting::textAreas()
     }
 }
 
+void tst_Painting::zIndexChurn()
+{
+    m_view->load(QUrl("data:text/html;<html><body></body></html>"));
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    QWebFrame* mainFrame = m_page->mainFrame();
+    mainFrame->evaluateJavaScript(
+        "var layers = [];"
+        "for (var i = 0; i < 2000; ++i) {"
+        "    var div = document.createElement('div');"
+        "    div.style.cssText = 'position: absolute; width: 40px; height: 40px; background-color: rgb(' + (i % 256) + ', 0, 0);'"
+        "        + 'left: ' + (i * 7 % 980) + 'px; top: ' + (i * 13 % 720) + 'px; z-index: ' + (i % 50) + ';';"
+        "    document.body.appendChild(div);"
+        "    layers.push(div);"
+        "}"
+        "var step = 0;");
+
+    /* force a layout */
+    mainFrame->toPlainText();
+
+    // Each iteration changes the z-index of a tenth of the layers, including sign flips, so that the
+    // stacking context's z-order lists are updated incrementally and then used to paint.
+    QPixmap pixmap(m_page->viewportSize());
+    QBENCHMARK {
+        mainFrame->evaluateJavaScript(
+            "++step;"
+            "for (var i = step % 10; i < layers.length; i += 10)"
+            "    layers[i].style.zIndex = ((i + step) % 100) - 50;");
+        QPainter painter(&pixmap);
+        mainFrame->render(&painter, QRect(QPoint(0, 0), m_page->viewportSize()));
+        painter.end();
+    }
+}
+
 QTEST_MAIN(tst_Painting)
 #include "tst_painting.moc"
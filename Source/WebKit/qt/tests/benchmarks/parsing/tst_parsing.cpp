@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <qwebframe.h>
+#include <qwebpage.h>
+
+#include "util.h"
+
+// Parses generated documents from memory, so that only the parser and the work it schedules are measured.
+// Run once as is and once with QTWEBKIT_DISABLE_THREADED_HTML_PARSER=1 to compare the threaded parser
+// against the synchronous one. Besides the total load time, firstPaint() reports how long it takes until
+// the page first asks to be painted and mainThreadBusy() the longest time the event loop was blocked.
+class tst_Parsing : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void init();
+    void cleanup();
+
+private Q_SLOTS:
+    void parse_data();
+    void parse();
+    void firstPaint_data();
+    void firstPaint();
+    void mainThreadBusy_data();
+    void mainThreadBusy();
+
+private:
+    QWebPage* m_page;
+};
+
+// Watches one load: when the page first requests a repaint, and the longest gap between two turns of
+// the event loop, which is the longest stretch the main thread was busy without processing events.
+class LoadObserver : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LoadObserver(QWebPage* page)
+        : m_firstPaint(-1)
+        , m_lastTick(0)
+        , m_longestBusy(0)
+    {
+        connect(page, SIGNAL(repaintRequested(QRect)), this, SLOT(repaintRequested()));
+        connect(&m_ticker, SIGNAL(timeout()), this, SLOT(tick()));
+        m_ticker.setInterval(0);
+    }
+
+    void start()
+    {
+        m_firstPaint = -1;
+        m_lastTick = 0;
+        m_longestBusy = 0;
+        m_clock.start();
+        m_ticker.start();
+    }
+
+    void stop()
+    {
+        m_ticker.stop();
+        tick();
+    }
+
+    qint64 firstPaint() const { return m_firstPaint; }
+    qint64 longestBusy() const { return m_longestBusy; }
+
+private Q_SLOTS:
+    void repaintRequested()
+    {
+        if (m_firstPaint < 0)
+            m_firstPaint = m_clock.elapsed();
+    }
+
+    void tick()
+    {
+        qint64 now = m_clock.elapsed();
+        m_longestBusy = qMax(m_longestBusy, now - m_lastTick);
+        m_lastTick = now;
+    }
+
+private:
+    QElapsedTimer m_clock;
+    QTimer m_ticker;
+    qint64 m_firstPaint;
+    qint64 m_lastTick;
+    qint64 m_longestBusy;
+};
+
+static QString generateDocument(int paragraphs, int paragraphsPerScript, bool documentWrite)
+{
+    QString html = QLatin1String("<!DOCTYPE html><html><body>");
+    for (int i = 0; i < paragraphs; ++i) {
+        html += QString::fromLatin1("<p class=\"p%1\">Paragraph %1 with <b>some</b> <i>inline</i> <a href=\"#%1\">markup</a>.</p>").arg(i);
+        if (paragraphsPerScript && !(i % paragraphsPerScript)) {
+            if (documentWrite)
+                html += QString::fromLatin1("<script>document.write('<span>written %1</span>');</script>").arg(i);
+            else
+                html += QString::fromLatin1("<script>var x%1 = %1;</script>").arg(i);
+        }
+    }
+    html += QLatin1String("</body></html>");
+    return html;
+}
+
+void tst_Parsing::init()
+{
+    m_page = new QWebPage;
+    m_page->setViewportSize(QSize(1024, 768));
+}
+
+void tst_Parsing::cleanup()
+{
+    delete m_page;
+}
+
+void tst_Parsing::parse_data()
+{
+    QTest::addColumn<QString>("html");
+    QTest::newRow("markup") << generateDocument(20000, 0, false);
+    QTest::newRow("inline-scripts") << generateDocument(20000, 50, false);
+    QTest::newRow("document-write") << generateDocument(20000, 50, true);
+}
+
+void tst_Parsing::parse()
+{
+    QFETCH(QString, html);
+
+    QBENCHMARK {
+        m_page->mainFrame()->setHtml(html);
+        ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+    }
+}
+
+void tst_Parsing::firstPaint_data()
+{
+    parse_data();
+}
+
+void tst_Parsing::firstPaint()
+{
+    QFETCH(QString, html);
+
+    LoadObserver observer(m_page);
+    observer.start();
+    m_page->mainFrame()->setHtml(html);
+    ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+    observer.stop();
+
+    QVERIFY(observer.firstPaint() >= 0);
+    QTest::setBenchmarkResult(observer.firstPaint(), QTest::WalltimeMilliseconds);
+}
+
+void tst_Parsing::mainThreadBusy_data()
+{
+    parse_data();
+}
+
+void tst_Parsing::mainThreadBusy()
+{
+    QFETCH(QString, html);
+
+    LoadObserver observer(m_page);
+    observer.start();
+    m_page->mainFrame()->setHtml(html);
+    ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+    observer.stop();
+
+    QTest::setBenchmarkResult(observer.longestBusy(), QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(tst_Parsing)
+#include "tst_parsing.moc"
@@ -38,6 +38,10 @@
 #include <wtf/CurrentTime.h>
 #include <wtf/text/WTFString.h>
 
+#if USE(COORDINATED_GRAPHICS)
+#include <WebCore/CoordinatedSurfacePool.h>
+#endif
+
 using namespace WebCore;
 using namespace JSC;
 using namespace WTF;
@@ -169,6 +173,16 @@ WebMemoryStatistics WebMemorySampler::sampleWebKit() const
     appendKeyValuePair(webKitMemoryStats, ASCIILiteral("JavaScript Stack Bytes"), globalMemoryStats.stackBytes);
     appendKeyValuePair(webKitMemoryStats, ASCIILiteral("JavaScript JIT Bytes"), globalMemoryStats.JITBytes);
 
+#if USE(COORDINATED_GRAPHICS)
+    const CoordinatedSurfacePool::Statistics& surfacePoolStats = CoordinatedSurfacePool::sharedPool()->statistics();
+    appendKeyValuePair(webKitMemoryStats, ASCIILiteral("Coordinated Surface Pool Capacity"), CoordinatedSurfacePool::sharedPool()->capacity());
+    appendKeyValuePair(webKitMemoryStats, ASCIILiteral("Coordinated Surface Pool Idle Bytes"), surfacePoolStats.idleBytes);
+    appendKeyValuePair(webKitMemoryStats, ASCIILiteral("Coordinated Surface Pool Idle Surfaces"), surfacePoolStats.idleSurfaces);
+    appendKeyValuePair(webKitMemoryStats, ASCIILiteral("Coordinated Surfaces Reused"), surfacePoolStats.reusedSurfaces);
+    appendKeyValuePair(webKitMemoryStats, ASCIILiteral("Coordinated Surfaces Created"), surfacePoolStats.createdSurfaces);
+    appendKeyValuePair(webKitMemoryStats, ASCIILiteral("Coordinated Surfaces Evicted"), surfacePoolStats.evictedSurfaces);
+#endif
+
     appendKeyValuePair(webKitMemoryStats, ASCIILiteral("Total Memory In Use"), totalBytesInUse);
     appendKeyValuePair(webKitMemoryStats, ASCIILiteral("Total Committed Memory"), totalBytesCommitted);
 
@@ -32,7 +32,9 @@ linux-* {
 # Benchmarks
 SUBDIRS += \
     $$WEBKIT_TESTS_DIR/benchmarks/painting \
-    $$WEBKIT_TESTS_DIR/benchmarks/loading
+    $$WEBKIT_TESTS_DIR/benchmarks/loading \
+    $$WEBKIT_TESTS_DIR/benchmarks/parsing \
+    $$WEBKIT_TESTS_DIR/benchmarks/dom
 
 # WebGL performance tests are disabled temporarily.
 # https://bugs.webkit.org/show_bug.cgi?id=80503
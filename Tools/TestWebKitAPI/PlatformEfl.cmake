@@ -48,8 +48,12 @@ set(webkit2_api_harness_SOURCES
 # Release builds before adding it to test_{webkit2_api|webcore}_BINARIES.
 
 set(test_webcore_BINARIES
+    CoordinatedSurfacePool
+    DisplayList
+    FilterKernels
     LayoutUnit
     KURL
+    TextureMapperSoftwareCompositor
 )
 
 # In here we list the bundles that are used by our specific WK2 API Tests
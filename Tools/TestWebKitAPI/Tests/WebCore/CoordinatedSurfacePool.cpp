@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if USE(COORDINATED_GRAPHICS)
+
+#include <WebCore/CoordinatedSurfacePool.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+class TestSurface : public CoordinatedSurface {
+public:
+    static PassRefPtr<CoordinatedSurface> create(const IntSize& size, Flags flags)
+    {
+        return adoptRef(new TestSurface(size, flags));
+    }
+
+    virtual void paintToSurface(const IntRect&, Client*) { }
+#if USE(TEXTURE_MAPPER)
+    virtual void copyToTexture(PassRefPtr<BitmapTexture>, const IntRect&, const IntPoint&) { }
+#endif
+
+private:
+    TestSurface(const IntSize& size, Flags flags)
+        : CoordinatedSurface(size, flags)
+    {
+    }
+};
+
+// Every test runs against an empty shared pool with a known capacity and restores the default afterwards.
+class PoolScope {
+public:
+    explicit PoolScope(size_t capacity)
+        : m_pool(CoordinatedSurfacePool::sharedPool())
+        , m_oldCapacity(m_pool->capacity())
+    {
+        CoordinatedSurface::setFactory(TestSurface::create);
+        m_pool->drain();
+        m_pool->setCapacity(capacity);
+        m_statistics = m_pool->statistics();
+    }
+
+    ~PoolScope()
+    {
+        m_pool->drain();
+        m_pool->setCapacity(m_oldCapacity);
+    }
+
+    CoordinatedSurfacePool* pool() const { return m_pool; }
+    unsigned reused() const { return m_pool->statistics().reusedSurfaces - m_statistics.reusedSurfaces; }
+    unsigned created() const { return m_pool->statistics().createdSurfaces - m_statistics.createdSurfaces; }
+    unsigned evicted() const { return m_pool->statistics().evictedSurfaces - m_statistics.evictedSurfaces; }
+
+private:
+    CoordinatedSurfacePool* m_pool;
+    size_t m_oldCapacity;
+    CoordinatedSurfacePool::Statistics m_statistics;
+};
+
+static const size_t bytesPerSurface = 32 * 32 * 4;
+
+TEST(WebCoreCoordinatedSurfacePool, ReusesIdleSurfaceOfSameSizeAndFlags)
+{
+    PoolScope scope(4 * bytesPerSurface);
+    CoordinatedSurfacePool* pool = scope.pool();
+
+    RefPtr<CoordinatedSurface> surface = pool->takeSurface(IntSize(32, 32), CoordinatedSurface::SupportsAlpha);
+    CoordinatedSurface* rawSurface = surface.get();
+    pool->addSurface(surface.release());
+    EXPECT_EQ(1u, pool->statistics().idleSurfaces);
+    EXPECT_EQ(bytesPerSurface, pool->statistics().idleBytes);
+
+    // A surface without alpha can not stand in for one with alpha.
+    RefPtr<CoordinatedSurface> opaqueSurface = pool->takeSurface(IntSize(32, 32), CoordinatedSurface::NoFlags);
+    EXPECT_NE(rawSurface, opaqueSurface.get());
+    EXPECT_EQ(0u, scope.reused());
+
+    RefPtr<CoordinatedSurface> reusedSurface = pool->takeSurface(IntSize(32, 32), CoordinatedSurface::SupportsAlpha);
+    EXPECT_EQ(rawSurface, reusedSurface.get());
+    EXPECT_EQ(1u, scope.reused());
+    EXPECT_EQ(2u, scope.created());
+    EXPECT_EQ(0u, pool->statistics().idleSurfaces);
+    EXPECT_EQ(0u, pool->statistics().idleBytes);
+}
+
+TEST(WebCoreCoordinatedSurfacePool, DoesNotKeepHeldOrOversizedSurfaces)
+{
+    PoolScope scope(bytesPerSurface);
+    CoordinatedSurfacePool* pool = scope.pool();
+
+    RefPtr<CoordinatedSurface> heldSurface = pool->takeSurface(IntSize(32, 32), CoordinatedSurface::SupportsAlpha);
+    pool->addSurface(heldSurface);
+    EXPECT_EQ(0u, pool->statistics().idleSurfaces);
+
+    pool->addSurface(pool->takeSurface(IntSize(64, 64), CoordinatedSurface::SupportsAlpha));
+    EXPECT_EQ(0u, pool->statistics().idleSurfaces);
+    EXPECT_EQ(0u, pool->statistics().idleBytes);
+}
+
+TEST(WebCoreCoordinatedSurfacePool, EvictsLeastRecentlyUsedSizeFirst)
+{
+    PoolScope scope(3 * bytesPerSurface);
+    CoordinatedSurfacePool* pool = scope.pool();
+
+    // Three sizes with the same number of bytes, so only the order of use decides what is evicted.
+    IntSize square(32, 32);
+    IntSize tall(16, 64);
+    IntSize wide(64, 16);
+
+    pool->addSurface(pool->takeSurface(square, CoordinatedSurface::SupportsAlpha));
+    pool->addSurface(pool->takeSurface(tall, CoordinatedSurface::SupportsAlpha));
+    pool->addSurface(pool->takeSurface(wide, CoordinatedSurface::SupportsAlpha));
+    EXPECT_EQ(3u, pool->statistics().idleSurfaces);
+    EXPECT_EQ(0u, scope.evicted());
+
+    // Adding another square surface makes that size the most recently used one, so the tall one goes.
+    pool->addSurface(TestSurface::create(square, CoordinatedSurface::SupportsAlpha));
+    EXPECT_EQ(3u, pool->statistics().idleSurfaces);
+    EXPECT_EQ(3 * bytesPerSurface, pool->statistics().idleBytes);
+    EXPECT_EQ(1u, scope.evicted());
+
+    unsigned created = scope.created();
+    RefPtr<CoordinatedSurface> tallSurface = pool->takeSurface(tall, CoordinatedSurface::SupportsAlpha);
+    EXPECT_EQ(created + 1, scope.created());
+    RefPtr<CoordinatedSurface> wideSurface = pool->takeSurface(wide, CoordinatedSurface::SupportsAlpha);
+    RefPtr<CoordinatedSurface> squareSurface = pool->takeSurface(square, CoordinatedSurface::SupportsAlpha);
+    RefPtr<CoordinatedSurface> secondSquareSurface = pool->takeSurface(square, CoordinatedSurface::SupportsAlpha);
+    EXPECT_EQ(3u, scope.reused());
+    EXPECT_EQ(created + 1, scope.created());
+    EXPECT_EQ(0u, pool->statistics().idleSurfaces);
+}
+
+TEST(WebCoreCoordinatedSurfacePool, ShrinkingCapacityEvictsOldestSurfaces)
+{
+    PoolScope scope(4 * bytesPerSurface);
+    CoordinatedSurfacePool* pool = scope.pool();
+
+    RefPtr<CoordinatedSurface> first = pool->takeSurface(IntSize(32, 32), CoordinatedSurface::SupportsAlpha);
+    RefPtr<CoordinatedSurface> second = pool->takeSurface(IntSize(32, 32), CoordinatedSurface::SupportsAlpha);
+    CoordinatedSurface* rawSecond = second.get();
+    pool->addSurface(first.release());
+    pool->addSurface(second.release());
+    EXPECT_EQ(2u, pool->statistics().idleSurfaces);
+
+    // Within a size the surface that has been idle longest is dropped first.
+    pool->setCapacity(bytesPerSurface);
+    EXPECT_EQ(1u, pool->statistics().idleSurfaces);
+    EXPECT_EQ(1u, scope.evicted());
+    RefPtr<CoordinatedSurface> kept = pool->takeSurface(IntSize(32, 32), CoordinatedSurface::SupportsAlpha);
+    EXPECT_EQ(rawSecond, kept.get());
+}
+
+} // namespace TestWebKitAPI
+
+#endif // USE(COORDINATED_GRAPHICS)
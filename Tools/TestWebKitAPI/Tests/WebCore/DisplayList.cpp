@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <WebCore/Color.h>
+#include <WebCore/DisplayList.h>
+#include <WebCore/GraphicsContext.h>
+#include <WebCore/ImageBuffer.h>
+#include <WebCore/Path.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/Uint8ClampedArray.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+static const int sceneWidth = 96;
+static const int sceneHeight = 80;
+
+// Exercises state, transforms, clips, transparency layers and shadows, with drawings that
+// straddle the tile boundaries used below.
+static void paintScene(GraphicsContext& context)
+{
+    context.fillRect(FloatRect(0, 0, sceneWidth, sceneHeight), Color(255, 255, 255), ColorSpaceDeviceRGB);
+
+    context.setFillColor(Color(200, 30, 30), ColorSpaceDeviceRGB);
+    context.fillRect(FloatRect(10, 6, 50, 20));
+
+    context.setStrokeColor(Color(20, 20, 160), ColorSpaceDeviceRGB);
+    context.setStrokeThickness(3);
+    context.strokeRect(FloatRect(28.5, 18.5, 40, 30), 3);
+    context.drawLine(IntPoint(2, 70), IntPoint(90, 40));
+
+    GraphicsContextStateSaver stateSaver(context);
+    context.translate(48, 40);
+    context.rotate(0.3f);
+    context.clip(FloatRect(-30, -20, 55, 45));
+    Path ellipse;
+    ellipse.addEllipse(FloatRect(-25, -15, 50, 30));
+    context.setFillColor(Color(30, 160, 60), ColorSpaceDeviceRGB);
+    context.fillPath(ellipse);
+
+    context.beginTransparencyLayer(0.5);
+    context.setShadow(FloatSize(3, 3), 2, Color(0, 0, 0, 128), ColorSpaceDeviceRGB);
+    context.fillRoundedRect(IntRect(-10, -5, 30, 20), IntSize(4, 4), IntSize(4, 4), IntSize(4, 4), IntSize(4, 4), Color(250, 200, 0), ColorSpaceDeviceRGB);
+    context.clearShadow();
+    context.endTransparencyLayer();
+}
+
+static RefPtr<Uint8ClampedArray> pixels(const ImageBuffer& buffer)
+{
+    return buffer.getPremultipliedImageData(IntRect(0, 0, sceneWidth, sceneHeight));
+}
+
+static void expectSamePixels(const ImageBuffer& expected, const ImageBuffer& actual)
+{
+    RefPtr<Uint8ClampedArray> expectedPixels = pixels(expected);
+    RefPtr<Uint8ClampedArray> actualPixels = pixels(actual);
+    ASSERT_EQ(expectedPixels->length(), actualPixels->length());
+
+    unsigned differentBytes = 0;
+    for (unsigned i = 0; i < expectedPixels->length(); ++i) {
+        if (expectedPixels->item(i) != actualPixels->item(i))
+            ++differentBytes;
+    }
+    EXPECT_EQ(0u, differentBytes);
+}
+
+static PassOwnPtr<DisplayList> recordScene()
+{
+    DisplayListRecorder recorder(FloatRect(0, 0, sceneWidth, sceneHeight));
+    paintScene(*recorder.context());
+    return recorder.finishRecording();
+}
+
+static PassOwnPtr<ImageBuffer> paintDirectly()
+{
+    OwnPtr<ImageBuffer> buffer = ImageBuffer::create(IntSize(sceneWidth, sceneHeight));
+    paintScene(*buffer->context());
+    return buffer.release();
+}
+
+TEST(WebCoreDisplayList, ReplayMatchesDirectPainting)
+{
+    OwnPtr<DisplayList> displayList = recordScene();
+    ASSERT_TRUE(displayList);
+
+    OwnPtr<ImageBuffer> replayed = ImageBuffer::create(IntSize(sceneWidth, sceneHeight));
+    displayList->replay(*replayed->context());
+
+    expectSamePixels(*paintDirectly(), *replayed);
+}
+
+TEST(WebCoreDisplayList, CulledTileReplayMatchesDirectPainting)
+{
+    OwnPtr<DisplayList> displayList = recordScene();
+    ASSERT_TRUE(displayList);
+
+    // Each tile replays only the items that reach it, clipped the way CoordinatedGraphicsLayer does.
+    static const int tileSize = 32;
+    OwnPtr<ImageBuffer> replayed = ImageBuffer::create(IntSize(sceneWidth, sceneHeight));
+    GraphicsContext& context = *replayed->context();
+    for (int y = 0; y < sceneHeight; y += tileSize) {
+        for (int x = 0; x < sceneWidth; x += tileSize) {
+            IntRect tile(x, y, tileSize, tileSize);
+            GraphicsContextStateSaver stateSaver(context);
+            context.clip(tile);
+            displayList->replay(context, tile);
+        }
+    }
+
+    expectSamePixels(*paintDirectly(), *replayed);
+}
+
+TEST(WebCoreDisplayList, ScaledReplayMatchesScaledDirectPainting)
+{
+    // Recording for a scaled backing store, as CoordinatedGraphicsLayer does for contents scale.
+    AffineTransform baseCTM;
+    baseCTM.scale(2);
+    DisplayListRecorder recorder(FloatRect(0, 0, sceneWidth / 2, sceneHeight / 2), baseCTM);
+    paintScene(*recorder.context());
+    OwnPtr<DisplayList> displayList = recorder.finishRecording();
+    ASSERT_TRUE(displayList);
+
+    OwnPtr<ImageBuffer> direct = ImageBuffer::create(IntSize(sceneWidth, sceneHeight));
+    direct->context()->scale(FloatSize(2, 2));
+    paintScene(*direct->context());
+
+    OwnPtr<ImageBuffer> replayed = ImageBuffer::create(IntSize(sceneWidth, sceneHeight));
+    replayed->context()->scale(FloatSize(2, 2));
+    displayList->replay(*replayed->context());
+
+    expectSamePixels(*direct, *replayed);
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(FILTERS)
+
+#include <WebCore/FEColorMatrix.h>
+#include <WebCore/FEComposite.h>
+#include <WebCore/FEGaussianBlur.h>
+#include <stdio.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/Uint8ClampedArray.h>
+#include <wtf/Vector.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+// A fixed linear congruential generator, so that failures are reproducible.
+class RandomGenerator {
+public:
+    RandomGenerator()
+        : m_state(0x2545f491)
+    {
+    }
+
+    unsigned next()
+    {
+        m_state = m_state * 1664525 + 1013904223;
+        return m_state >> 8;
+    }
+
+    unsigned next(unsigned limit) { return next() % limit; }
+    float nextFloat(float minimum, float maximum) { return minimum + (maximum - minimum) * (next() & 0xffff) / 0xffff; }
+
+    void fill(unsigned char* data, unsigned length)
+    {
+        for (unsigned i = 0; i < length; ++i)
+            data[i] = next();
+    }
+
+private:
+    unsigned m_state;
+};
+
+static bool sameBytes(const unsigned char* a, const unsigned char* b, unsigned length)
+{
+    return !memcmp(a, b, length);
+}
+
+// The SSE2 kernels are bit-exact with the scalar code. The NEON ones multiply by reciprocals and
+// round differently, so they are not compared here.
+#if defined(__SSE2__)
+
+TEST(WebCoreFilterKernels, BoxBlurSIMDMatchesScalar)
+{
+    RandomGenerator random;
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        int width = 1 + random.next(80);
+        int height = 1 + random.next(80);
+        unsigned length = width * height * 4;
+        RefPtr<Uint8ClampedArray> source = Uint8ClampedArray::createUninitialized(length);
+        RefPtr<Uint8ClampedArray> expected = Uint8ClampedArray::createUninitialized(length);
+        RefPtr<Uint8ClampedArray> actual = Uint8ClampedArray::createUninitialized(length);
+        random.fill(source->data(), length);
+
+        // Kernels wider than the image and lopsided kernels take the edge cases of the sliding window.
+        unsigned dx = 1 + random.next(500);
+        int dxLeft = random.next(2) ? dx / 2 : random.next(dx + 1);
+        int dxRight = dx - dxLeft;
+
+        if (random.next(2)) {
+            FEGaussianBlur::boxBlur(source.get(), expected.get(), dx, dxLeft, dxRight, 4, 4 * width, width, height, false, false);
+            FEGaussianBlur::boxBlur(source.get(), actual.get(), dx, dxLeft, dxRight, 4, 4 * width, width, height, false);
+        } else {
+            FEGaussianBlur::boxBlur(source.get(), expected.get(), dx, dxLeft, dxRight, 4 * width, 4, height, width, false, false);
+            FEGaussianBlur::boxBlur(source.get(), actual.get(), dx, dxLeft, dxRight, 4 * width, 4, height, width, false);
+        }
+        EXPECT_TRUE(sameBytes(expected->data(), actual->data(), length));
+    }
+}
+
+TEST(WebCoreFilterKernels, ColorMatrixSIMDMatchesScalar)
+{
+    RandomGenerator random;
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        unsigned pixelCount = 1 + random.next(2000);
+        Vector<unsigned char> expected(pixelCount * 4);
+        random.fill(expected.data(), expected.size());
+        Vector<unsigned char> actual = expected;
+
+        Vector<float> values(20);
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = random.nextFloat(-2, 2);
+
+        FEColorMatrix::transformPixels(FECOLORMATRIX_TYPE_MATRIX, values, 0, expected.data(), pixelCount, false);
+        FEColorMatrix::transformPixels(FECOLORMATRIX_TYPE_MATRIX, values, 0, actual.data(), pixelCount);
+        EXPECT_TRUE(sameBytes(expected.data(), actual.data(), expected.size()));
+    }
+}
+
+TEST(WebCoreFilterKernels, SaturateAndHueRotateSIMDMatchesScalar)
+{
+    static const ColorMatrixType types[] = { FECOLORMATRIX_TYPE_SATURATE, FECOLORMATRIX_TYPE_HUEROTATE };
+
+    RandomGenerator random;
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        unsigned pixelCount = 1 + random.next(2000);
+        Vector<unsigned char> expected(pixelCount * 4);
+        random.fill(expected.data(), expected.size());
+        Vector<unsigned char> actual = expected;
+
+        ColorMatrixType type = types[iteration % 2];
+        Vector<float> values(1, random.nextFloat(type == FECOLORMATRIX_TYPE_SATURATE ? 0 : -360, type == FECOLORMATRIX_TYPE_SATURATE ? 4 : 360));
+        float components[9];
+        if (type == FECOLORMATRIX_TYPE_SATURATE)
+            FEColorMatrix::calculateSaturateComponents(components, values[0]);
+        else
+            FEColorMatrix::calculateHueRotateComponents(components, values[0]);
+
+        FEColorMatrix::transformPixels(type, values, components, expected.data(), pixelCount, false);
+        FEColorMatrix::transformPixels(type, values, components, actual.data(), pixelCount);
+        EXPECT_TRUE(sameBytes(expected.data(), actual.data(), expected.size()));
+    }
+}
+
+TEST(WebCoreFilterKernels, ArithmeticSIMDMatchesScalar)
+{
+    RandomGenerator random;
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        // Whole pixels, but not always a whole number of vectors.
+        unsigned length = 4 * (1 + random.next(2000));
+        Vector<unsigned char> source(length);
+        Vector<unsigned char> expected(length);
+        random.fill(source.data(), length);
+        random.fill(expected.data(), length);
+        Vector<unsigned char> actual = expected;
+
+        // Alternate between coefficients that need clamping and ones that stay in range, with some of them zero.
+        float k[4];
+        for (int i = 0; i < 4; ++i) {
+            if (iteration % 2)
+                k[i] = random.nextFloat(0, i == 3 ? 0.1 : 0.3);
+            else
+                k[i] = random.next(3) ? random.nextFloat(-1, 1.5) : 0;
+        }
+
+        FEComposite::platformArithmeticSoftware(source.data(), expected.data(), length, k[0], k[1], k[2], k[3], false);
+        FEComposite::platformArithmeticSoftware(source.data(), actual.data(), length, k[0], k[1], k[2], k[3]);
+        EXPECT_TRUE(sameBytes(expected.data(), actual.data(), length));
+    }
+}
+
+#endif // defined(__SSE2__)
+
+template<typename Function>
+static double millisecondsFor(Function function)
+{
+    double start = monotonicallyIncreasingTime();
+    function();
+    return (monotonicallyIncreasingTime() - start) * 1000;
+}
+
+struct BoxBlurPass {
+    BoxBlurPass(Uint8ClampedArray* source, Uint8ClampedArray* destination, int width, int height, bool allowSIMD)
+        : source(source), destination(destination), width(width), height(height), allowSIMD(allowSIMD) { }
+    void operator()() const { FEGaussianBlur::boxBlur(source, destination, 15, 7, 8, 4, 4 * width, width, height, false, allowSIMD); }
+
+    Uint8ClampedArray* source;
+    Uint8ClampedArray* destination;
+    int width;
+    int height;
+    bool allowSIMD;
+};
+
+struct ColorMatrixPass {
+    ColorMatrixPass(const Vector<float>& values, unsigned char* pixels, unsigned pixelCount, bool allowSIMD)
+        : values(values), pixels(pixels), pixelCount(pixelCount), allowSIMD(allowSIMD) { }
+    void operator()() const { FEColorMatrix::transformPixels(FECOLORMATRIX_TYPE_MATRIX, values, 0, pixels, pixelCount, allowSIMD); }
+
+    const Vector<float>& values;
+    unsigned char* pixels;
+    unsigned pixelCount;
+    bool allowSIMD;
+};
+
+struct ArithmeticPass {
+    ArithmeticPass(unsigned char* source, unsigned char* destination, unsigned length, bool allowSIMD)
+        : source(source), destination(destination), length(length), allowSIMD(allowSIMD) { }
+    void operator()() const { FEComposite::platformArithmeticSoftware(source, destination, length, 0.2f, 0.3f, 0.4f, 0.1f, allowSIMD); }
+
+    unsigned char* source;
+    unsigned char* destination;
+    unsigned length;
+    bool allowSIMD;
+};
+
+// Not a test: prints how long the scalar and the vector kernels take on a 1024x1024 image.
+// Run it with --gtest_also_run_disabled_tests --gtest_filter=WebCoreFilterKernels.DISABLED_Benchmark.
+TEST(WebCoreFilterKernels, DISABLED_Benchmark)
+{
+    static const int size = 1024;
+    static const unsigned length = size * size * 4;
+
+    RandomGenerator random;
+    RefPtr<Uint8ClampedArray> source = Uint8ClampedArray::createUninitialized(length);
+    RefPtr<Uint8ClampedArray> destination = Uint8ClampedArray::createUninitialized(length);
+    random.fill(source->data(), length);
+    random.fill(destination->data(), length);
+
+    Vector<float> values(20);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = random.nextFloat(-1, 1);
+
+    printf("box blur:   scalar %.1fms, vector %.1fms\n",
+        millisecondsFor(BoxBlurPass(source.get(), destination.get(), size, size, false)),
+        millisecondsFor(BoxBlurPass(source.get(), destination.get(), size, size, true)));
+    printf("matrix:     scalar %.1fms, vector %.1fms\n",
+        millisecondsFor(ColorMatrixPass(values, destination->data(), size * size, false)),
+        millisecondsFor(ColorMatrixPass(values, destination->data(), size * size, true)));
+    printf("arithmetic: scalar %.1fms, vector %.1fms\n",
+        millisecondsFor(ArithmeticPass(source->data(), destination->data(), length, false)),
+        millisecondsFor(ArithmeticPass(source->data(), destination->data(), length, true)));
+}
+
+} // namespace TestWebKitAPI
+
+#endif // ENABLE(FILTERS)
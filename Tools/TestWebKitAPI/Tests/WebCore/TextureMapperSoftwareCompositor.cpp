@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if USE(TEXTURE_MAPPER)
+
+#include <WebCore/TextureMapperSoftwareCompositor.h>
+#include <wtf/Vector.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+// A fixed linear congruential generator, so that failures are reproducible.
+class PixelGenerator {
+public:
+    PixelGenerator()
+        : m_state(0x12345678)
+    {
+    }
+
+    uint32_t next()
+    {
+        m_state = m_state * 1664525 + 1013904223;
+        return m_state;
+    }
+
+    // Mostly valid premultiplied pixels, with the transparent, opaque and out of range values the
+    // kernels special case mixed in.
+    uint32_t nextPixel()
+    {
+        uint32_t value = next();
+        switch (value & 7) {
+        case 0:
+            return 0;
+        case 1:
+            return value | 0xff000000;
+        case 2:
+            return value & 0x00ffffff;
+        case 3:
+            return value;
+        default: {
+            unsigned alpha = value >> 24;
+            unsigned red = (next() >> 8) % (alpha + 1);
+            unsigned green = (next() >> 8) % (alpha + 1);
+            unsigned blue = (next() >> 8) % (alpha + 1);
+            return alpha << 24 | red << 16 | green << 8 | blue;
+        }
+        }
+    }
+
+private:
+    uint32_t m_state;
+};
+
+static void expectSIMDMatchesScalar(TextureMapperSoftwareCompositor::CompositeMode mode)
+{
+    static const unsigned opacities[] = { 255, 254, 200, 128, 1, 0 };
+    PixelGenerator generator;
+
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(opacities); ++i) {
+        // Odd lengths and offsets leave both unaligned rows and tails for the scalar loop.
+        for (int count = 1; count <= 67; count += 3) {
+            for (int offset = 0; offset < 3; ++offset) {
+                Vector<uint32_t> source(offset + count);
+                Vector<uint32_t> destination(offset + count);
+                for (int j = 0; j < offset + count; ++j) {
+                    source[j] = generator.nextPixel();
+                    destination[j] = generator.nextPixel();
+                }
+                Vector<uint32_t> expected = destination;
+
+                TextureMapperSoftwareCompositor::compositeRow(expected.data() + offset, source.data() + offset, count, opacities[i], mode, false);
+                TextureMapperSoftwareCompositor::compositeRow(destination.data() + offset, source.data() + offset, count, opacities[i], mode);
+
+                for (int j = 0; j < offset + count; ++j)
+                    EXPECT_EQ(expected[j], destination[j]);
+            }
+        }
+    }
+}
+
+TEST(WebCoreTextureMapperSoftwareCompositor, SourceOverScalar)
+{
+    uint32_t destination[] = { 0xff0000ff, 0xff0000ff, 0xff0000ff, 0x00000000 };
+    const uint32_t source[] = { 0x80800000, 0xff00ff00, 0x00000000, 0x80800000 };
+    TextureMapperSoftwareCompositor::compositeRow(destination, source, 4, 255, TextureMapperSoftwareCompositor::SourceOver, false);
+    EXPECT_EQ(0xff80007fu, destination[0]);
+    EXPECT_EQ(0xff00ff00u, destination[1]);
+    EXPECT_EQ(0xff0000ffu, destination[2]);
+    EXPECT_EQ(0x80800000u, destination[3]);
+}
+
+TEST(WebCoreTextureMapperSoftwareCompositor, DestinationInScalar)
+{
+    uint32_t destination[] = { 0xff0000ff, 0xff0000ff, 0xff0000ff };
+    const uint32_t source[] = { 0x80000000, 0xff000000, 0x00ffffff };
+    TextureMapperSoftwareCompositor::compositeRow(destination, source, 3, 255, TextureMapperSoftwareCompositor::DestinationIn, false);
+    EXPECT_EQ(0x80000080u, destination[0]);
+    EXPECT_EQ(0xff0000ffu, destination[1]);
+    EXPECT_EQ(0x00000000u, destination[2]);
+}
+
+// Where neither SSE2 nor NEON is available both calls take the scalar path and these pass trivially.
+TEST(WebCoreTextureMapperSoftwareCompositor, SourceOverSIMDMatchesScalar)
+{
+    expectSIMDMatchesScalar(TextureMapperSoftwareCompositor::SourceOver);
+}
+
+TEST(WebCoreTextureMapperSoftwareCompositor, DestinationInSIMDMatchesScalar)
+{
+    expectSIMDMatchesScalar(TextureMapperSoftwareCompositor::DestinationIn);
+}
+
+} // namespace TestWebKitAPI
+
+#endif // USE(TEXTURE_MAPPER)